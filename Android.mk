@@ -96,6 +96,7 @@ LOCAL_SRC_FILES:= \
 		glslang/MachineIndependent/iomapper.cpp \
 		glslang/MachineIndependent/limits.cpp \
 		glslang/MachineIndependent/linkValidate.cpp \
+		glslang/MachineIndependent/MappedFileIncluder.cpp \
 		glslang/MachineIndependent/parseConst.cpp \
 		glslang/MachineIndependent/ParseContextBase.cpp \
 		glslang/MachineIndependent/ParseHelper.cpp \
@@ -107,6 +108,7 @@ LOCAL_SRC_FILES:= \
 		glslang/MachineIndependent/ShaderLang.cpp \
 		glslang/MachineIndependent/SpirvIntrinsics.cpp \
 		glslang/MachineIndependent/SymbolTable.cpp \
+		glslang/MachineIndependent/SymbolTableSnapshot.cpp \
 		glslang/MachineIndependent/Versions.cpp \
 		glslang/MachineIndependent/preprocessor/PpAtom.cpp \
 		glslang/MachineIndependent/preprocessor/PpContext.cpp \
@@ -115,12 +117,14 @@ LOCAL_SRC_FILES:= \
 		glslang/MachineIndependent/preprocessor/PpTokens.cpp \
 		glslang/OSDependent/Unix/ossource.cpp \
 		SPIRV/CInterface/spirv_c_interface.cpp \
+		SPIRV/CompileCache.cpp \
 		SPIRV/GlslangToSpv.cpp \
 		SPIRV/InReadableOrder.cpp \
 		SPIRV/Logger.cpp \
 		SPIRV/SPVRemapper.cpp \
 		SPIRV/SpvBuilder.cpp \
 		SPIRV/SpvPostProcess.cpp \
+		SPIRV/SpvSink.cpp \
 		SPIRV/SpvTools.cpp \
 		SPIRV/disassemble.cpp \
 		SPIRV/doc.cpp
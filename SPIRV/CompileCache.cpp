@@ -0,0 +1,360 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "CompileCache.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "Logger.h"
+#include "spirv.hpp11"
+
+namespace glslang {
+
+namespace {
+
+// Bumped whenever the key or the stored layout changes.
+const unsigned int CompileCacheFormatVersion = 1;
+
+// 128-bit FNV-1a: the key names the result, so collisions must be out of the question.
+class TCompileCacheHasher {
+public:
+    TCompileCacheHasher() : high(0x6c62272e07bb0142ULL), low(0x62b821756295c58dULL) { }
+
+    void bytes(const void* data, size_t size)
+    {
+        const unsigned char* byte = static_cast<const unsigned char*>(data);
+        for (size_t b = 0; b < size; ++b) {
+            low ^= byte[b];
+            multiply();
+        }
+    }
+    void integer(unsigned long long value)
+    {
+        unsigned char encoded[8];
+        for (int b = 0; b < 8; ++b)
+            encoded[b] = static_cast<unsigned char>(value >> (8 * b));
+        bytes(encoded, sizeof(encoded));
+    }
+    // Length-prefixed, so adjacent strings cannot run into each other.
+    void string(const char* text, size_t length)
+    {
+        integer(length);
+        bytes(text, length);
+    }
+    void string(const std::string& text) { string(text.data(), text.size()); }
+
+    std::string hex() const
+    {
+        char text[33];
+        snprintf(text, sizeof(text), "%016llx%016llx", high, low);
+        return text;
+    }
+
+private:
+    // Multiply by the FNV prime 2^88 + 0x13b, modulo 2^128.
+    void multiply()
+    {
+        const unsigned long long factor = 0x13b;
+        unsigned long long lowProduct = (low & 0xffffffffULL) * factor;
+        unsigned long long midProduct = (low >> 32) * factor + (lowProduct >> 32);
+        unsigned long long newHigh = high * factor + (midProduct >> 32) + (low << 24);
+        low = (lowProduct & 0xffffffffULL) | (midProduct << 32);
+        high = newHigh;
+    }
+
+    unsigned long long high;
+    unsigned long long low;
+};
+
+std::string ComputeKey(const TCompileCacheInput& input, const SpvOptions& options, const std::string& preprocessed)
+{
+    TCompileCacheHasher hasher;
+
+    hasher.integer(CompileCacheFormatVersion);
+    const Version version = GetVersion();
+    hasher.integer(static_cast<unsigned long long>(version.major));
+    hasher.integer(static_cast<unsigned long long>(version.minor));
+    hasher.integer(static_cast<unsigned long long>(version.patch));
+    hasher.string(version.flavor != nullptr ? version.flavor : "");
+    hasher.integer(static_cast<unsigned long long>(GetSpirvGeneratorVersion()));
+
+    hasher.string(preprocessed);
+    hasher.string(input.entryPoint);
+    hasher.string(input.sourceEntryPoint);
+
+    // TBuiltInResource is all ints followed by TLimits' bools: hash the members, not any padding.
+    const TBuiltInResource& resources = *input.resources;
+    hasher.bytes(&resources, offsetof(TBuiltInResource, limits));
+    hasher.bytes(&resources.limits, sizeof(resources.limits));
+
+    const TEnvironment& environment = input.environment;
+    hasher.integer(environment.input.languageFamily);
+    hasher.integer(environment.input.stage);
+    hasher.integer(environment.input.dialect);
+    hasher.integer(static_cast<unsigned long long>(environment.input.dialectVersion));
+    hasher.integer(environment.input.vulkanRulesRelaxed);
+    hasher.integer(environment.client.client);
+    hasher.integer(environment.client.version);
+    hasher.integer(environment.target.language);
+    hasher.integer(environment.target.version);
+    hasher.integer(environment.target.hlslFunctionality1);
+
+    hasher.integer(static_cast<unsigned long long>(input.defaultVersion));
+    hasher.integer(input.defaultProfile);
+    hasher.integer(input.forceDefaultVersionAndProfile);
+    hasher.integer(input.forwardCompatible);
+    hasher.integer(input.messages);
+
+    hasher.integer(options.generateDebugInfo);
+    hasher.integer(options.stripDebugInfo);
+    hasher.integer(options.disableOptimizer);
+    hasher.integer(options.optimizeSize);
+    hasher.integer(options.disassemble);
+    hasher.integer(options.validate);
+    hasher.integer(options.emitNonSemanticShaderDebugInfo);
+    hasher.integer(options.emitNonSemanticShaderDebugSource);
+    hasher.integer(options.compileOnly);
+    hasher.integer(options.optimizerAllowExpandedIDBound);
+
+    return hasher.hex();
+}
+
+void ApplyEnvironment(TShader& shader, const TEnvironment& environment)
+{
+    shader.setEnvInput(environment.input.languageFamily, environment.input.stage, environment.input.dialect,
+                       environment.input.dialectVersion);
+    if (environment.input.vulkanRulesRelaxed)
+        shader.setEnvInputVulkanRulesRelaxed();
+    shader.setEnvClient(environment.client.client, environment.client.version);
+    shader.setEnvTarget(environment.target.language, environment.target.version);
+    if (environment.target.hlslFunctionality1)
+        shader.setEnvTargetHlslFunctionality1();
+}
+
+} // end anonymous namespace
+
+//
+// TMemoryCompileCacheStore
+//
+
+bool TMemoryCompileCacheStore::load(const std::string& key, std::vector<unsigned int>& spirv)
+{
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto found = index.find(key);
+    if (found == index.end())
+        return false;
+
+    entries.splice(entries.begin(), entries, found->second);
+    spirv = found->second->second;
+
+    return true;
+}
+
+void TMemoryCompileCacheStore::store(const std::string& key, const std::vector<unsigned int>& spirv)
+{
+    const size_t entrySize = spirv.size() * sizeof(unsigned int);
+    if (entrySize > capacity)
+        return;
+
+    const std::lock_guard<std::mutex> guard(lock);
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        size -= found->second->second.size() * sizeof(unsigned int);
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    while (size + entrySize > capacity && ! entries.empty()) {
+        size -= entries.back().second.size() * sizeof(unsigned int);
+        index.erase(entries.back().first);
+        entries.pop_back();
+        ++evictions;
+    }
+
+    entries.emplace_front(key, spirv);
+    index[key] = entries.begin();
+    size += entrySize;
+}
+
+unsigned long long TMemoryCompileCacheStore::getEvictionCount() const
+{
+    const std::lock_guard<std::mutex> guard(lock);
+    return evictions;
+}
+
+//
+// TDirectoryCompileCacheStore
+//
+
+std::string TDirectoryCompileCacheStore::path(const std::string& key) const
+{
+    return directory + "/" + key + ".spv";
+}
+
+bool TDirectoryCompileCacheStore::load(const std::string& key, std::vector<unsigned int>& spirv)
+{
+    FILE* file = fopen(path(key).c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    bool loaded = false;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0 && size % sizeof(unsigned int) == 0 && fseek(file, 0, SEEK_SET) == 0) {
+            spirv.resize(static_cast<size_t>(size) / sizeof(unsigned int));
+            loaded = fread(spirv.data(), sizeof(unsigned int), spirv.size(), file) == spirv.size();
+        }
+    }
+    fclose(file);
+
+    // A torn or foreign file is a miss, not an error.
+    if (! loaded || spirv[0] != spv::MagicNumber) {
+        spirv.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void TDirectoryCompileCacheStore::store(const std::string& key, const std::vector<unsigned int>& spirv)
+{
+    // Write under a unique name and rename into place, so readers never see a partial file.
+    const std::string target = path(key);
+    const std::string temporary = target + "." +
+                                  std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+                                  std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                                  ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr)
+        return;
+    bool written = fwrite(spirv.data(), sizeof(unsigned int), spirv.size(), file) == spirv.size();
+    written = fclose(file) == 0 && written;
+
+    if (! written || rename(temporary.c_str(), target.c_str()) != 0)
+        remove(temporary.c_str());
+}
+
+//
+// TCompileCache
+//
+
+bool TCompileCache::compile(const TCompileCacheInput& input, const SpvOptions& options,
+                            std::vector<unsigned int>& spirv, std::string& log)
+{
+    spirv.clear();
+    log.clear();
+
+    const EShLanguage stage = input.environment.input.stage;
+    TShader shader(stage);
+    shader.setStrings(&input.code, 1);
+    shader.setEntryPoint(input.entryPoint.c_str());
+    if (! input.sourceEntryPoint.empty())
+        shader.setSourceEntryPoint(input.sourceEntryPoint.c_str());
+    ApplyEnvironment(shader, input.environment);
+
+    TShader::ForbidIncluder forbidIncluder;
+    TShader::Includer& includer = input.includer != nullptr ? *input.includer : forbidIncluder;
+
+    std::string preprocessed;
+    if (! shader.preprocess(input.resources, input.defaultVersion, input.defaultProfile,
+                            input.forceDefaultVersionAndProfile, input.forwardCompatible, input.messages,
+                            &preprocessed, includer)) {
+        log = shader.getInfoLog();
+        return false;
+    }
+
+    const std::string key = ComputeKey(input, options, preprocessed);
+    if (store.load(key, spirv)) {
+        ++hits;
+        return true;
+    }
+    ++misses;
+
+    // Same as the C interface: parse what was just preprocessed.
+    const char* preprocessedText = preprocessed.c_str();
+    shader.setStrings(&preprocessedText, 1);
+    if (! shader.parse(input.resources, input.defaultVersion, input.defaultProfile,
+                       input.forceDefaultVersionAndProfile, input.forwardCompatible, input.messages, includer)) {
+        log = shader.getInfoLog();
+        return false;
+    }
+
+    TProgram program;
+    program.addShader(&shader);
+    if (! program.link(input.messages)) {
+        log = std::string(shader.getInfoLog()) + program.getInfoLog();
+        return false;
+    }
+
+    spv::SpvBuildLogger logger;
+    SpvOptions spvOptions = options;
+    GlslangToSpv(*program.getIntermediate(stage), spirv, &logger, &spvOptions);
+    log = logger.getAllMessages();
+    if (spirv.empty())
+        return false;
+
+    store.store(key, spirv);
+    ++stores;
+
+    return true;
+}
+
+TCompileCacheStats TCompileCache::getStats() const
+{
+    TCompileCacheStats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.stores = stores;
+    stats.evictions = store.getEvictionCount() - evictionBase;
+
+    return stats;
+}
+
+void TCompileCache::resetStats()
+{
+    hits = 0;
+    misses = 0;
+    stores = 0;
+    evictionBase = store.getEvictionCount();
+}
+
+} // end namespace glslang
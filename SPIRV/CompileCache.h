@@ -0,0 +1,174 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef GLSLANG_SPIRV_COMPILE_CACHE_H
+#define GLSLANG_SPIRV_COMPILE_CACHE_H
+
+//
+// Content-addressed cache of GLSL/HLSL -> SPIR-V compiles.
+//
+// A compile is identified by a hash of everything that determines its output:
+// the preprocessed source (so #includes and predefined macros are accounted
+// for), TBuiltInResource, TEnvironment, EShMessages, the entry points and
+// SpvOptions, plus the glslang version.  A cache hit returns the stored SPIR-V
+// words without running parse, link or GlslangToSpv; preprocessing still runs
+// to compute the key.
+//
+// Only successful compiles are stored, and only their SPIR-V: diagnostics from
+// the original compile are not replayed on a hit.
+//
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glslang/Include/visibility.h"
+#include "glslang/Public/ShaderLang.h"
+#include "GlslangToSpv.h"
+
+namespace glslang {
+
+struct TCompileCacheStats {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long stores;    // results added to the store
+    unsigned long long evictions; // results the store dropped to make room
+};
+
+// Where cached results live.  Implementations must be safe to call from
+// several threads at once.
+class GLSLANG_EXPORT TCompileCacheStore {
+public:
+    virtual ~TCompileCacheStore() {}
+
+    // Look up 'key', filling 'spirv' and returning true if present.
+    virtual bool load(const std::string& key, std::vector<unsigned int>& spirv) = 0;
+    virtual void store(const std::string& key, const std::vector<unsigned int>& spirv) = 0;
+
+    virtual unsigned long long getEvictionCount() const { return 0; }
+};
+
+// In-memory store, dropping the least recently used results once their total
+// size exceeds 'capacityBytes'.
+class GLSLANG_EXPORT TMemoryCompileCacheStore : public TCompileCacheStore {
+public:
+    explicit TMemoryCompileCacheStore(size_t capacityBytes) : capacity(capacityBytes), size(0), evictions(0) { }
+
+    bool load(const std::string& key, std::vector<unsigned int>& spirv) override;
+    void store(const std::string& key, const std::vector<unsigned int>& spirv) override;
+    unsigned long long getEvictionCount() const override;
+
+private:
+    typedef std::list<std::pair<std::string, std::vector<unsigned int>>> TEntryList;
+
+    mutable std::mutex lock;
+    size_t capacity;
+    size_t size;
+    unsigned long long evictions;
+    TEntryList entries; // most recently used first
+    std::unordered_map<std::string, TEntryList::iterator> index;
+};
+
+// On-disk store, one <key>.spv file per result in an existing directory.  The
+// directory can be shared by concurrent processes; nothing is ever evicted.
+class GLSLANG_EXPORT TDirectoryCompileCacheStore : public TCompileCacheStore {
+public:
+    explicit TDirectoryCompileCacheStore(const std::string& directory) : directory(directory) { }
+
+    bool load(const std::string& key, std::vector<unsigned int>& spirv) override;
+    void store(const std::string& key, const std::vector<unsigned int>& spirv) override;
+
+private:
+    std::string path(const std::string& key) const;
+
+    std::string directory;
+};
+
+// One shader stage to compile, with everything TShader::parse needs.
+struct TCompileCacheInput {
+    TCompileCacheInput()
+        : code(nullptr), entryPoint("main"), resources(nullptr), defaultVersion(100), defaultProfile(ENoProfile),
+          forceDefaultVersionAndProfile(false), forwardCompatible(false), messages(EShMsgDefault),
+          includer(nullptr)
+    {
+        environment.input = { EShSourceGlsl, EShLangVertex, EShClientNone, 0, false };
+        environment.client = { EShClientNone, EShTargetClientVersion(0) };
+        environment.target = { EShTargetNone, EShTargetLanguageVersion(0), false };
+    }
+
+    const char* code;
+    std::string entryPoint;
+    std::string sourceEntryPoint;   // HLSL: source-level entry point to rename to entryPoint, if not empty
+    TEnvironment environment;       // input.stage selects the stage to compile
+    const TBuiltInResource* resources;
+    int defaultVersion;
+    EProfile defaultProfile;
+    bool forceDefaultVersionAndProfile;
+    bool forwardCompatible;
+    EShMessages messages;
+    TShader::Includer* includer;    // nullptr forbids #include
+};
+
+// Thread-safe front end compiling through a TCompileCacheStore.
+class GLSLANG_EXPORT TCompileCache {
+public:
+    explicit TCompileCache(TCompileCacheStore& store) : store(store) { resetStats(); }
+
+    // Compile 'input' to SPIR-V, or fetch the result of an identical earlier
+    // compile.  On failure returns false with the info logs in 'log'; on a
+    // miss, 'log' receives GlslangToSpv's messages.
+    bool compile(const TCompileCacheInput& input, const SpvOptions& options, std::vector<unsigned int>& spirv,
+                 std::string& log);
+
+    TCompileCacheStats getStats() const;
+    void resetStats();
+
+private:
+    TCompileCache(const TCompileCache&);
+    TCompileCache& operator=(const TCompileCache&);
+
+    TCompileCacheStore& store;
+    std::atomic<unsigned long long> hits;
+    std::atomic<unsigned long long> misses;
+    std::atomic<unsigned long long> stores;
+    std::atomic<unsigned long long> evictionBase; // store evictions at the last resetStats()
+};
+
+} // end namespace glslang
+
+#endif // GLSLANG_SPIRV_COMPILE_CACHE_H
@@ -72,6 +72,7 @@ namespace spv {
 #include <optional>
 #include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -114,6 +115,25 @@ struct OpDecorations {
         spv::Decoration nonUniform;
 };
 
+// Counts the nodes of a subtree, to split function bodies into shares of
+// similar size for lowering in parallel.
+class TNodeCounter : public glslang::TIntermTraverser {
+public:
+    TNodeCounter() : glslang::TIntermTraverser(true, false, false), count(0) { }
+
+    void visitSymbol(glslang::TIntermSymbol*) { ++count; }
+    void visitConstantUnion(glslang::TIntermConstantUnion*) { ++count; }
+    bool visitBinary(glslang::TVisit, glslang::TIntermBinary*) { ++count; return true; }
+    bool visitUnary(glslang::TVisit, glslang::TIntermUnary*) { ++count; return true; }
+    bool visitSelection(glslang::TVisit, glslang::TIntermSelection*) { ++count; return true; }
+    bool visitAggregate(glslang::TVisit, glslang::TIntermAggregate*) { ++count; return true; }
+    bool visitLoop(glslang::TVisit, glslang::TIntermLoop*) { ++count; return true; }
+    bool visitBranch(glslang::TVisit, glslang::TIntermBranch*) { ++count; return true; }
+    bool visitSwitch(glslang::TVisit, glslang::TIntermSwitch*) { ++count; return true; }
+
+    long long count;
+};
+
 } // namespace
 
 //
@@ -138,7 +158,15 @@ public:
     bool visitBranch(glslang::TVisit visit, glslang::TIntermBranch*);
 
     void finishSpv(bool compileOnly);
-    void dumpSpv(std::vector<unsigned int>& out);
+    void dumpSpv(spv::SpvSink& out);
+
+    // Only lower the bodies of top-level sequence entries [first, end), as one
+    // of the shares of visitFunctionsInParallel().
+    void setFunctionShare(int first, int end)
+    {
+        shareFirst = first;
+        shareEnd = end;
+    }
 
 protected:
     TGlslangToSpvTraverser(TGlslangToSpvTraverser&);
@@ -193,7 +221,11 @@ protected:
     void makeFunctions(const glslang::TIntermSequence&);
     void makeGlobalInitializers(const glslang::TIntermSequence&);
     void collectRayTracingLinkerObjects();
-    void visitFunctions(const glslang::TIntermSequence&);
+    void visitFunctions(const glslang::TIntermSequence&, int first, int end);
+    bool canLowerFunctionsInParallel() const;
+    void visitFunctionsInParallel(glslang::TIntermAggregate* root);
+    void mergeFunctionShare(TGlslangToSpvTraverser& share, const spv::Builder::ModuleMark& mark,
+                            const glslang::TIntermSequence&, int first, int end);
     void handleFunctionEntry(const glslang::TIntermAggregate* node);
     void translateArguments(const glslang::TIntermAggregate& node, std::vector<spv::Id>& arguments,
         spv::Builder::AccessChain::CoherentFlags &lvalueCoherentFlags);
@@ -288,6 +320,12 @@ protected:
     // Used later for generating OpTraceKHR/OpExecuteCallableKHR/OpHitObjectRecordHit*/OpHitObjectGetShaderBindingTableData
     std::unordered_map<unsigned int, glslang::TIntermSymbol *> locationToSymbol[4];
     std::unordered_map<spv::Id, std::vector<spv::Decoration> > idToQCOMDecorations;
+    // When lowering one share of the function bodies, the range of top-level
+    // sequence entries to lower (shareEnd is negative otherwise), and where the
+    // module stood after the prelude.
+    int shareFirst;
+    int shareEnd;
+    spv::Builder::ModuleMark shareMark;
 };
 
 //
@@ -1593,7 +1631,8 @@ TGlslangToSpvTraverser::TGlslangToSpvTraverser(unsigned int spvVersion,
         glslangIntermediate(glslangIntermediate),
         nanMinMaxClamp(glslangIntermediate->getNanMinMaxClamp()),
         nonSemanticDebugPrintf(0),
-        taskPayloadID(0)
+        taskPayloadID(0),
+        shareFirst(0), shareEnd(-1), shareMark()
 {
     bool isMeshShaderExt = (glslangIntermediate->getRequestedExtensions().find(glslang::E_GL_EXT_mesh_shader) !=
                             glslangIntermediate->getRequestedExtensions().end());
@@ -2096,7 +2135,7 @@ void TGlslangToSpvTraverser::finishSpv(bool compileOnly)
 }
 
 // Write the SPV into 'out'.
-void TGlslangToSpvTraverser::dumpSpv(std::vector<unsigned int>& out)
+void TGlslangToSpvTraverser::dumpSpv(spv::SpvSink& out)
 {
     builder.dump(out);
 }
@@ -3043,7 +3082,16 @@ bool TGlslangToSpvTraverser::visitAggregate(glslang::TVisit visit, glslang::TInt
 
                 // Initializers are done, don't want to visit again, but functions and link objects need to be processed,
                 // so do them manually.
-                visitFunctions(node->getAsAggregate()->getSequence());
+                const glslang::TIntermSequence& glslFunctions = node->getAsAggregate()->getSequence();
+                if (shareEnd >= 0) {
+                    // Lowering a share for visitFunctionsInParallel(), which already has the prelude's messages.
+                    shareMark = builder.markModule();
+                    logger->clear();
+                    visitFunctions(glslFunctions, shareFirst, shareEnd);
+                } else if (canLowerFunctionsInParallel())
+                    visitFunctionsInParallel(node);
+                else
+                    visitFunctions(glslFunctions, 0, (int)glslFunctions.size());
 
                 return false;
             } else {
@@ -6265,16 +6313,161 @@ void TGlslangToSpvTraverser::collectRayTracingLinkerObjects()
         }
     }
 }
-// Process all the functions, while skipping initializers.
-void TGlslangToSpvTraverser::visitFunctions(const glslang::TIntermSequence& glslFunctions)
+// Process the functions of entries [first, end), while skipping initializers.
+void TGlslangToSpvTraverser::visitFunctions(const glslang::TIntermSequence& glslFunctions, int first, int end)
 {
-    for (int f = 0; f < (int)glslFunctions.size(); ++f) {
+    for (int f = first; f < end; ++f) {
         glslang::TIntermAggregate* node = glslFunctions[f]->getAsAggregate();
         if (node && (node->getOp() == glslang::EOpFunction || node->getOp() == glslang::EOpLinkerObjects))
             node->traverse(this);
     }
 }
 
+bool TGlslangToSpvTraverser::canLowerFunctionsInParallel() const
+{
+    // Debug info is tied to scopes that shares cannot merge, and forward pointers
+    // reuse their <id> for the pointer type they forward.
+    return options.functionThreads > 1 && ! options.generateDebugInfo && ! options.compileOnly &&
+           ! glslangIntermediate->usingPhysicalStorageBuffer();
+}
+
+// Process all the functions, in shares of similar size: the first one here and
+// each of the others on its own thread, by a traverser that replays the prelude
+// this one did.  Those are then merged in order, giving the same module as
+// visitFunctions() would.  If a share made something merging does not support,
+// the remaining functions are processed here instead.
+void TGlslangToSpvTraverser::visitFunctionsInParallel(glslang::TIntermAggregate* root)
+{
+    const glslang::TIntermSequence& glslFunctions = root->getSequence();
+    const int entries = (int)glslFunctions.size();
+
+    std::vector<long long> weights(entries, 0);
+    long long total = 0;
+    int functions = 0;
+    for (int f = 0; f < entries; ++f) {
+        glslang::TIntermAggregate* node = glslFunctions[f]->getAsAggregate();
+        if (node && (node->getOp() == glslang::EOpFunction || node->getOp() == glslang::EOpLinkerObjects)) {
+            TNodeCounter counter;
+            node->traverse(&counter);
+            weights[f] = counter.count;
+            total += counter.count;
+            ++functions;
+        }
+    }
+
+    // Share s lowers entries [bounds[s], bounds[s + 1]).
+    const int shareCount = std::min(options.functionThreads, functions);
+    std::vector<int> bounds(1, 0);
+    long long weight = 0;
+    for (int f = 0; f + 1 < entries && (int)bounds.size() < shareCount; ++f) {
+        weight += weights[f];
+        if (weight * shareCount >= total * (long long)bounds.size())
+            bounds.push_back(f + 1);
+    }
+    bounds.push_back(entries);
+    const int shares = (int)bounds.size() - 1;
+    if (shares < 2) {
+        visitFunctions(glslFunctions, 0, entries);
+        return;
+    }
+
+    const spv::Builder::ModuleMark mark = builder.markModule();
+    std::vector<glslang::SpvOptions> shareOptions(shares, options);
+    std::vector<spv::SpvBuildLogger> shareLoggers(shares);
+    std::vector<std::unique_ptr<glslang::TPoolAllocator>> pools;
+    std::vector<std::unique_ptr<TGlslangToSpvTraverser>> traversers(shares);
+    std::vector<std::thread> threads;
+    for (int s = 1; s < shares; ++s) {
+        pools.emplace_back(new glslang::TPoolAllocator);
+        glslang::TPoolAllocator* pool = pools.back().get();
+        threads.emplace_back([&, s, pool]() {
+            // The traverser's own containers come from the pool, so make it on this thread.
+            glslang::SetThreadPoolAllocator(pool);
+            traversers[s].reset(new TGlslangToSpvTraverser(glslangIntermediate->getSpv().spv, glslangIntermediate,
+                                                           &shareLoggers[s], shareOptions[s]));
+            traversers[s]->setFunctionShare(bounds[s], bounds[s + 1]);
+            root->traverse(traversers[s].get());
+        });
+    }
+    visitFunctions(glslFunctions, bounds[0], bounds[1]);
+    for (auto& thread : threads)
+        thread.join();
+
+    bool mergeable = true;
+    for (int s = 1; s < shares; ++s) {
+        mergeable = mergeable && traversers[s]->shareMark.bound == mark.bound &&
+                    builder.canMergeFunctionBodies(traversers[s]->builder, mark);
+    }
+    if (! mergeable) {
+        visitFunctions(glslFunctions, bounds[1], entries);
+        return;
+    }
+    for (int s = 1; s < shares; ++s)
+        mergeFunctionShare(*traversers[s], mark, glslFunctions, bounds[s], bounds[s + 1]);
+}
+
+// Merge what 'share' lowered for entries [first, end) into this traverser.
+void TGlslangToSpvTraverser::mergeFunctionShare(TGlslangToSpvTraverser& share, const spv::Builder::ModuleMark& mark,
+                                                const glslang::TIntermSequence& glslFunctions, int first, int end)
+{
+    // Declarations the share made for symbols, built-ins and structs are shared
+    // with the ones made here for the same key.  Structs and built-in variables
+    // new to this traverser stay distinct, as making them here would; a symbol
+    // that is a constant is instead found like any other constant.
+    std::unordered_map<spv::Id, spv::Id> sharedIds;
+    const auto addShared = [&](spv::Id shareId, const auto& map, const auto& key, bool distinct) {
+        if (shareId > mark.bound) {
+            auto it = map.find(key);
+            if (it != map.end())
+                sharedIds[shareId] = it->second;
+            else if (distinct)
+                sharedIds[shareId] = spv::NoResult;
+        }
+    };
+    for (const auto& symbol : share.symbolValues)
+        addShared(symbol.second, symbolValues, symbol.first, false);
+    for (const auto& builtIn : share.builtInVariableIds)
+        addShared(builtIn.second, builtInVariableIds, builtIn.first, true);
+    for (int lp = 0; lp < glslang::ElpCount; ++lp) {
+        for (int lm = 0; lm < glslang::ElmCount; ++lm) {
+            for (const auto& structType : share.structMap[lp][lm])
+                addShared(structType.second, structMap[lp][lm], structType.first, true);
+        }
+    }
+
+    std::vector<spv::Id> functions;
+    for (int f = first; f < end; ++f) {
+        const glslang::TIntermAggregate* node = glslFunctions[f]->getAsAggregate();
+        if (node && node->getOp() == glslang::EOpFunction) {
+            functions.push_back(isShaderEntryPoint(node) ? shaderEntry->getId()
+                                                         : functionMap[node->getName().c_str()]->getId());
+        }
+    }
+
+    const std::vector<spv::Id> idMap = builder.mergeFunctionBodies(share.builder, mark, sharedIds, functions);
+
+    // Later shares share with what this one declared, too.
+    const auto addDeclared = [&](auto& map, const auto& key, spv::Id shareId) {
+        if (shareId > mark.bound)
+            map.insert({ key, idMap[shareId] });
+    };
+    for (const auto& symbol : share.symbolValues)
+        addDeclared(symbolValues, symbol.first, symbol.second);
+    for (const auto& builtIn : share.builtInVariableIds)
+        addDeclared(builtInVariableIds, builtIn.first, builtIn.second);
+    for (int lp = 0; lp < glslang::ElpCount; ++lp) {
+        for (int lm = 0; lm < glslang::ElmCount; ++lm) {
+            for (const auto& structType : share.structMap[lp][lm])
+                addDeclared(structMap[lp][lm], structType.first, structType.second);
+        }
+    }
+
+    for (spv::Id id : share.iOSet)
+        iOSet.insert(idMap[id]);
+    entryPointTerminated = entryPointTerminated || share.entryPointTerminated;
+    logger->append(*share.logger);
+}
+
 void TGlslangToSpvTraverser::handleFunctionEntry(const glslang::TIntermAggregate* node)
 {
     // SPIR-V functions should already be in the functionMap from the prepass
@@ -10950,6 +11143,13 @@ void GlslangToSpv(const TIntermediate& intermediate, std::vector<unsigned int>&
 
 void GlslangToSpv(const TIntermediate& intermediate, std::vector<unsigned int>& spirv,
                   spv::SpvBuildLogger* logger, SpvOptions* options)
+{
+    spv::SpvVectorSink sink(spirv);
+    GlslangToSpv(intermediate, sink, logger, options);
+}
+
+void GlslangToSpv(const TIntermediate& intermediate, spv::SpvSink& out, spv::SpvBuildLogger* logger,
+                  SpvOptions* options)
 {
     TIntermNode* root = intermediate.getTreeRoot();
 
@@ -10965,29 +11165,42 @@ void GlslangToSpv(const TIntermediate& intermediate, std::vector<unsigned int>&
     TGlslangToSpvTraverser it(intermediate.getSpv().spv, &intermediate, logger, *options);
     root->traverse(&it);
     it.finishSpv(options->compileOnly);
-    it.dumpSpv(spirv);
 
 #if ENABLE_OPT
     // If from HLSL, run spirv-opt to "legalize" the SPIR-V for Vulkan
     // eg. forward and remove memory writes of opaque types.
     bool prelegalization = intermediate.getSource() == EShSourceHlsl;
-    if ((prelegalization || options->optimizeSize) && !options->disableOptimizer) {
-        SpirvToolsTransform(intermediate, spirv, logger, options);
-        prelegalization = false;
-    }
-    else if (options->stripDebugInfo) {
-        // Strip debug info even if optimization is disabled.
-        SpirvToolsStripDebugInfo(intermediate, spirv, logger);
-    }
+    const bool optimize = (prelegalization || options->optimizeSize) && !options->disableOptimizer;
+
+    // SPIRV-Tools works on the whole module, so collect it before handing it on.
+    if (optimize || options->stripDebugInfo || options->validate || options->disassemble) {
+        std::vector<unsigned int> spirv;
+        spv::SpvVectorSink collect(spirv);
+        it.dumpSpv(collect);
 
-    if (options->validate)
-        SpirvToolsValidate(intermediate, spirv, logger, prelegalization);
+        if (optimize) {
+            SpirvToolsTransform(intermediate, spirv, logger, options);
+            prelegalization = false;
+        }
+        else if (options->stripDebugInfo) {
+            // Strip debug info even if optimization is disabled.
+            SpirvToolsStripDebugInfo(intermediate, spirv, logger);
+        }
+
+        if (options->validate)
+            SpirvToolsValidate(intermediate, spirv, logger, prelegalization);
 
-    if (options->disassemble)
-        SpirvToolsDisassemble(std::cout, spirv);
+        if (options->disassemble)
+            SpirvToolsDisassemble(std::cout, spirv);
 
+        out.write(spirv.data(), spirv.size());
+        GetThreadPoolAllocator().pop();
+        return;
+    }
 #endif
 
+    it.dumpSpv(out);
+
     GetThreadPoolAllocator().pop();
 }
 
@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "Logger.h"
+#include "SpvSink.h"
 #include "glslang/Include/visibility.h"
 
 namespace glslang {
@@ -55,6 +56,10 @@ struct SpvOptions {
     bool emitNonSemanticShaderDebugSource{ false };
     bool compileOnly{false};
     bool optimizerAllowExpandedIDBound{false};
+    // Lower function bodies on up to this many threads (0 or 1 for serially).
+    // The module is the same either way; shaders needing debug info or
+    // physical storage buffer pointers are always lowered serially.
+    int functionThreads{0};
 };
 
 GLSLANG_EXPORT void GetSpirvVersion(std::string&);
@@ -63,6 +68,11 @@ GLSLANG_EXPORT void GlslangToSpv(const glslang::TIntermediate& intermediate, std
                                  SpvOptions* options = nullptr);
 GLSLANG_EXPORT void GlslangToSpv(const glslang::TIntermediate& intermediate, std::vector<unsigned int>& spirv,
                                  spv::SpvBuildLogger* logger, SpvOptions* options = nullptr);
+// Streams the module into 'sink' as it is serialized.  When 'options' asks for
+// SPIRV-Tools to optimize, strip, validate or disassemble, the module is
+// collected first and the result is then written to 'sink'.
+GLSLANG_EXPORT void GlslangToSpv(const glslang::TIntermediate& intermediate, spv::SpvSink& sink,
+                                 spv::SpvBuildLogger* logger, SpvOptions* options = nullptr);
 GLSLANG_EXPORT bool OutputSpvBin(const std::vector<unsigned int>& spirv, const char* baseName);
 GLSLANG_EXPORT bool OutputSpvHex(const std::vector<unsigned int>& spirv, const char* baseName, const char* varName);
 
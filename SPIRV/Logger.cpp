@@ -52,6 +52,24 @@ void SpvBuildLogger::missingFunctionality(const std::string& f)
         missingFeatures.push_back(f);
 }
 
+void SpvBuildLogger::append(const SpvBuildLogger& other)
+{
+    for (const auto& f : other.tbdFeatures)
+        tbdFunctionality(f);
+    for (const auto& f : other.missingFeatures)
+        missingFunctionality(f);
+    warnings.insert(warnings.end(), other.warnings.begin(), other.warnings.end());
+    errors.insert(errors.end(), other.errors.begin(), other.errors.end());
+}
+
+void SpvBuildLogger::clear()
+{
+    tbdFeatures.clear();
+    missingFeatures.clear();
+    warnings.clear();
+    errors.clear();
+}
+
 std::string SpvBuildLogger::getAllMessages() const {
     std::ostringstream messages;
     for (auto it = tbdFeatures.cbegin(); it != tbdFeatures.cend(); ++it)
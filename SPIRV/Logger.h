@@ -57,6 +57,11 @@ public:
     // Logs an error.
     void error(const std::string& e) { errors.push_back(e); }
 
+    // Adds the messages of 'other', as if they had been logged here.
+    void append(const SpvBuildLogger& other);
+    // Drops all messages.
+    void clear();
+
     // Returns all messages accumulated in the order of:
     // TBD functionalities, missing functionalities, warnings, errors.
     std::string getAllMessages() const;
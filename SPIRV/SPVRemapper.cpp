@@ -1337,24 +1337,34 @@ namespace spv {
         return tid_it->second;
     }
 
-    // Hash types to canonical values.  This can return ID collisions (it's a bit
-    // inevitable): it's up to the caller to handle that gracefully.
-    std::uint32_t spirvbin_t::hashType(unsigned typeStart) const
+    // Hash the type or constant at typeStart from the hashes of the types and
+    // constants it refers to, as found in 'hashes'.  Those not there yet are
+    // added to 'unhashed', and count as 0.
+    std::uint32_t spirvbin_t::hashTypeInst(unsigned typeStart, const typehashes_t& hashes,
+                                           std::vector<spv::Id>& unhashed) const
     {
         const unsigned wordCount   = asWordCount(typeStart);
         const spv::Op  opCode      = asOpCode(typeStart);
 
+        const auto hashOf = [&](spv::Id id) -> std::uint32_t {
+            const auto hash_it = hashes.find(id);
+            if (hash_it != hashes.end())
+                return hash_it->second;
+            unhashed.push_back(id);
+            return 0;
+        };
+
         switch (opCode) {
         case spv::Op::OpTypeVoid:         return 0;
         case spv::Op::OpTypeBool:         return 1;
         case spv::Op::OpTypeInt:          return 3 + (spv[typeStart+3]);
         case spv::Op::OpTypeFloat:        return 5;
         case spv::Op::OpTypeVector:
-            return 6 + hashType(idPos(spv[typeStart+2])) * (spv[typeStart+3] - 1);
+            return 6 + hashOf(spv[typeStart+2]) * (spv[typeStart+3] - 1);
         case spv::Op::OpTypeMatrix:
-            return 30 + hashType(idPos(spv[typeStart+2])) * (spv[typeStart+3] - 1);
+            return 30 + hashOf(spv[typeStart+2]) * (spv[typeStart+3] - 1);
         case spv::Op::OpTypeImage:
-            return 120 + hashType(idPos(spv[typeStart+2])) +
+            return 120 + hashOf(spv[typeStart+2]) +
                 spv[typeStart+3] +            // dimensionality
                 spv[typeStart+4] * 8 * 16 +   // depth
                 spv[typeStart+5] * 4 * 16 +   // arrayed
@@ -1365,24 +1375,24 @@ namespace spv {
         case spv::Op::OpTypeSampledImage:
             return 502;
         case spv::Op::OpTypeArray:
-            return 501 + hashType(idPos(spv[typeStart+2])) * spv[typeStart+3];
+            return 501 + hashOf(spv[typeStart+2]) * spv[typeStart+3];
         case spv::Op::OpTypeRuntimeArray:
-            return 5000  + hashType(idPos(spv[typeStart+2]));
+            return 5000  + hashOf(spv[typeStart+2]);
         case spv::Op::OpTypeStruct:
             {
                 std::uint32_t hash = 10000;
                 for (unsigned w=2; w < wordCount; ++w)
-                    hash += w * hashType(idPos(spv[typeStart+w]));
+                    hash += w * hashOf(spv[typeStart+w]);
                 return hash;
             }
 
         case spv::Op::OpTypeOpaque:         return 6000 + spv[typeStart+2];
-        case spv::Op::OpTypePointer:        return 100000  + hashType(idPos(spv[typeStart+3]));
+        case spv::Op::OpTypePointer:        return 100000  + hashOf(spv[typeStart+3]);
         case spv::Op::OpTypeFunction:
             {
                 std::uint32_t hash = 200000;
                 for (unsigned w=2; w < wordCount; ++w)
-                    hash += w * hashType(idPos(spv[typeStart+w]));
+                    hash += w * hashOf(spv[typeStart+w]);
                 return hash;
             }
 
@@ -1397,26 +1407,26 @@ namespace spv {
         case spv::Op::OpTypeAccelerationStructureKHR:   return 300010;
         case spv::Op::OpConstantComposite:
             {
-                std::uint32_t hash = 300011 + hashType(idPos(spv[typeStart+1]));
+                std::uint32_t hash = 300011 + hashOf(spv[typeStart+1]);
                 for (unsigned w=3; w < wordCount; ++w)
-                    hash += w * hashType(idPos(spv[typeStart+w]));
+                    hash += w * hashOf(spv[typeStart+w]);
                 return hash;
             }
         case spv::Op::OpConstant:
             {
-                std::uint32_t hash = 400011 + hashType(idPos(spv[typeStart+1]));
+                std::uint32_t hash = 400011 + hashOf(spv[typeStart+1]);
                 for (unsigned w=3; w < wordCount; ++w)
                     hash += w * spv[typeStart+w];
                 return hash;
             }
         case spv::Op::OpConstantNull:
             {
-                std::uint32_t hash = 500009 + hashType(idPos(spv[typeStart+1]));
+                std::uint32_t hash = 500009 + hashOf(spv[typeStart+1]);
                 return hash;
             }
         case spv::Op::OpConstantSampler:
             {
-                std::uint32_t hash = 600011 + hashType(idPos(spv[typeStart+1]));
+                std::uint32_t hash = 600011 + hashOf(spv[typeStart+1]);
                 for (unsigned w=3; w < wordCount; ++w)
                     hash += w * spv[typeStart+w];
                 return hash;
@@ -1428,6 +1438,55 @@ namespace spv {
         }
     }
 
+    // Hash types to canonical values.  This can return ID collisions (it's a bit
+    // inevitable): it's up to the caller to handle that gracefully.
+    //
+    // Each hash is kept in 'hashes', so a type shared by many others is hashed
+    // once.  What a type refers to is hashed before it, from an explicit stack
+    // rather than by recursion, so deep nesting costs no stack.  A cycle, which
+    // only a forward pointer can make, is broken at the type closing it, which
+    // counts as 0 where it is referred to.
+    std::uint32_t spirvbin_t::hashType(unsigned typeStart, typehashes_t& hashes) const
+    {
+        std::vector<unsigned> pending(1, typeStart);
+        idset_t               expanded;   // those whose operands have been pushed
+        std::vector<spv::Id>  unhashed;
+
+        while (!pending.empty()) {
+            const unsigned start = pending.back();
+            const spv::Id  id    = asTypeConstId(start);
+
+            if (hashes.find(id) != hashes.end()) {
+                pending.pop_back();
+                continue;
+            }
+
+            unhashed.clear();
+            const std::uint32_t hash = hashTypeInst(start, hashes, unhashed);
+            if (errorLatch)
+                return 0;
+
+            bool waiting = false;
+            if (expanded.insert(id).second) {
+                for (const spv::Id operand : unhashed) {
+                    if (expanded.find(operand) == expanded.end()) {
+                        pending.push_back(idPos(operand));
+                        if (errorLatch)
+                            return 0;
+                        waiting = true;
+                    }
+                }
+            }
+
+            if (!waiting) {
+                hashes[id] = hash;
+                pending.pop_back();
+            }
+        }
+
+        return hashes[asTypeConstId(typeStart)];
+    }
+
     void spirvbin_t::mapTypeConst()
     {
         globaltypes_t globalTypeMap;
@@ -1437,9 +1496,11 @@ namespace spv {
         static const std::uint32_t softTypeIdLimit = 3011; // small prime.  TODO: get from options
         static const std::uint32_t firstMappedID   = 8;    // offset into ID space
 
+        typehashes_t typeHashes;
+
         for (auto& typeStart : typeConstPos) {
             const spv::Id       resId     = asTypeConstId(typeStart);
-            const std::uint32_t hashval   = hashType(typeStart);
+            const std::uint32_t hashval   = hashType(typeStart, typeHashes);
 
             if (errorLatch)
                 return;
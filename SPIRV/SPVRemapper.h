@@ -219,7 +219,9 @@ private:
 
    // bool    matchType(const globaltypes_t& globalTypes, spv::Id lt, spv::Id gt) const;
    // spv::Id findType(const globaltypes_t& globalTypes, spv::Id lt) const;
-   std::uint32_t hashType(unsigned typeStart) const;
+   typedef std::unordered_map<spv::Id, std::uint32_t> typehashes_t;
+   std::uint32_t hashType(unsigned typeStart, typehashes_t& hashes) const;
+   std::uint32_t hashTypeInst(unsigned typeStart, const typehashes_t& hashes, std::vector<spv::Id>& unhashed) const;
 
    spirvbin_t& process(instfn_t, idfn_t, unsigned begin = 0, unsigned end = 0);
    int         processInstruction(unsigned word, instfn_t, idfn_t);
@@ -92,7 +92,7 @@ Id Builder::makeVoidType()
     if (groupedTypes[enumCast(Op::OpTypeVoid)].size() == 0) {
         Id typeId = getUniqueId();
         type = new Instruction(typeId, NoType, Op::OpTypeVoid);
-        groupedTypes[enumCast(Op::OpTypeVoid)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
         // Core OpTypeVoid used for debug void type
@@ -109,7 +109,7 @@ Id Builder::makeBoolType()
     Instruction* type;
     if (groupedTypes[enumCast(Op::OpTypeBool)].size() == 0) {
         type = new Instruction(getUniqueId(), NoType, Op::OpTypeBool);
-        groupedTypes[enumCast(Op::OpTypeBool)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
 
@@ -130,7 +130,7 @@ Id Builder::makeSamplerType()
     Instruction* type;
     if (groupedTypes[enumCast(Op::OpTypeSampler)].size() == 0) {
         type = new Instruction(getUniqueId(), NoType, Op::OpTypeSampler);
-        groupedTypes[enumCast(Op::OpTypeSampler)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
     } else
@@ -148,20 +148,17 @@ Id Builder::makeSamplerType()
 Id Builder::makePointer(StorageClass storageClass, Id pointee)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypePointer)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypePointer)][t];
-        if (type->getImmediateOperand(0) == (unsigned)storageClass &&
-            type->getIdOperand(1) == pointee)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { (unsigned int)storageClass, pointee };
+    Instruction* type = findType(Op::OpTypePointer, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypePointer);
     type->reserveOperands(2);
     type->addImmediateOperand(storageClass);
     type->addIdOperand(pointee);
-    groupedTypes[enumCast(Op::OpTypePointer)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -193,19 +190,16 @@ Id Builder::makeForwardPointer(StorageClass storageClass)
 Id Builder::makePointerFromForwardPointer(StorageClass storageClass, Id forwardPointerType, Id pointee)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypePointer)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypePointer)][t];
-        if (type->getImmediateOperand(0) == (unsigned)storageClass &&
-            type->getIdOperand(1) == pointee)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { (unsigned int)storageClass, pointee };
+    Instruction* type = findType(Op::OpTypePointer, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     type = new Instruction(forwardPointerType, NoType, Op::OpTypePointer);
     type->reserveOperands(2);
     type->addImmediateOperand(storageClass);
     type->addIdOperand(pointee);
-    groupedTypes[enumCast(Op::OpTypePointer)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -224,20 +218,17 @@ Id Builder::makePointerFromForwardPointer(StorageClass storageClass, Id forwardP
 Id Builder::makeIntegerType(int width, bool hasSign)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeInt)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeInt)][t];
-        if (type->getImmediateOperand(0) == (unsigned)width &&
-            type->getImmediateOperand(1) == (hasSign ? 1u : 0u))
-            return type->getResultId();
-    }
+    const unsigned int words[] = { (unsigned int)width, hasSign ? 1u : 0u };
+    Instruction* type = findType(Op::OpTypeInt, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeInt);
     type->reserveOperands(2);
     type->addImmediateOperand(width);
     type->addImmediateOperand(hasSign ? 1 : 0);
-    groupedTypes[enumCast(Op::OpTypeInt)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -266,20 +257,15 @@ Id Builder::makeIntegerType(int width, bool hasSign)
 Id Builder::makeFloatType(int width)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeFloat)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeFloat)][t];
-        if (type->getNumOperands() != 1) {
-            continue;
-        }
-        if (type->getImmediateOperand(0) == (unsigned)width)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { (unsigned int)width };
+    Instruction* type = findType(Op::OpTypeFloat, words, 1);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeFloat);
     type->addImmediateOperand(width);
-    groupedTypes[enumCast(Op::OpTypeFloat)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -307,22 +293,16 @@ Id Builder::makeFloatType(int width)
 Id Builder::makeBFloat16Type()
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeFloat)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeFloat)][t];
-        if (type->getNumOperands() != 2) {
-            continue;
-        }
-        if (type->getImmediateOperand(0) == (unsigned)16 &&
-            type->getImmediateOperand(1) == FPEncoding::BFloat16KHR)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { 16, (unsigned int)FPEncoding::BFloat16KHR };
+    Instruction* type = findType(Op::OpTypeFloat, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeFloat);
     type->addImmediateOperand(16);
     type->addImmediateOperand(FPEncoding::BFloat16KHR);
-    groupedTypes[enumCast(Op::OpTypeFloat)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -344,22 +324,16 @@ Id Builder::makeBFloat16Type()
 Id Builder::makeFloatE5M2Type()
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeFloat)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeFloat)][t];
-        if (type->getNumOperands() != 2) {
-            continue;
-        }
-        if (type->getImmediateOperand(0) == (unsigned)8 &&
-            type->getImmediateOperand(1) == FPEncoding::Float8E5M2EXT)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { 8, (unsigned int)FPEncoding::Float8E5M2EXT };
+    Instruction* type = findType(Op::OpTypeFloat, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeFloat);
     type->addImmediateOperand(8);
     type->addImmediateOperand(FPEncoding::Float8E5M2EXT);
-    groupedTypes[enumCast(Op::OpTypeFloat)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -381,22 +355,16 @@ Id Builder::makeFloatE5M2Type()
 Id Builder::makeFloatE4M3Type()
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeFloat)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeFloat)][t];
-        if (type->getNumOperands() != 2) {
-            continue;
-        }
-        if (type->getImmediateOperand(0) == (unsigned)8 &&
-            type->getImmediateOperand(1) == FPEncoding::Float8E4M3EXT)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { 8, (unsigned int)FPEncoding::Float8E4M3EXT };
+    Instruction* type = findType(Op::OpTypeFloat, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeFloat);
     type->addImmediateOperand(8);
     type->addImmediateOperand(FPEncoding::Float8E4M3EXT);
-    groupedTypes[enumCast(Op::OpTypeFloat)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -428,7 +396,7 @@ Id Builder::makeStructType(const std::vector<Id>& members, const char* name, boo
     Instruction* type = new Instruction(getUniqueId(), NoType, Op::OpTypeStruct);
     for (int op = 0; op < (int)members.size(); ++op)
         type->addIdOperand(members[op]);
-    groupedTypes[enumCast(Op::OpTypeStruct)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
     addName(type->getResultId(), name);
@@ -469,20 +437,17 @@ Id Builder::makeStructResultType(Id type0, Id type1)
 Id Builder::makeVectorType(Id component, int size)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeVector)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeVector)][t];
-        if (type->getIdOperand(0) == component &&
-            type->getImmediateOperand(1) == (unsigned)size)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { component, (unsigned int)size };
+    Instruction* type = findType(Op::OpTypeVector, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeVector);
     type->reserveOperands(2);
     type->addIdOperand(component);
     type->addImmediateOperand(size);
-    groupedTypes[enumCast(Op::OpTypeVector)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -502,20 +467,17 @@ Id Builder::makeMatrixType(Id component, int cols, int rows)
     Id column = makeVectorType(component, rows);
 
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeMatrix)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeMatrix)][t];
-        if (type->getIdOperand(0) == column &&
-            type->getImmediateOperand(1) == (unsigned)cols)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { column, (unsigned int)cols };
+    Instruction* type = findType(Op::OpTypeMatrix, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeMatrix);
     type->reserveOperands(2);
     type->addIdOperand(column);
     type->addImmediateOperand(cols);
-    groupedTypes[enumCast(Op::OpTypeMatrix)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -531,16 +493,10 @@ Id Builder::makeMatrixType(Id component, int cols, int rows)
 Id Builder::makeCooperativeMatrixTypeKHR(Id component, Id scope, Id rows, Id cols, Id use)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeCooperativeMatrixKHR)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeCooperativeMatrixKHR)][t];
-        if (type->getIdOperand(0) == component &&
-            type->getIdOperand(1) == scope &&
-            type->getIdOperand(2) == rows &&
-            type->getIdOperand(3) == cols &&
-            type->getIdOperand(4) == use)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { component, scope, rows, cols, use };
+    Instruction* type = findType(Op::OpTypeCooperativeMatrixKHR, words, 5);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeCooperativeMatrixKHR);
@@ -550,7 +506,7 @@ Id Builder::makeCooperativeMatrixTypeKHR(Id component, Id scope, Id rows, Id col
     type->addIdOperand(rows);
     type->addIdOperand(cols);
     type->addIdOperand(use);
-    groupedTypes[enumCast(Op::OpTypeCooperativeMatrixKHR)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -597,13 +553,10 @@ Id Builder::makeCooperativeMatrixTypeKHR(Id component, Id scope, Id rows, Id col
 Id Builder::makeCooperativeMatrixTypeNV(Id component, Id scope, Id rows, Id cols)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeCooperativeMatrixNV)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeCooperativeMatrixNV)][t];
-        if (type->getIdOperand(0) == component && type->getIdOperand(1) == scope && type->getIdOperand(2) == rows &&
-            type->getIdOperand(3) == cols)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { component, scope, rows, cols };
+    Instruction* type = findType(Op::OpTypeCooperativeMatrixNV, words, 4);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeCooperativeMatrixNV);
@@ -612,7 +565,7 @@ Id Builder::makeCooperativeMatrixTypeNV(Id component, Id scope, Id rows, Id cols
     type->addIdOperand(scope);
     type->addIdOperand(rows);
     type->addIdOperand(cols);
-    groupedTypes[enumCast(Op::OpTypeCooperativeMatrixNV)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -633,19 +586,16 @@ Id Builder::makeCooperativeMatrixTypeWithSameShape(Id component, Id otherType)
 Id Builder::makeCooperativeVectorTypeNV(Id componentType, Id components)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeCooperativeVectorNV)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeCooperativeVectorNV)][t];
-        if (type->getIdOperand(0) == componentType &&
-            type->getIdOperand(1) == components)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { componentType, components };
+    Instruction* type = findType(Op::OpTypeCooperativeVectorNV, words, 2);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeCooperativeVectorNV);
     type->addIdOperand(componentType);
     type->addIdOperand(components);
-    groupedTypes[enumCast(Op::OpTypeCooperativeVectorNV)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -655,19 +605,12 @@ Id Builder::makeCooperativeVectorTypeNV(Id componentType, Id components)
 Id Builder::makeGenericType(spv::Op opcode, std::vector<spv::IdImmediate>& operands)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(opcode)].size(); ++t) {
-        type = groupedTypes[enumCast(opcode)][t];
-        if (static_cast<size_t>(type->getNumOperands()) != operands.size())
-            continue; // Number mismatch, find next
-
-        bool match = true;
-        for (int op = 0; match && op < (int)operands.size(); ++op) {
-            match = (operands[op].isId ? type->getIdOperand(op) : type->getImmediateOperand(op)) == operands[op].word;
-        }
-        if (match)
-            return type->getResultId();
-    }
+    std::vector<unsigned int> words(operands.size());
+    for (size_t op = 0; op < operands.size(); ++op)
+        words[op] = operands[op].word;
+    Instruction* type = findType(opcode, words.data(), (int)words.size());
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, opcode);
@@ -678,7 +621,7 @@ Id Builder::makeGenericType(spv::Op opcode, std::vector<spv::IdImmediate>& opera
         else
             type->addImmediateOperand(operands[op].word);
     }
-    groupedTypes[enumCast(opcode)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -693,14 +636,11 @@ Id Builder::makeArrayType(Id element, Id sizeId, int stride)
 {
     Instruction* type;
     if (stride == 0) {
-        // try to find existing type
-        for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeArray)].size(); ++t) {
-            type = groupedTypes[enumCast(Op::OpTypeArray)][t];
-            if (type->getIdOperand(0) == element &&
-                type->getIdOperand(1) == sizeId &&
-                explicitlyLaidOut.find(type->getResultId()) == explicitlyLaidOut.end())
-                return type->getResultId();
-        }
+        // try to find existing type; explicitly laid out arrays are not indexed for reuse
+        const unsigned int words[] = { element, sizeId };
+        type = findType(Op::OpTypeArray, words, 2);
+        if (type != nullptr)
+            return type->getResultId();
     }
 
     // not found, make it
@@ -708,7 +648,7 @@ Id Builder::makeArrayType(Id element, Id sizeId, int stride)
     type->reserveOperands(2);
     type->addIdOperand(element);
     type->addIdOperand(sizeId);
-    groupedTypes[enumCast(Op::OpTypeArray)].push_back(type);
+    indexType(type, stride == 0);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -744,33 +684,24 @@ Id Builder::makeRuntimeArray(Id element)
 Id Builder::makeFunctionType(Id returnType, const std::vector<Id>& paramTypes)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeFunction)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeFunction)][t];
-        if (type->getIdOperand(0) != returnType || (int)paramTypes.size() != type->getNumOperands() - 1)
-            continue;
-        bool mismatch = false;
-        for (int p = 0; p < (int)paramTypes.size(); ++p) {
-            if (paramTypes[p] != type->getIdOperand(p + 1)) {
-                mismatch = true;
-                break;
-            }
-        }
-        if (! mismatch)
-        {
-            // If compiling HLSL, glslang will create a wrapper function around the entrypoint. Accordingly, a void(void)
-            // function type is created for the wrapper function. However, nonsemantic shader debug information is disabled
-            // while creating the HLSL wrapper. Consequently, if we encounter another void(void) function, we need to create
-            // the associated debug function type if it hasn't been created yet.
-            if(emitNonSemanticShaderDebugInfo && debugId[type->getResultId()] == 0) {
-                assert(sourceLang == spv::SourceLanguage::HLSL);
-                assert(getTypeClass(returnType) == Op::OpTypeVoid && paramTypes.size() == 0);
-
-                Id debugTypeId = makeDebugFunctionType(returnType, {});
-                debugId[type->getResultId()] = debugTypeId;
-            }
-            return type->getResultId();
+    std::vector<unsigned int> words;
+    words.reserve(paramTypes.size() + 1);
+    words.push_back(returnType);
+    words.insert(words.end(), paramTypes.begin(), paramTypes.end());
+    Instruction* type = findType(Op::OpTypeFunction, words.data(), (int)words.size());
+    if (type != nullptr) {
+        // If compiling HLSL, glslang will create a wrapper function around the entrypoint. Accordingly, a void(void)
+        // function type is created for the wrapper function. However, nonsemantic shader debug information is disabled
+        // while creating the HLSL wrapper. Consequently, if we encounter another void(void) function, we need to create
+        // the associated debug function type if it hasn't been created yet.
+        if(emitNonSemanticShaderDebugInfo && debugId[type->getResultId()] == 0) {
+            assert(sourceLang == spv::SourceLanguage::HLSL);
+            assert(getTypeClass(returnType) == Op::OpTypeVoid && paramTypes.size() == 0);
+
+            Id debugTypeId = makeDebugFunctionType(returnType, {});
+            debugId[type->getResultId()] = debugTypeId;
         }
+        return type->getResultId();
     }
 
     // not found, make it
@@ -780,7 +711,7 @@ Id Builder::makeFunctionType(Id returnType, const std::vector<Id>& paramTypes)
     type->addIdOperand(returnType);
     for (int p = 0; p < (int)paramTypes.size(); ++p)
         type->addIdOperand(paramTypes[p]);
-    groupedTypes[enumCast(Op::OpTypeFunction)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -823,18 +754,11 @@ Id Builder::makeImageType(Id sampledType, Dim dim, bool depth, bool arrayed, boo
     assert(sampled == 1 || sampled == 2);
 
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeImage)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeImage)][t];
-        if (type->getIdOperand(0) == sampledType &&
-            type->getImmediateOperand(1) == (unsigned int)dim &&
-            type->getImmediateOperand(2) == (  depth ? 1u : 0u) &&
-            type->getImmediateOperand(3) == (arrayed ? 1u : 0u) &&
-            type->getImmediateOperand(4) == (     ms ? 1u : 0u) &&
-            type->getImmediateOperand(5) == sampled &&
-            type->getImmediateOperand(6) == (unsigned int)format)
-            return type->getResultId();
-    }
+    const unsigned int words[] = { sampledType, (unsigned int)dim, depth ? 1u : 0u, arrayed ? 1u : 0u, ms ? 1u : 0u,
+                                   sampled, (unsigned int)format };
+    Instruction* type = findType(Op::OpTypeImage, words, 7);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeImage);
@@ -847,7 +771,7 @@ Id Builder::makeImageType(Id sampledType, Dim dim, bool depth, bool arrayed, boo
     type->addImmediateOperand(sampled);
     type->addImmediateOperand((unsigned int)format);
 
-    groupedTypes[enumCast(Op::OpTypeImage)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -919,18 +843,15 @@ Id Builder::makeImageType(Id sampledType, Dim dim, bool depth, bool arrayed, boo
 Id Builder::makeSampledImageType(Id imageType)
 {
     // try to find it
-    Instruction* type;
-    for (int t = 0; t < (int)groupedTypes[enumCast(Op::OpTypeSampledImage)].size(); ++t) {
-        type = groupedTypes[enumCast(Op::OpTypeSampledImage)][t];
-        if (type->getIdOperand(0) == imageType)
-            return type->getResultId();
-    }
+    Instruction* type = findType(Op::OpTypeSampledImage, &imageType, 1);
+    if (type != nullptr)
+        return type->getResultId();
 
     // not found, make it
     type = new Instruction(getUniqueId(), NoType, Op::OpTypeSampledImage);
     type->addIdOperand(imageType);
 
-    groupedTypes[enumCast(Op::OpTypeSampledImage)].push_back(type);
+    indexType(type);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
     module.mapInstruction(type);
 
@@ -1441,7 +1362,7 @@ Id Builder::makeAccelerationStructureType()
     Instruction *type;
     if (groupedTypes[enumCast(Op::OpTypeAccelerationStructureKHR)].size() == 0) {
         type = new Instruction(getUniqueId(), NoType, Op::OpTypeAccelerationStructureKHR);
-        groupedTypes[enumCast(Op::OpTypeAccelerationStructureKHR)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
         if (emitNonSemanticShaderDebugInfo) {
@@ -1460,7 +1381,7 @@ Id Builder::makeRayQueryType()
     Instruction *type;
     if (groupedTypes[enumCast(Op::OpTypeRayQueryKHR)].size() == 0) {
         type = new Instruction(getUniqueId(), NoType, Op::OpTypeRayQueryKHR);
-        groupedTypes[enumCast(Op::OpTypeRayQueryKHR)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
         if (emitNonSemanticShaderDebugInfo) {
@@ -1479,7 +1400,7 @@ Id Builder::makeHitObjectNVType()
     Instruction *type;
     if (groupedTypes[enumCast(Op::OpTypeHitObjectNV)].size() == 0) {
         type = new Instruction(getUniqueId(), NoType, Op::OpTypeHitObjectNV);
-        groupedTypes[enumCast(Op::OpTypeHitObjectNV)].push_back(type);
+        indexType(type);
         constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(type));
         module.mapInstruction(type);
     } else {
@@ -1684,36 +1605,98 @@ bool Builder::containsPhysicalStorageBufferOrArray(Id typeId) const
     }
 }
 
-// See if a scalar constant of this type has already been created, so it
-// can be reused rather than duplicated.  (Required by the specification).
-Id Builder::findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned value)
+// Hash of an instruction's opcode, type and operand words, for finding existing
+// constants and types without scanning all of them.
+size_t Builder::structuralHash(Op opcode, Id typeId, const unsigned int* words, int count)
 {
-    Instruction* constant;
-    for (int i = 0; i < (int)groupedConstants[enumCast(typeClass)].size(); ++i) {
-        constant = groupedConstants[enumCast(typeClass)][i];
-        if (constant->getOpCode() == opcode &&
-            constant->getTypeId() == typeId &&
-            constant->getImmediateOperand(0) == value)
-            return constant->getResultId();
+    size_t hash = std::hash<unsigned int>()(enumCast(opcode));
+    const auto combine = [&hash](unsigned int word) {
+        hash ^= std::hash<unsigned int>()(word) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    combine(typeId);
+    for (int w = 0; w < count; ++w)
+        combine(words[w]);
+
+    return hash;
+}
+
+// Returns true if 'instruction' has exactly the given operand words.
+static bool hasOperandWords(const Instruction& instruction, const unsigned int* words, int count)
+{
+    if (instruction.getNumOperands() != count)
+        return false;
+    for (int op = 0; op < count; ++op) {
+        const unsigned int word = instruction.isIdOperand(op) ? instruction.getIdOperand(op)
+                                                              : instruction.getImmediateOperand(op);
+        if (word != words[op])
+            return false;
     }
 
-    return 0;
+    return true;
+}
+
+// Returns the opcode a constant is indexed under: struct constants are matched
+// whatever their opcode.
+Op Builder::constantIndexOpCode(Op opcode, Id typeId) const
+{
+    return getTypeClass(typeId) == Op::OpTypeStruct ? Op::OpTypeStruct : opcode;
+}
+
+// Index a new constant, for findConstant().
+void Builder::indexConstant(Instruction* constant)
+{
+    std::vector<unsigned int> words(constant->getNumOperands());
+    for (int op = 0; op < constant->getNumOperands(); ++op)
+        words[op] = constant->isIdOperand(op) ? constant->getIdOperand(op) : constant->getImmediateOperand(op);
+    const Op opcode = constantIndexOpCode(constant->getOpCode(), constant->getTypeId());
+    groupedConstants[structuralHash(opcode, constant->getTypeId(), words.data(), (int)words.size())].push_back(constant);
 }
 
-// Version of findScalarConstant (see above) for scalars that take two operands (e.g. a 'double' or 'int64').
-Id Builder::findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned v1, unsigned v2)
+// See if a constant with this opcode, type and operands has already been created,
+// so it can be reused rather than duplicated.  (Required by the specification).
+Id Builder::findConstant(Op opcode, Id typeId, const unsigned int* words, int count)
 {
-    Instruction* constant;
-    for (int i = 0; i < (int)groupedConstants[enumCast(typeClass)].size(); ++i) {
-        constant = groupedConstants[enumCast(typeClass)][i];
-        if (constant->getOpCode() == opcode &&
+    const Op indexOpCode = constantIndexOpCode(opcode, typeId);
+    auto it = groupedConstants.find(structuralHash(indexOpCode, typeId, words, count));
+    if (it == groupedConstants.end())
+        return NoResult;
+
+    for (const Instruction* constant : it->second) {
+        if ((indexOpCode == Op::OpTypeStruct || constant->getOpCode() == opcode) &&
             constant->getTypeId() == typeId &&
-            constant->getImmediateOperand(0) == v1 &&
-            constant->getImmediateOperand(1) == v2)
+            hasOperandWords(*constant, words, count))
             return constant->getResultId();
     }
 
-    return 0;
+    return NoResult;
+}
+
+// Index a new type.  Types that can be reused are also indexed by structure, for findType().
+void Builder::indexType(Instruction* type, bool reusable)
+{
+    groupedTypes[enumCast(type->getOpCode())].push_back(type);
+    if (! reusable)
+        return;
+
+    std::vector<unsigned int> words(type->getNumOperands());
+    for (int op = 0; op < type->getNumOperands(); ++op)
+        words[op] = type->isIdOperand(op) ? type->getIdOperand(op) : type->getImmediateOperand(op);
+    hashedTypes[structuralHash(type->getOpCode(), NoType, words.data(), (int)words.size())].push_back(type);
+}
+
+// Returns the first reusable type with this opcode and exactly these operands, or nullptr.
+Instruction* Builder::findType(Op opcode, const unsigned int* words, int count) const
+{
+    auto it = hashedTypes.find(structuralHash(opcode, NoType, words, count));
+    if (it == hashedTypes.end())
+        return nullptr;
+
+    for (Instruction* type : it->second) {
+        if (type->getOpCode() == opcode && hasOperandWords(*type, words, count))
+            return type;
+    }
+
+    return nullptr;
 }
 
 // Return true if consuming 'opcode' means consuming a constant.
@@ -1760,23 +1743,15 @@ bool Builder::isSpecConstantOpCode(Op opcode) const
 
 Id Builder::makeNullConstant(Id typeId)
 {
-    Instruction* constant;
-
     // See if we already made it.
-    Id existing = NoResult;
-    for (int i = 0; i < (int)nullConstants.size(); ++i) {
-        constant = nullConstants[i];
-        if (constant->getTypeId() == typeId)
-            existing = constant->getResultId();
-    }
-
+    Id existing = findConstant(Op::OpConstantNull, typeId, nullptr, 0);
     if (existing != NoResult)
         return existing;
 
     // Make it
     Instruction* c = new Instruction(getUniqueId(), typeId, Op::OpConstantNull);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    nullConstants.push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1785,19 +1760,12 @@ Id Builder::makeNullConstant(Id typeId)
 Id Builder::makeBoolConstant(bool b, bool specConstant)
 {
     Id typeId = makeBoolType();
-    Instruction* constant;
     Op opcode = specConstant ? (b ? Op::OpSpecConstantTrue : Op::OpSpecConstantFalse) : (b ? Op::OpConstantTrue : Op::OpConstantFalse);
 
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (! specConstant) {
-        Id existing = 0;
-        for (int i = 0; i < (int)groupedConstants[enumCast(Op::OpTypeBool)].size(); ++i) {
-            constant = groupedConstants[enumCast(Op::OpTypeBool)][i];
-            if (constant->getTypeId() == typeId && constant->getOpCode() == opcode)
-                existing = constant->getResultId();
-        }
-
+        Id existing = findConstant(opcode, typeId, nullptr, 0);
         if (existing)
             return existing;
     }
@@ -1805,7 +1773,7 @@ Id Builder::makeBoolConstant(bool b, bool specConstant)
     // Make it
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeBool)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1818,7 +1786,7 @@ Id Builder::makeIntConstant(Id typeId, unsigned value, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (! specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeInt, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -1826,7 +1794,7 @@ Id Builder::makeIntConstant(Id typeId, unsigned value, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeInt)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1838,11 +1806,12 @@ Id Builder::makeInt64Constant(Id typeId, unsigned long long value, bool specCons
 
     unsigned op1 = value & 0xFFFFFFFF;
     unsigned op2 = value >> 32;
+    const unsigned words[] = { op1, op2 };
 
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (! specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeInt, opcode, typeId, op1, op2);
+        Id existing = findConstant(opcode, typeId, words, 2);
         if (existing)
             return existing;
     }
@@ -1852,7 +1821,7 @@ Id Builder::makeInt64Constant(Id typeId, unsigned long long value, bool specCons
     c->addImmediateOperand(op1);
     c->addImmediateOperand(op2);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeInt)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1869,7 +1838,7 @@ Id Builder::makeFloatConstant(float f, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (! specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -1877,7 +1846,7 @@ Id Builder::makeFloatConstant(float f, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1892,11 +1861,12 @@ Id Builder::makeDoubleConstant(double d, bool specConstant)
     unsigned long long value = u.ull;
     unsigned op1 = value & 0xFFFFFFFF;
     unsigned op2 = value >> 32;
+    const unsigned words[] = { op1, op2 };
 
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (! specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, op1, op2);
+        Id existing = findConstant(opcode, typeId, words, 2);
         if (existing)
             return existing;
     }
@@ -1906,7 +1876,7 @@ Id Builder::makeDoubleConstant(double d, bool specConstant)
     c->addImmediateOperand(op1);
     c->addImmediateOperand(op2);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1926,7 +1896,7 @@ Id Builder::makeFloat16Constant(float f16, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (!specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -1934,7 +1904,7 @@ Id Builder::makeFloat16Constant(float f16, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1957,7 +1927,7 @@ Id Builder::makeBFloat16Constant(float bf16, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (!specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -1965,7 +1935,7 @@ Id Builder::makeBFloat16Constant(float bf16, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -1985,7 +1955,7 @@ Id Builder::makeFloatE5M2Constant(float fe5m2, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (!specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -1993,7 +1963,7 @@ Id Builder::makeFloatE5M2Constant(float fe5m2, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -2013,7 +1983,7 @@ Id Builder::makeFloatE4M3Constant(float fe4m3, bool specConstant)
     // See if we already made it. Applies only to regular constants, because specialization constants
     // must remain distinct for the purpose of applying a SpecId decoration.
     if (!specConstant) {
-        Id existing = findScalarConstant(Op::OpTypeFloat, opcode, typeId, value);
+        Id existing = findConstant(opcode, typeId, &value, 1);
         if (existing)
             return existing;
     }
@@ -2021,7 +1991,7 @@ Id Builder::makeFloatE4M3Constant(float fe4m3, bool specConstant)
     Instruction* c = new Instruction(getUniqueId(), typeId, opcode);
     c->addImmediateOperand(value);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    groupedConstants[enumCast(Op::OpTypeFloat)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -2061,64 +2031,6 @@ Id Builder::importNonSemanticShaderDebugInfoInstructions()
     return nonSemanticShaderDebugInfo;
 }
 
-Id Builder::findCompositeConstant(Op typeClass, Op opcode, Id typeId, const std::vector<Id>& comps, size_t numMembers)
-{
-    Instruction* constant = nullptr;
-    bool found = false;
-    for (int i = 0; i < (int)groupedConstants[enumCast(typeClass)].size(); ++i) {
-        constant = groupedConstants[enumCast(typeClass)][i];
-
-        if (constant->getTypeId() != typeId)
-            continue;
-
-        if (constant->getOpCode() != opcode) {
-            continue;
-        }
-
-        if (constant->getNumOperands() != (int)numMembers)
-            continue;
-
-        // same contents?
-        bool mismatch = false;
-        for (int op = 0; op < constant->getNumOperands(); ++op) {
-            if (constant->getIdOperand(op) != comps[op]) {
-                mismatch = true;
-                break;
-            }
-        }
-        if (! mismatch) {
-            found = true;
-            break;
-        }
-    }
-
-    return found ? constant->getResultId() : NoResult;
-}
-
-Id Builder::findStructConstant(Id typeId, const std::vector<Id>& comps)
-{
-    Instruction* constant = nullptr;
-    bool found = false;
-    for (int i = 0; i < (int)groupedStructConstants[typeId].size(); ++i) {
-        constant = groupedStructConstants[typeId][i];
-
-        // same contents?
-        bool mismatch = false;
-        for (int op = 0; op < constant->getNumOperands(); ++op) {
-            if (constant->getIdOperand(op) != comps[op]) {
-                mismatch = true;
-                break;
-            }
-        }
-        if (! mismatch) {
-            found = true;
-            break;
-        }
-    }
-
-    return found ? constant->getResultId() : NoResult;
-}
-
 // Comments in header
 Id Builder::makeCompositeConstant(Id typeId, const std::vector<Id>& members, bool specConstant)
 {
@@ -2150,15 +2062,9 @@ Id Builder::makeCompositeConstant(Id typeId, const std::vector<Id>& members, boo
     case Op::OpTypeCooperativeMatrixKHR:
     case Op::OpTypeCooperativeMatrixNV:
     case Op::OpTypeCooperativeVectorNV:
-        if (! specConstant) {
-            Id existing = findCompositeConstant(typeClass, opcode, typeId, members, numMembers);
-            if (existing)
-                return existing;
-        }
-        break;
     case Op::OpTypeStruct:
         if (! specConstant) {
-            Id existing = findStructConstant(typeId, members);
+            Id existing = findConstant(opcode, typeId, members.data(), (int)numMembers);
             if (existing)
                 return existing;
         }
@@ -2173,10 +2079,7 @@ Id Builder::makeCompositeConstant(Id typeId, const std::vector<Id>& members, boo
     for (size_t op = 0; op < numMembers; ++op)
         c->addIdOperand(members[op]);
     constantsTypesGlobals.push_back(std::unique_ptr<Instruction>(c));
-    if (typeClass == Op::OpTypeStruct)
-        groupedStructConstants[typeId].push_back(c);
-    else
-        groupedConstants[enumCast(typeClass)].push_back(c);
+    indexConstant(c);
     module.mapInstruction(c);
 
     return c->getResultId();
@@ -4412,14 +4315,247 @@ Id Builder::accessChainGetInferredType()
     return type;
 }
 
+Builder::ModuleMark Builder::markModule() const
+{
+    return { uniqueId, strings.size(), imports.size(), executionModes.size(), names.size(),
+             constantsTypesGlobals.size(), functions.size() };
+}
+
+bool Builder::canMergeFunctionBodies(const Builder& other, const ModuleMark& mark) const
+{
+    // Functions and entry points all come from the prelude, and debug info
+    // ties instructions to scopes that are not merged.
+    return ! trackDebugInfo && ! other.trackDebugInfo &&
+           functions.size() == mark.functions && other.functions.size() == mark.functions &&
+           other.entryPoints.size() == entryPoints.size() &&
+           other.constantsTypesGlobals.size() >= mark.constantsTypesGlobals &&
+           other.strings.size() >= mark.strings && other.imports.size() >= mark.imports &&
+           other.names.size() >= mark.names && other.executionModes.size() >= mark.executionModes;
+}
+
+std::vector<Id> Builder::mergeFunctionBodies(Builder& other, const ModuleMark& mark,
+                                             const std::unordered_map<Id, Id>& sharedIds,
+                                             const std::vector<Id>& functionIds)
+{
+    assert(canMergeFunctionBodies(other, mark));
+
+    // Ids up to the mark are the same in both builders; the rest get renumbered.
+    std::vector<Id> idMap(other.uniqueId + 1, NoResult);
+    for (Id id = 1; id <= mark.bound && id <= other.uniqueId; ++id)
+        idMap[id] = id;
+
+    // The module-level instructions 'other' declared after the mark, by result id.
+    enum DeclarationKind : char { Undeclared, Declared, Type, ReusableType, Constant };
+    std::vector<char> kind(other.uniqueId + 1, Undeclared);
+    std::vector<const Instruction*> declarations(other.uniqueId + 1, nullptr);
+    const auto declare = [&](const std::vector<std::unique_ptr<Instruction>>& section, size_t first) {
+        for (size_t i = first; i < section.size(); ++i) {
+            const Id id = section[i]->getResultId();
+            if (id > mark.bound) {
+                kind[id] = Declared;
+                declarations[id] = section[i].get();
+            }
+        }
+    };
+    declare(other.strings, mark.strings);
+    declare(other.imports, mark.imports);
+    declare(other.constantsTypesGlobals, mark.constantsTypesGlobals);
+
+    const auto classify = [&](const std::unordered_map<size_t, std::vector<Instruction*>>& index,
+                              DeclarationKind indexKind) {
+        for (const auto& group : index) {
+            for (const Instruction* instruction : group.second) {
+                const Id id = instruction->getResultId();
+                if (id > mark.bound && kind[id] == Declared)
+                    kind[id] = indexKind;
+            }
+        }
+    };
+    classify(other.hashedTypes, ReusableType);
+    for (const auto& group : other.groupedTypes) {
+        for (const Instruction* type : group.second) {
+            if (type->getResultId() > mark.bound && kind[type->getResultId()] == Declared)
+                kind[type->getResultId()] = Type;
+        }
+    }
+    classify(other.groupedConstants, Constant);
+
+    // Declarations the caller keys itself are shared when this builder has them, and
+    // so are the parts declared along with them, like the members of a struct.
+    std::vector<bool> keyed(other.uniqueId + 1, false);
+    for (const auto& shared : sharedIds) {
+        if (shared.first <= mark.bound || shared.first > other.uniqueId || kind[shared.first] == Undeclared)
+            continue;
+        keyed[shared.first] = true;
+        idMap[shared.first] = shared.second;
+    }
+    const auto share = [&](Id from, Id to) {
+        if (from > mark.bound && kind[from] != Undeclared && ! keyed[from] && idMap[from] == NoResult)
+            idMap[from] = to;
+    };
+    for (Id id = other.uniqueId; id > mark.bound; --id) {
+        if (kind[id] == Undeclared || idMap[id] == NoResult)
+            continue;
+        const Instruction& from = *declarations[id];
+        const Instruction* to = module.getInstruction(idMap[id]);
+        if (to == nullptr || to->getOpCode() != from.getOpCode() || to->getNumOperands() != from.getNumOperands())
+            continue;
+        if (from.getTypeId() != NoType)
+            share(from.getTypeId(), to->getTypeId());
+        for (int op = 0; op < from.getNumOperands(); ++op) {
+            if (from.isIdOperand(op) && to->isIdOperand(op))
+                share(from.getIdOperand(op), to->getIdOperand(op));
+        }
+    }
+
+    // Number the rest in the order 'other' created them, reusing this builder's
+    // declarations where 'other' would have reused its own.  Nothing here can
+    // match a declaration that uses an id new to this builder.
+    const Id firstNewId = uniqueId + 1;
+    std::vector<unsigned int> words;
+    const auto remapWords = [&](const Instruction& instruction) {
+        words.resize(instruction.getNumOperands());
+        for (int op = 0; op < instruction.getNumOperands(); ++op) {
+            if (! instruction.isIdOperand(op))
+                words[op] = instruction.getImmediateOperand(op);
+            else if ((words[op] = idMap[instruction.getIdOperand(op)]) >= firstNewId)
+                return false;
+        }
+        return true;
+    };
+    const auto findExisting = [&](const Instruction& declaration) -> Id {
+        switch (kind[declaration.getResultId()]) {
+        case ReusableType: {
+            const Instruction* type = remapWords(declaration) ?
+                findType(declaration.getOpCode(), words.data(), (int)words.size()) : nullptr;
+            return type != nullptr ? type->getResultId() : NoResult;
+        }
+        case Constant: {
+            // Specialization constants stay distinct, as they do when created.
+            const Id typeId = idMap[declaration.getTypeId()];
+            if (isSpecConstantOpCode(declaration.getOpCode()) || typeId >= firstNewId || ! remapWords(declaration))
+                return NoResult;
+            return findConstant(declaration.getOpCode(), typeId, words.data(), (int)words.size());
+        }
+        default:
+            break;
+        }
+        if (declaration.getOpCode() == Op::OpString) {
+            auto it = stringIds.find(declaration.getNameString());
+            return it != stringIds.end() ? it->second : NoResult;
+        }
+        if (declaration.getOpCode() == Op::OpExtInstImport) {
+            remapWords(declaration);
+            for (const auto& import : imports) {
+                if (hasOperandWords(*import, words.data(), (int)words.size()))
+                    return import->getResultId();
+            }
+        }
+        return NoResult;
+    };
+    std::vector<bool> added(other.uniqueId + 1, false);
+    for (Id id = mark.bound + 1; id <= other.uniqueId; ++id) {
+        if (idMap[id] != NoResult)
+            continue;
+        if (kind[id] != Undeclared && ! keyed[id]) {
+            idMap[id] = findExisting(*declarations[id]);
+            if (idMap[id] != NoResult)
+                continue;
+        }
+        idMap[id] = getUniqueId();
+        added[id] = kind[id] != Undeclared;
+    }
+
+    // Move over the new declarations, keeping the order of each section.
+    const auto moveDeclarations = [&](std::vector<std::unique_ptr<Instruction>>& from, size_t first,
+                                      std::vector<std::unique_ptr<Instruction>>& to) {
+        for (size_t i = first; i < from.size(); ++i) {
+            const Id id = from[i]->getResultId();
+            if (id > mark.bound && ! added[id])
+                continue;
+            Instruction* declaration = from[i].get();
+            declaration->remapIds(idMap);
+            switch (kind[id]) {
+            case ReusableType:
+            case Type:
+                indexType(declaration, kind[id] == ReusableType);
+                if (other.explicitlyLaidOut.count(id) != 0)
+                    explicitlyLaidOut.insert(declaration->getResultId());
+                break;
+            case Constant:
+                indexConstant(declaration);
+                break;
+            default:
+                if (declaration->getOpCode() == Op::OpString)
+                    stringIds[declaration->getNameString()] = declaration->getResultId();
+                break;
+            }
+            to.push_back(std::move(from[i]));
+            module.mapInstruction(declaration);
+        }
+    };
+    moveDeclarations(other.strings, mark.strings, strings);
+    moveDeclarations(other.imports, mark.imports, imports);
+    moveDeclarations(other.constantsTypesGlobals, mark.constantsTypesGlobals, constantsTypesGlobals);
+
+    // Move over the function bodies.
+    const auto findFunction = [](const std::vector<std::unique_ptr<Function>>& list, Id functionId) {
+        for (const auto& function : list) {
+            if (function->getId() == functionId)
+                return function.get();
+        }
+        return static_cast<Function*>(nullptr);
+    };
+    for (Id functionId : functionIds) {
+        Function* from = findFunction(other.functions, functionId);
+        Function* to = findFunction(functions, functionId);
+        assert(from != nullptr && to != nullptr);
+        for (Block* block : from->getBlocks()) {
+            for (auto& instruction : block->getInstructions())
+                instruction->remapIds(idMap);
+            for (auto& variable : block->getLocalVariables())
+                variable->remapIds(idMap);
+        }
+        to->takeBlocks(*from);
+    }
+
+    // Names of shared declarations are already here.
+    for (size_t i = mark.names; i < other.names.size(); ++i) {
+        const Id target = other.names[i]->getIdOperand(0);
+        if (target > mark.bound && kind[target] != Undeclared && ! added[target])
+            continue;
+        other.names[i]->remapIds(idMap);
+        names.push_back(std::move(other.names[i]));
+    }
+
+    // Decorations are a set, so ones already here are dropped.
+    while (! other.decorations.empty()) {
+        auto decoration = other.decorations.extract(other.decorations.begin());
+        decoration.value()->remapIds(idMap);
+        decorations.insert(std::move(decoration));
+    }
+
+    for (size_t i = mark.executionModes; i < other.executionModes.size(); ++i) {
+        other.executionModes[i]->remapIds(idMap);
+        executionModes.push_back(std::move(other.executionModes[i]));
+    }
+    capabilities.insert(other.capabilities.begin(), other.capabilities.end());
+    extensions.insert(other.extensions.begin(), other.extensions.end());
+
+    return idMap;
+}
+
 void Builder::dump(std::vector<unsigned int>& out) const
+{
+    SpvVectorSink sink(out);
+    dump(sink);
+}
+
+void Builder::dump(SpvSink& out) const
 {
     // Header, before first instructions:
-    out.push_back(MagicNumber);
-    out.push_back(spvVersion);
-    out.push_back(builderNumber);
-    out.push_back(uniqueId + 1);
-    out.push_back(0);
+    const unsigned int header[] = { MagicNumber, spvVersion, (unsigned int)builderNumber, uniqueId + 1, 0 };
+    out.write(header, sizeof(header) / sizeof(header[0]));
 
     // Capabilities
     for (auto it = capabilities.cbegin(); it != capabilities.cend(); ++it) {
@@ -4654,7 +4790,7 @@ void Builder::createConditionalBranch(Id condition, Block* thenBlock, Block* els
 // [OpSourceContinued]
 // ...
 void Builder::dumpSourceInstructions(const spv::Id fileId, const std::string& text,
-                                     std::vector<unsigned int>& out) const
+                                     SpvSink& out) const
 {
     const int maxWordCount = 0xFFFF;
     const int opSourceWordCount = 4;
@@ -4695,7 +4831,7 @@ void Builder::dumpSourceInstructions(const spv::Id fileId, const std::string& te
 }
 
 // Dump an OpSource[Continued] sequence for the source and every include file
-void Builder::dumpSourceInstructions(std::vector<unsigned int>& out) const
+void Builder::dumpSourceInstructions(SpvSink& out) const
 {
     if (emitNonSemanticShaderDebugInfo) return;
     dumpSourceInstructions(mainFileId, sourceText, out);
@@ -4703,14 +4839,14 @@ void Builder::dumpSourceInstructions(std::vector<unsigned int>& out) const
         dumpSourceInstructions(iItr->first, *iItr->second, out);
 }
 
-template <class Range> void Builder::dumpInstructions(std::vector<unsigned int>& out, const Range& instructions) const
+template <class Range> void Builder::dumpInstructions(SpvSink& out, const Range& instructions) const
 {
     for (const auto& inst : instructions) {
         inst->dump(out);
     }
 }
 
-void Builder::dumpModuleProcesses(std::vector<unsigned int>& out) const
+void Builder::dumpModuleProcesses(SpvSink& out) const
 {
     for (int i = 0; i < (int)moduleProcesses.size(); ++i) {
         Instruction moduleProcessed(Op::OpModuleProcessed);
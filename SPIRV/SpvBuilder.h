@@ -905,6 +905,8 @@ public:
     void postProcessSamplers();
 
     void dump(std::vector<unsigned int>&) const;
+    // Serialize the module section by section into 'out'.
+    void dump(SpvSink& out) const;
 
     // Add a branch to the target block.
     // If set implicit, the branch instruction shouldn't have debug source location.
@@ -922,21 +924,51 @@ public:
 
     void setUseReplicatedComposites(bool use) { useReplicatedComposites = use; }
 
+    // Lowering function bodies in parallel: builders that all replay the same
+    // module prelude each lower a share of the bodies, and the shares are then
+    // merged, in order, as if the bodies had all been lowered by one builder.
+
+    // Where the module stands at the end of the prelude.
+    struct ModuleMark {
+        Id bound;
+        size_t strings;
+        size_t imports;
+        size_t executionModes;
+        size_t names;
+        size_t constantsTypesGlobals;
+        size_t functions;
+    };
+    ModuleMark markModule() const;
+    // True if since 'mark', 'other' has only added function bodies and the
+    // module-level declarations they use, which is what merging supports.
+    bool canMergeFunctionBodies(const Builder& other, const ModuleMark& mark) const;
+    // Move the bodies of 'functions' from 'other' into this builder, with the
+    // types, constants, globals, names and decorations added along with them,
+    // numbering new ids as lowering them here would have.  'sharedIds' maps
+    // module-level ids the caller tracks by its own key (e.g., the variable of
+    // a symbol) to this builder's id for the same key, or to NoResult if this
+    // builder has none yet.  Returns the map from 'other's ids to this builder's.
+    std::vector<Id> mergeFunctionBodies(Builder& other, const ModuleMark& mark,
+                                        const std::unordered_map<Id, Id>& sharedIds,
+                                        const std::vector<Id>& functions);
+
  protected:
-    Id findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned value);
-    Id findScalarConstant(Op typeClass, Op opcode, Id typeId, unsigned v1, unsigned v2);
-    Id findCompositeConstant(Op typeClass, Op opcode, Id typeId, const std::vector<Id>& comps, size_t numMembers);
-    Id findStructConstant(Id typeId, const std::vector<Id>& comps);
+    static size_t structuralHash(Op opcode, Id typeId, const unsigned int* words, int count);
+    Op constantIndexOpCode(Op opcode, Id typeId) const;
+    void indexConstant(Instruction* constant);
+    Id findConstant(Op opcode, Id typeId, const unsigned int* words, int count);
+    void indexType(Instruction* type, bool reusable = true);
+    Instruction* findType(Op opcode, const unsigned int* words, int count) const;
     Id collapseAccessChain();
     void remapDynamicSwizzle();
     void transferAccessChainSwizzle(bool dynamic);
     void simplifyAccessChainSwizzle();
     void createAndSetNoPredecessorBlock(const char*);
     void createSelectionMerge(Block* mergeBlock, SelectionControlMask control);
-    void dumpSourceInstructions(std::vector<unsigned int>&) const;
-    void dumpSourceInstructions(const spv::Id fileId, const std::string& text, std::vector<unsigned int>&) const;
-    template <class Range> void dumpInstructions(std::vector<unsigned int>& out, const Range& instructions) const;
-    void dumpModuleProcesses(std::vector<unsigned int>&) const;
+    void dumpSourceInstructions(SpvSink&) const;
+    void dumpSourceInstructions(const spv::Id fileId, const std::string& text, SpvSink&) const;
+    template <class Range> void dumpInstructions(SpvSink& out, const Range& instructions) const;
+    void dumpModuleProcesses(SpvSink&) const;
     spv::MemoryAccessMask sanitizeMemoryAccessForStorageClass(spv::MemoryAccessMask memoryAccess, StorageClass sc)
         const;
     struct DecorationInstructionLessThan {
@@ -1005,16 +1037,14 @@ public:
 
     // not output, internally used for quick & dirty canonical (unique) creation
 
-    // map type opcodes to constant inst.
-    std::unordered_map<unsigned int, std::vector<Instruction*>> groupedConstants;
-    // map struct-id to constant instructions
-    std::unordered_map<unsigned int, std::vector<Instruction*>> groupedStructConstants;
+    // map structural hash (see structuralHash()) to constant inst.
+    std::unordered_map<size_t, std::vector<Instruction*>> groupedConstants;
     // map type opcodes to type instructions
     std::unordered_map<unsigned int, std::vector<Instruction*>> groupedTypes;
+    // map structural hash to the type instructions that may be reused
+    std::unordered_map<size_t, std::vector<Instruction*>> hashedTypes;
     // map type opcodes to debug type instructions
     std::unordered_map<unsigned int, std::vector<Instruction*>> groupedDebugTypes;
-    // list of OpConstantNull instructions
-    std::vector<Instruction*> nullConstants;
 
     // Track which types have explicit layouts, to avoid reusing in storage classes without layout.
     // Currently only tracks array types.
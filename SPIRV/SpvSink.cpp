@@ -0,0 +1,70 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "SpvSink.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace spv {
+
+SpvCallbackSink::SpvCallbackSink(Callback callback, size_t chunkWords)
+    : callback(std::move(callback)), chunkWords(std::max<size_t>(chunkWords, 1))
+{
+    buffer.reserve(this->chunkWords);
+}
+
+void SpvCallbackSink::write(const unsigned int* words, size_t count)
+{
+    // Large writes skip the buffer once it has been drained.
+    if (buffer.size() + count > chunkWords) {
+        flush();
+        if (count >= chunkWords) {
+            callback(words, count);
+            return;
+        }
+    }
+    buffer.insert(buffer.end(), words, words + count);
+}
+
+void SpvCallbackSink::flush()
+{
+    if (!buffer.empty()) {
+        callback(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+} // end spv namespace
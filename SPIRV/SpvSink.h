@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef GLSLANG_SPIRV_SPV_SINK_H
+#define GLSLANG_SPIRV_SPV_SINK_H
+
+//
+// Destinations for serialized SPIR-V.
+//
+// spv::Builder::dump() and GlslangToSpv() hand each section of the module to
+// a sink as it is serialized, so a module can go straight to a file without
+// first being collected into one std::vector.
+//
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "glslang/Include/visibility.h"
+
+namespace spv {
+
+class GLSLANG_EXPORT SpvSink {
+public:
+    virtual ~SpvSink() {}
+
+    // Receives the next 'count' words of the module.
+    virtual void write(const unsigned int* words, size_t count) = 0;
+    void write(unsigned int word) { write(&word, 1); }
+};
+
+// Appends to a word vector; the traditional interface.
+class GLSLANG_EXPORT SpvVectorSink : public SpvSink {
+public:
+    explicit SpvVectorSink(std::vector<unsigned int>& out) : out(out) { }
+
+    using SpvSink::write;
+    void write(const unsigned int* words, size_t count) override { out.insert(out.end(), words, words + count); }
+
+private:
+    SpvVectorSink& operator=(const SpvVectorSink&);
+
+    std::vector<unsigned int>& out;
+};
+
+// Passes the words on to a callback, batched into chunks of up to 'chunkWords'
+// words.  A single write larger than that is passed on whole.
+class GLSLANG_EXPORT SpvCallbackSink : public SpvSink {
+public:
+    typedef std::function<void(const unsigned int* words, size_t count)> Callback;
+
+    explicit SpvCallbackSink(Callback callback, size_t chunkWords = 16384);
+    ~SpvCallbackSink() override { flush(); }
+
+    using SpvSink::write;
+    void write(const unsigned int* words, size_t count) override;
+    // Hands any buffered words to the callback.
+    void flush();
+
+private:
+    SpvCallbackSink(const SpvCallbackSink&);
+    SpvCallbackSink& operator=(const SpvCallbackSink&);
+
+    Callback callback;
+    std::vector<unsigned int> buffer;
+    size_t chunkWords;
+};
+
+// Writes the binary form (host byte order, like OutputSpvBin) to a stream.
+class GLSLANG_EXPORT SpvStreamSink : public SpvCallbackSink {
+public:
+    explicit SpvStreamSink(std::ostream& out)
+        : SpvCallbackSink([&out](const unsigned int* words, size_t count) {
+              out.write(reinterpret_cast<const char*>(words), std::streamsize(count * sizeof(unsigned int)));
+          })
+    { }
+};
+
+} // end spv namespace
+
+#endif // GLSLANG_SPIRV_SPV_SINK_H
@@ -48,6 +48,7 @@
 #define spvIR_H
 
 #include "spirv.hpp11"
+#include "SpvSink.h"
 
 #include <algorithm>
 #include <cassert>
@@ -56,6 +57,7 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <unordered_map>
 #include <optional>
 
 namespace spv {
@@ -98,30 +100,41 @@ struct IdImmediate {
 
 class Instruction {
 public:
-    Instruction(Id resultId, Id typeId, Op opCode) : resultId(resultId), typeId(typeId), opCode(opCode), block(nullptr) { }
-    explicit Instruction(Op opCode) : resultId(NoResult), typeId(NoType), opCode(opCode), block(nullptr) { }
-    virtual ~Instruction() {}
+    Instruction(Id resultId, Id typeId, Op opCode) : resultId(resultId), typeId(typeId), opCode(opCode), block(nullptr),
+        operands(inlineWords), numOperands(0), capacity(InlineOperandCount)
+    {
+        inlineWords[InlineOperandCount] = 0;
+    }
+    explicit Instruction(Op opCode) : Instruction(NoResult, NoType, opCode) { }
+    ~Instruction()
+    {
+        if (operands != inlineWords)
+            delete [] operands;
+    }
     void reserveOperands(size_t count) {
-        operands.reserve(count);
-        idOperand.reserve(count);
+        if (count > capacity)
+            grow((unsigned)count);
     }
     void addIdOperand(Id id) {
         // ids can't be 0
         assert(id);
-        operands.push_back(id);
-        idOperand.push_back(true);
+        if (numOperands == capacity)
+            grow(2 * capacity);
+        idBits()[numOperands / 32] |= 1u << (numOperands % 32);
+        operands[numOperands++] = id;
     }
     // This method is potentially dangerous as it can break assumptions
     // about SSA and lack of forward references.
     void setIdOperand(unsigned idx, Id id) {
         assert(id);
-        assert(idOperand[idx]);
+        assert(isIdOperand(idx));
         operands[idx] = id;
     }
 
     void addImmediateOperand(unsigned int immediate) {
-        operands.push_back(immediate);
-        idOperand.push_back(false);
+        if (numOperands == capacity)
+            grow(2 * capacity);
+        operands[numOperands++] = immediate;
     }
 
     void addImmediateOperand(spv::StorageClass immediate) {
@@ -185,7 +198,7 @@ public:
     }
 
     void setImmediateOperand(unsigned idx, unsigned int immediate) {
-        assert(!idOperand[idx]);
+        assert(!isIdOperand(idx));
         operands[idx] = immediate;
     }
 
@@ -211,47 +224,68 @@ public:
             addImmediateOperand(word);
         }
     }
-    bool isIdOperand(int op) const { return idOperand[op]; }
+    bool isIdOperand(int op) const { return (idBits()[op / 32] >> (op % 32)) & 1; }
     void setBlock(Block* b) { block = b; }
     Block* getBlock() const { return block; }
     Op getOpCode() const { return opCode; }
-    int getNumOperands() const
-    {
-        assert(operands.size() == idOperand.size());
-        return (int)operands.size();
-    }
+    int getNumOperands() const { return (int)numOperands; }
     Id getResultId() const { return resultId; }
     Id getTypeId() const { return typeId; }
     Id getIdOperand(int op) const {
-        assert(idOperand[op]);
+        assert(isIdOperand(op));
         return operands[op];
     }
     unsigned int getImmediateOperand(int op) const {
-        assert(!idOperand[op]);
+        assert(!isIdOperand(op));
         return operands[op];
     }
 
-    // Write out the binary form.
-    void dump(std::vector<unsigned int>& out) const
+    // Number of words the binary form takes.
+    unsigned int getWordCount() const
     {
-        // Compute the wordCount
         unsigned int wordCount = 1;
         if (typeId)
             ++wordCount;
         if (resultId)
             ++wordCount;
-        wordCount += (unsigned int)operands.size();
+        return wordCount + numOperands;
+    }
 
+    // Write out the binary form.
+    void dump(SpvSink& out) const
+    {
         // Write out the beginning of the instruction
-        out.push_back(((wordCount) << WordCountShift) | (unsigned)opCode);
+        unsigned int header[3];
+        unsigned int headerWords = 0;
+        header[headerWords++] = (getWordCount() << WordCountShift) | (unsigned)opCode;
         if (typeId)
-            out.push_back(typeId);
+            header[headerWords++] = typeId;
         if (resultId)
-            out.push_back(resultId);
+            header[headerWords++] = resultId;
+        out.write(header, headerWords);
 
         // Write out the operands
-        for (int op = 0; op < (int)operands.size(); ++op)
-            out.push_back(operands[op]);
+        if (numOperands > 0)
+            out.write(operands, numOperands);
+    }
+    void dump(std::vector<unsigned int>& out) const
+    {
+        SpvVectorSink sink(out);
+        dump(sink);
+    }
+
+    // Renumber the result, type and <id> operands through 'idMap', for moving
+    // this instruction into another module.
+    void remapIds(const std::vector<Id>& idMap)
+    {
+        if (resultId)
+            resultId = idMap[resultId];
+        if (typeId)
+            typeId = idMap[typeId];
+        for (unsigned int op = 0; op < numOperands; ++op) {
+            if (isIdOperand(op))
+                operands[op] = idMap[operands[op]];
+        }
     }
 
     const char *getNameString() const {
@@ -265,12 +299,38 @@ public:
 
 protected:
     Instruction(const Instruction&);
+    Instruction& operator=(const Instruction&);
+
+    // Operands live in one buffer: 'capacity' words, followed by one bit per
+    // operand (set for <id>, clear for immediates).  Most instructions fit the
+    // inline buffer, so they cost a single allocation for the Instruction itself.
+    static const unsigned int InlineOperandCount = 7;
+
+    static unsigned int idBitWords(unsigned int count) { return (count + 31) / 32; }
+    unsigned int* idBits() { return operands + capacity; }
+    const unsigned int* idBits() const { return operands + capacity; }
+
+    void grow(unsigned int newCapacity)
+    {
+        unsigned int* words = new unsigned int[newCapacity + idBitWords(newCapacity)];
+        std::copy(operands, operands + numOperands, words);
+        unsigned int* bits = words + newCapacity;
+        std::fill(std::copy(idBits(), idBits() + idBitWords(numOperands), bits),
+                  bits + idBitWords(newCapacity), 0u);
+        if (operands != inlineWords)
+            delete [] operands;
+        operands = words;
+        capacity = newCapacity;
+    }
+
     Id resultId;
     Id typeId;
     Op opCode;
-    std::vector<Id> operands;     // operands, both <id> and immediates (both are unsigned int)
-    std::vector<bool> idOperand;  // true for operands that are <id>, false for immediates
     Block* block;
+    unsigned int* operands;       // operands, both <id> and immediates (both are unsigned int)
+    unsigned int numOperands;
+    unsigned int capacity;
+    unsigned int inlineWords[InlineOperandCount + 1]; // InlineOperandCount operands, then their id bits
 };
 
 //
@@ -386,7 +446,7 @@ public:
         }
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    void dump(SpvSink& out) const
     {
         instructions[0]->dump(out);
         for (int i = 0; i < (int)localVariables.size(); ++i)
@@ -466,6 +526,11 @@ public:
         delete block;
     }
 
+    // Replace this function's blocks with those of 'other', an equivalent
+    // function lowered by another builder, whose instructions have already
+    // been renumbered for this module.  'other' is left without blocks.
+    void takeBlocks(Function& other);
+
     Module& getParent() const { return parent; }
     Block* getEntryBlock() const { return blocks.front(); }
     Block* getLastBlock() const { return blocks.back(); }
@@ -505,7 +570,7 @@ public:
             Decoration::RelaxedPrecision : NoPrecision;
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    void dump(SpvSink& out) const
     {
         // OpLine
         if (lineInstruction != nullptr) {
@@ -578,7 +643,7 @@ public:
         return (StorageClass)idToInstruction[typeId]->getImmediateOperand(0);
     }
 
-    void dump(std::vector<unsigned int>& out) const
+    void dump(SpvSink& out) const
     {
         for (int f = 0; f < (int)functions.size(); ++f)
             functions[f]->dump(out);
@@ -636,6 +701,38 @@ __inline void Function::addLocalVariable(std::unique_ptr<Instruction> inst)
     parent.mapInstruction(raw_instruction);
 }
 
+__inline void Function::takeBlocks(Function& other)
+{
+    for (int i = 0; i < (int)blocks.size(); ++i)
+        delete blocks[i];
+    blocks.clear();
+
+    std::unordered_map<const Block*, Block*> moved;
+    for (Block* from : other.blocks) {
+        Block* block = new Block(from->getId(), *this);
+        for (size_t i = 1; i < from->instructions.size(); ++i)
+            block->addInstruction(std::move(from->instructions[i]));
+        for (auto& variable : from->localVariables) {
+            parent.mapInstruction(variable.get());
+            block->localVariables.push_back(std::move(variable));
+        }
+        block->unreachable = from->unreachable;
+        blocks.push_back(block);
+        moved[from] = block;
+    }
+
+    // Copy the CFG edges in their original order, which inReadableOrder() depends on.
+    for (Block* from : other.blocks) {
+        Block* block = moved[from];
+        for (Block* predecessor : from->predecessors)
+            block->predecessors.push_back(moved[predecessor]);
+        for (Block* successor : from->successors)
+            block->successors.push_back(moved[successor]);
+        delete from;
+    }
+    other.blocks.clear();
+}
+
 __inline Block::Block(Id id, Function& parent) : parent(parent), unreachable(false)
 {
     instructions.push_back(std::unique_ptr<Instruction>(new Instruction(id, NoType, Op::OpLabel)));
@@ -38,7 +38,6 @@
 
 #include <vector>
 #include <string>
-#include <fstream>
 #include <algorithm>
 #include <set>
 
@@ -47,7 +46,9 @@
 // Default include class for normal include convention of search backward
 // through the stack of active include paths (for nested includes).
 // Can be overridden to customize.
-class DirStackFileIncluder : public glslang::TShader::Includer {
+// Files are read through the process-wide cache of MappedFileIncluder, so
+// headers included by many compiles are mapped once.
+class DirStackFileIncluder : public glslang::TShader::MappedFileIncluder {
 public:
     DirStackFileIncluder() : externalLocalDirectoryCount(0) { }
 
@@ -77,14 +78,6 @@ public:
         externalLocalDirectoryCount = (int)directoryStack.size();
     }
 
-    virtual void releaseInclude(IncludeResult* result) override
-    {
-        if (result != nullptr) {
-            delete [] static_cast<tUserDataElement*>(result->userData);
-            delete result;
-        }
-    }
-
     virtual std::set<std::string> getIncludedFiles()
     {
         return includedFiles;
@@ -93,7 +86,6 @@ public:
     virtual ~DirStackFileIncluder() override { }
 
 protected:
-    typedef char tUserDataElement;
     std::vector<std::string> directoryStack;
     int externalLocalDirectoryCount;
     std::set<std::string> includedFiles;
@@ -112,11 +104,11 @@ protected:
         for (auto it = directoryStack.rbegin(); it != directoryStack.rend(); ++it) {
             std::string path = *it + '/' + headerName;
             std::replace(path.begin(), path.end(), '\\', '/');
-            std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
-            if (file) {
+            IncludeResult* result = readFile(path);
+            if (result != nullptr) {
                 directoryStack.push_back(getDirectory(path));
                 includedFiles.insert(path);
-                return newIncludeResult(path, file, (int)file.tellg());
+                return result;
             }
         }
 
@@ -130,15 +122,6 @@ protected:
         return nullptr;
     }
 
-    // Do actual reading of the file, filling in a new include result.
-    virtual IncludeResult* newIncludeResult(const std::string& path, std::ifstream& file, int length) const
-    {
-        char* content = new tUserDataElement [length];
-        file.seekg(0, file.beg);
-        file.read(content, length);
-        return new IncludeResult(path, content, length, content);
-    }
-
     // If no path markers, return current working directory.
     // Otherwise, strip file name and return path leading up to it.
     virtual std::string getDirectory(const std::string path) const
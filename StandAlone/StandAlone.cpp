@@ -45,22 +45,26 @@
 #include "Worklist.h"
 #include "DirStackFileIncluder.h"
 #include "./../glslang/Public/ShaderLang.h"
+#ifdef GLSLANG_PREBUILT_BUILTINS
+#include "glslang/Public/PrebuiltBuiltIns.h"
+#endif
 #include "../glslang/MachineIndependent/localintermediate.h"
 #include "../SPIRV/GlslangToSpv.h"
 #include "../SPIRV/GLSL.std.450.h"
 #include "../SPIRV/disassemble.h"
 
-#include <array>
+#include <algorithm>
 #include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <set>
-#include <thread>
 #include <type_traits>
 
 #include "../glslang/OSDependent/osinclude.h"
@@ -122,6 +126,9 @@ bool stripDebugInfo = false;
 bool emitNonSemanticShaderDebugInfo = false;
 bool emitNonSemanticShaderDebugSource = false;
 bool beQuiet = false;
+bool ReportTiming = false;
+bool ReportMemoryStats = false;
+unsigned int NumJobs = 0;  // 0: not given on the command line
 bool VulkanRulesRelaxed = false;
 bool autoSampledTextures = false;
 
@@ -176,6 +183,7 @@ int ReflectOptions = EShReflectionDefault;
 std::underlying_type_t<TOptions> Options = EOptionNone;
 const char* ExecutableName = nullptr;
 const char* binaryFileName = nullptr;
+const char* builtinCacheDirectory = nullptr;
 const char* depencyFileName = nullptr;
 const char* entryPointName = nullptr;
 const char* sourceEntryPointName = nullptr;
@@ -289,7 +297,6 @@ protected:
 
 // Track the user's #define and #undef from the command line.
 TPreamble UserPreamble;
-std::string PreambleString;
 
 //
 // Create the default name for saving a binary if -o is not provided.
@@ -637,6 +644,11 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         lowerword == "auto-map-binding"  ||
                         lowerword == "amb") {
                         Options |= EOptionAutoMapBindings;
+                    } else if (lowerword == "builtin-cache") {
+                        if (argc <= 1)
+                            Error("no <dir> provided", lowerword.c_str());
+                        builtinCacheDirectory = argv[1];
+                        bumpArg();
                     } else if (lowerword == "auto-map-locations" || // synonyms
                                lowerword == "aml") {
                         Options |= EOptionAutoMapLocations;
@@ -741,6 +753,8 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                     } else if (lowerword == "keep-uncalled" || // synonyms
                                lowerword == "ku") {
                         Options |= EOptionKeepUncalled;
+                    } else if (lowerword == "memory-stats") {
+                        ReportMemoryStats = true;
                     } else if (lowerword == "nan-clamp") {
                         NaNClamp = true;
                     } else if (lowerword == "no-storage-format" || // synonyms
@@ -831,6 +845,8 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
                         shaderStageName = argv[1];
                     } else if (lowerword == "suppress-warnings") {
                         Options |= EOptionSuppressWarnings;
+                    } else if (lowerword == "timing") {
+                        ReportTiming = true;
                     } else if (lowerword == "target-env") {
                         if (argc > 1) {
                             if (strcmp(argv[1], "vulkan1.0") == 0) {
@@ -1032,6 +1048,22 @@ void ProcessArguments(std::vector<std::unique_ptr<glslang::TWorkItem>>& workItem
             case 'i':
                 Options |= EOptionIntermediate;
                 break;
+            case 'j':
+                {
+                    const char* jobs = argv[0][2] != 0 ? &argv[0][2] : nullptr;
+                    if (jobs == nullptr) {
+                        if (argc <= 1)
+                            Error("no <N> provided for -j");
+                        jobs = argv[1];
+                        bumpArg();
+                    }
+                    char* end = nullptr;
+                    const long count = ::strtol(jobs, &end, 10);
+                    if (end == jobs || *end != 0 || count < 0)
+                        Error("-j expects a non-negative number of jobs");
+                    NumJobs = count > 0 ? (unsigned int)count : glslang::TWorkStealingScheduler::hardwareWorkers();
+                }
+                break;
             case 'l':
                 Options |= EOptionLinkProgram;
                 break;
@@ -1196,44 +1228,66 @@ void SetMessageOptions(EShMessages& messages)
         messages = (EShMessages)(messages | EShMsgValidateCrossStageIO);
 }
 
-//
-// Thread entry point, for non-linking asynchronous mode.
-//
-void CompileShaders(glslang::TWorklist& worklist)
+// Milliseconds elapsed since start, for --timing.
+double ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
 {
-    if (Options & EOptionDebug)
-        Error("cannot generate debug information unless linking to generate code");
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
-    // NOTE: TWorkList::remove is thread-safe
-    glslang::TWorkItem* workItem;
-    if (Options & EOptionStdin) {
-        if (worklist.remove(workItem)) {
-            ShHandle compiler = ShConstructCompiler(FindLanguage("stdin"), 0);
-            if (compiler == nullptr)
-                return;
+// One line of --memory-stats output.
+void PrintMemoryStats(const char* name, const glslang::TMemoryStats& stats)
+{
+    printf("memory: %s: %zu bytes in %zu allocations (%zu in the innermost scope), %zu pages allocated, "
+           "%zu reused, %zu large allocations, %zu bytes reserved, %zu at most\n",
+           name, stats.bytesRequested, stats.allocations, stats.scopeBytesRequested, stats.pagesAllocated,
+           stats.pagesReused, stats.largeAllocations, stats.bytesReserved, stats.highWaterMark);
+}
 
-            CompileFile("stdin", compiler);
+//
+// Compiles one work item, for non-linking asynchronous mode; called concurrently
+// from the scheduler's workers.
+//
+void CompileShader(glslang::TWorkItem& workItem)
+{
+    const char* name = (Options & EOptionStdin) ? "stdin" : workItem.name.c_str();
+    ShHandle compiler = ShConstructCompiler(FindLanguage(name), 0);
+    if (compiler == nullptr)
+        return;
 
-            if (! (Options & EOptionSuppressInfolog))
-                workItem->results = ShGetInfoLog(compiler);
+    CompileFile(name, compiler);
 
-            ShDestruct(compiler);
-        }
-    } else {
-        while (worklist.remove(workItem)) {
-            ShHandle compiler = ShConstructCompiler(FindLanguage(workItem->name), 0);
-            if (compiler == nullptr)
-                return;
+    if (! (Options & EOptionSuppressInfolog))
+        workItem.results = ShGetInfoLog(compiler);
 
+    ShDestruct(compiler);
+}
 
-            CompileFile(workItem->name.c_str(), compiler);
+//
+// Non-linking mode: compiles the work items on 'jobs' workers, returning
+// the time spent on each.
+//
+std::vector<double> CompileShaders(glslang::TWorklist& worklist, unsigned int jobs)
+{
+    if (Options & EOptionDebug)
+        Error("cannot generate debug information unless linking to generate code");
 
-            if (! (Options & EOptionSuppressInfolog))
-                workItem->results = ShGetInfoLog(compiler);
+    std::vector<glslang::TWorkItem*> items;
+    glslang::TWorkItem* workItem;
+    while (worklist.remove(workItem))
+        items.push_back(workItem);
+
+    // stdin is a single shader
+    if ((Options & EOptionStdin) && items.size() > 1)
+        items.resize(1);
+
+    std::vector<double> times(items.size());
+    glslang::TWorkStealingScheduler(jobs).run(items.size(), [&items, &times](size_t i) {
+        const auto start = std::chrono::steady_clock::now();
+        CompileShader(*items[i]);
+        times[i] = ElapsedMilliseconds(start);
+    });
 
-            ShDestruct(compiler);
-        }
-    }
+    return times;
 }
 
 // Outputs the given string, but only if it is non-null and non-empty.
@@ -1333,6 +1387,9 @@ bool writeDepFile(std::string depfile, std::vector<std::string>& binaryFiles, co
 //
 // Uses the new C++ interface instead of the old handle-based interface.
 //
+// With -j, the compilation units are parsed, and the stages turned into SPIR-V,
+// on parallel workers; everything is still reported in command-line order.
+//
 
 void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
 {
@@ -1342,11 +1399,13 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
     EShMessages messages = EShMsgDefault;
     SetMessageOptions(messages);
 
-    DirStackFileIncluder includer;
-    std::for_each(IncludeDirectoryList.rbegin(), IncludeDirectoryList.rend(), [&includer](const std::string& dir) {
-        includer.pushExternalLocalDirectory(dir); });
+    // one includer and preamble per unit, as units may be parsed concurrently
+    std::vector<std::unique_ptr<DirStackFileIncluder>> includers;
+    std::vector<std::string> preambles(compUnits.size());
 
     std::vector<std::string> sources;
+    std::vector<glslang::TShader*> parsed;
+    glslang::TWorkStealingScheduler scheduler(NumJobs);
 
     //
     // Per-shader processing...
@@ -1359,6 +1418,11 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
         for (int i = 0; i < compUnit.count; i++) {
             sources.push_back(compUnit.fileNameList[i]);
         }
+        includers.emplace_back(new DirStackFileIncluder);
+        DirStackFileIncluder& includer = *includers.back();
+        std::for_each(IncludeDirectoryList.rbegin(), IncludeDirectoryList.rend(), [&includer](const std::string& dir) {
+            includer.pushExternalLocalDirectory(dir); });
+
         glslang::TShader* shader = new glslang::TShader(compUnit.stage);
         shader->setStringsWithLengthsAndNames(compUnit.text, nullptr, compUnit.fileNameList, compUnit.count);
         if (entryPointName)
@@ -1377,14 +1441,14 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
 
         std::string intrinsicString = getIntrinsic(compUnit.text, compUnit.count);
 
-        PreambleString = "";
+        std::string& preamble = preambles[it - compUnits.cbegin()];
         if (UserPreamble.isSet())
-            PreambleString.append(UserPreamble.get());
+            preamble.append(UserPreamble.get());
 
         if (!intrinsicString.empty())
-            PreambleString.append(intrinsicString);
+            preamble.append(intrinsicString);
 
-        shader->setPreamble(PreambleString.c_str());
+        shader->setPreamble(preamble.c_str());
         shader->addProcesses(Processes);
 
         // Set IO mapper binding shift values
@@ -1489,18 +1553,28 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
             continue;
         }
 
-        if (! shader->parse(GetResources(), defaultVersion, false, messages, includer))
-            CompileFailed = 1;
-
         if (!compileOnly)
             program.addShader(shader);
 
+        parsed.push_back(shader);
+    }
+
+    std::vector<double> parseTimes(parsed.size());
+    scheduler.run(parsed.size(), [&](size_t s) {
+        const auto start = std::chrono::steady_clock::now();
+        const int defaultVersion = Options & EOptionDefaultDesktop ? 110 : 100;
+        if (! parsed[s]->parse(GetResources(), defaultVersion, false, messages, *includers[s]))
+            CompileFailed = 1;
+        parseTimes[s] = ElapsedMilliseconds(start);
+    });
+
+    for (size_t s = 0; s < parsed.size(); ++s) {
         if (! (Options & EOptionSuppressInfolog) &&
             ! (Options & EOptionMemoryLeakMode)) {
             if (!beQuiet)
-                PutsIfNonEmpty(compUnit.fileName[0].c_str());
-            PutsIfNonEmpty(shader->getInfoLog());
-            PutsIfNonEmpty(shader->getInfoDebugLog());
+                PutsIfNonEmpty(compUnits[s].fileName[0].c_str());
+            PutsIfNonEmpty(parsed[s]->getInfoLog());
+            PutsIfNonEmpty(parsed[s]->getInfoDebugLog());
         }
     }
 
@@ -1508,8 +1582,10 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
     // Program-level processing...
     //
 
+    double linkTime = 0;
     if (!compileOnly) {
         // Link
+        const auto start = std::chrono::steady_clock::now();
         if (!(Options & EOptionOutputPreprocessed) && !program.link(messages))
             LinkFailed = true;
 
@@ -1518,6 +1594,7 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
             if (!program.mapIO())
                 LinkFailed = true;
         }
+        linkTime = ElapsedMilliseconds(start);
 
         // Report
         if (!(Options & EOptionSuppressInfolog) && !(Options & EOptionMemoryLeakMode)) {
@@ -1533,6 +1610,7 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
     }
 
     std::vector<std::string> outputFiles;
+    std::vector<std::pair<EShLanguage, double>> spirvTimes;
 
     // Dump SPIR-V
     if (Options & EOptionSpv) {
@@ -1556,9 +1634,24 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
                     }
                 }
             }
-            for (auto* intermediate : intermediates) {
-                std::vector<unsigned int> spirv;
-                spv::SpvBuildLogger logger;
+            // Generate the stages in parallel, then report them in order. The
+            // SPIRV-Tools disassembler writes straight to stdout, so it keeps the
+            // stages serial.
+            std::vector<std::vector<unsigned int>> spirvs(intermediates.size());
+            std::vector<spv::SpvBuildLogger> loggers(intermediates.size());
+            spirvTimes.resize(intermediates.size());
+
+            // Plain binary output is streamed into its file as it is generated,
+            // unless two stages share a file name or the words are needed again
+            // for -H.
+            std::vector<const char*> filenames;
+            for (const auto* intermediate : intermediates)
+                filenames.push_back(GetBinaryName(intermediate->getStage()));
+            std::vector<char> streamed(intermediates.size(), false);
+            const bool streamBinary = !(Options & (EOptionMemoryLeakMode | EOptionOutputHexadecimal)) &&
+                                      (SpvToolsDisassembler || !(Options & EOptionHumanReadableSpv));
+            auto generate = [&](size_t s) {
+                const auto start = std::chrono::steady_clock::now();
                 glslang::SpvOptions spvOptions;
                 if (Options & EOptionDebug) {
                     spvOptions.generateDebugInfo = true;
@@ -1575,17 +1668,38 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
                 spvOptions.disassemble = SpvToolsDisassembler;
                 spvOptions.validate = SpvToolsValidate;
                 spvOptions.compileOnly = compileOnly;
-                glslang::GlslangToSpv(*intermediate, spirv, &logger, &spvOptions);
+                const bool unique = std::count_if(filenames.begin(), filenames.end(), [&](const char* name) {
+                                        return strcmp(name, filenames[s]) == 0;
+                                    }) == 1;
+                std::ofstream file;
+                if (streamBinary && unique)
+                    file.open(filenames[s], std::ios::binary | std::ios::out);
+                if (file.is_open()) {
+                    spv::SpvStreamSink sink(file);
+                    glslang::GlslangToSpv(*intermediates[s], sink, &loggers[s], &spvOptions);
+                    streamed[s] = true;
+                } else
+                    glslang::GlslangToSpv(*intermediates[s], spirvs[s], &loggers[s], &spvOptions);
+                spirvTimes[s] = {intermediates[s]->getStage(), ElapsedMilliseconds(start)};
+            };
+            if (SpvToolsDisassembler)
+                glslang::TWorkStealingScheduler(1).run(intermediates.size(), generate);
+            else
+                scheduler.run(intermediates.size(), generate);
+
+            for (size_t s = 0; s < intermediates.size(); ++s) {
+                const auto& spirv = spirvs[s];
+                const auto& logger = loggers[s];
 
                 // Dump the spv to a file or stdout, etc., but only if not doing
                 // memory/perf testing, as it's not internal to programmatic use.
                 if (!(Options & EOptionMemoryLeakMode)) {
                     printf("%s", logger.getAllMessages().c_str());
-                    const auto filename = GetBinaryName(intermediate->getStage());
+                    const auto filename = filenames[s];
                     if (Options & EOptionOutputHexadecimal) {
                         if (!glslang::OutputSpvHex(spirv, filename, variableName))
                             exit(EFailUsage);
-                    } else {
+                    } else if (!streamed[s]) {
                         if (!glslang::OutputSpvBin(spirv, filename))
                             exit(EFailUsage);
                     }
@@ -1604,12 +1718,35 @@ void CompileAndLinkShaderUnits(std::vector<ShaderCompUnit> compUnits)
     CompileOrLinkFailed.fetch_or(CompileFailed);
     CompileOrLinkFailed.fetch_or(LinkFailed);
     if (depencyFileName && !static_cast<bool>(CompileOrLinkFailed.load())) {
-        std::set<std::string> includedFiles = includer.getIncludedFiles();
+        std::set<std::string> includedFiles;
+        for (const auto& includer : includers) {
+            const auto files = includer->getIncludedFiles();
+            includedFiles.insert(files.begin(), files.end());
+        }
         sources.insert(sources.end(), includedFiles.begin(), includedFiles.end());
 
         writeDepFile(depencyFileName, outputFiles, sources);
     }
 
+    if (ReportTiming) {
+        for (size_t s = 0; s < parsed.size(); ++s) {
+            printf("timing: %s: %.3f ms\n", compUnits[s].fileName[0].c_str(), parseTimes[s]);
+            printf("timing: %s built-ins: %.3f ms\n", compUnits[s].fileName[0].c_str(),
+                   parsed[s]->getParseTimes().builtIns);
+        }
+        if (!compileOnly && !parsed.empty())
+            printf("timing: link: %.3f ms\n", linkTime);
+        for (const auto& stageTime : spirvTimes)
+            printf("timing: SPIR-V %s: %.3f ms\n", glslang::StageName(stageTime.first), stageTime.second);
+    }
+
+    if (ReportMemoryStats) {
+        for (size_t s = 0; s < parsed.size(); ++s)
+            PrintMemoryStats(compUnits[s].fileName[0].c_str(), parsed[s]->getMemoryStats());
+        if (!compileOnly && !parsed.empty())
+            PrintMemoryStats("link", program.getArena().getStats());
+    }
+
     // Free everything up, program has to go before the shaders
     // because it might have merged stuff from the shaders, and
     // the stuff from the shaders has to have its destructors called
@@ -1743,6 +1880,12 @@ int singleMain()
     if ((Options & EOptionReadHlsl) && !((Options & EOptionOutputPreprocessed) || (Options & EOptionSpv)))
         Error("HLSL requires SPIR-V code generation (or preprocessing only)");
 
+#ifdef GLSLANG_PREBUILT_BUILTINS
+    glslang::AddPrebuiltBuiltInSymbolTables();
+#endif
+    if (builtinCacheDirectory != nullptr)
+        glslang::SetBuiltInSymbolTableCacheDirectory(builtinCacheDirectory);
+
     //
     // Two modes:
     // 1) linking all arguments together, single-threaded, new C++ interface
@@ -1763,19 +1906,11 @@ int singleMain()
 
         bool printShaderNames = workList.size() > 1;
 
-        if (Options & EOptionMultiThreaded) {
-            std::array<std::thread, 16> threads;
-            for (unsigned int t = 0; t < threads.size(); ++t) {
-                threads[t] = std::thread(CompileShaders, std::ref(workList));
-                if (threads[t].get_id() == std::thread::id()) {
-                    fprintf(stderr, "Failed to create thread\n");
-                    return EFailThreadCreate;
-                }
-            }
+        unsigned int jobs = NumJobs;
+        if ((Options & EOptionMultiThreaded) && jobs == 0)
+            jobs = 16;
 
-            std::for_each(threads.begin(), threads.end(), [](std::thread& t) { t.join(); });
-        } else
-            CompileShaders(workList);
+        std::vector<double> times = CompileShaders(workList, jobs);
 
         // Print out all the resulting infologs
         for (size_t w = 0; w < WorkItems.size(); ++w) {
@@ -1786,6 +1921,11 @@ int singleMain()
             }
         }
 
+        if (ReportTiming) {
+            for (size_t w = 0; w < times.size(); ++w)
+                printf("timing: %s: %.3f ms\n", WorkItems[w]->name.c_str(), times[w]);
+        }
+
         ShFinalize();
     }
 
@@ -2026,6 +2166,8 @@ void usage()
            "  -gVS        generate nonsemantic shader debug information with source\n"
            "  -h          print this usage message\n"
            "  -i          intermediate tree (glslang AST) is printed out\n"
+           "  -j <N>      compile up to <N> files, or stages when linking, in parallel;\n"
+           "              0 uses one job per hardware thread; output order is unchanged\n"
            "  -l          link all input files together to form a single module\n"
            "  -m          memory leak mode\n"
            "  -o <file>   save binary to <file>, requires a binary option (e.g., -V)\n"
@@ -2033,7 +2175,7 @@ void usage()
            "  -r | --relaxed-errors\n"
            "              relaxed GLSL semantic error-checking mode\n"
            "  -s          silence syntax and semantic error reporting\n"
-           "  -t          multi-threaded mode\n"
+           "  -t          multi-threaded mode; like -j 16 when not linking\n"
            "  -v | --version\n"
            "              print version strings\n"
            "  -w | --suppress-warnings\n"
@@ -2048,6 +2190,8 @@ void usage()
            "  --absolute-path                   Prints absolute path for messages\n"
            "  --auto-sampled-textures           Removes sampler variables and converts\n"
            "                                    existing textures to sampled textures\n"
+           "  --builtin-cache <dir>             load built-in symbol tables from snapshots\n"
+           "                                    in <dir>, saving new ones there\n"
            "  --client {vulkan<ver>|opengl<ver>} see -V and -G\n"
            "  --depfile <file>                  writes depfile for build systems\n"
            "  --dump-builtin-symbols            prints builtin symbol table prior each compile\n"
@@ -2072,6 +2216,9 @@ void usage()
            "  --enhanced-msgs                   print more readable error messages (GLSL only)\n"
            "  --error-column                    display the column of the error along the line\n"
            "  --keep-uncalled | --ku            don't eliminate uncalled functions\n"
+           "  --memory-stats                    print the memory each file's parse and\n"
+           "                                    the link allocated (requires -l or\n"
+           "                                    SPIR-V output)\n"
            "  --nan-clamp                       favor non-NaN operand in min, max, and clamp\n"
            "  --no-storage-format | --nsf       use Unknown image format\n"
            "  --quiet                           do not print anything to stdout, unless\n"
@@ -2158,6 +2305,9 @@ void usage()
            "                                     * spirv1.5  under --target-env vulkan1.2\n"
            "                                     * spirv1.6  under --target-env vulkan1.3\n"
            "                                    Multiple --target-env can be specified.\n"
+           "  --timing                          print the time spent on each file and\n"
+           "                                    its built-ins, on linking and on each\n"
+           "                                    stage's SPIR-V\n"
            "  --variable-name <name>\n"
            "  --vn <name>                       creates a C header file that contains a\n"
            "                                    uint32_t array named <name>\n"
@@ -35,9 +35,13 @@
 #ifndef WORKLIST_H_INCLUDED
 #define WORKLIST_H_INCLUDED
 
+#include <deque>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace glslang {
 
@@ -89,6 +93,81 @@ namespace glslang {
         std::list<TWorkItem*> worklist;
     };
 
+    //
+    // Runs a fixed set of independent tasks on a number of workers.  Each worker
+    // owns a queue, seeded round-robin, which it drains from the front; a worker
+    // whose queue is empty steals from the back of the others.  Tasks are named
+    // by index, so callers can keep their results in submission order.
+    //
+    class TWorkStealingScheduler {
+    public:
+        explicit TWorkStealingScheduler(unsigned int workers) : queues(workers > 0 ? workers : 1) { }
+
+        // The number of hardware threads, or 1 if it cannot be determined.
+        static unsigned int hardwareWorkers()
+        {
+            unsigned int count = std::thread::hardware_concurrency();
+            return count > 0 ? count : 1;
+        }
+
+        unsigned int workers() const { return (unsigned int)queues.size(); }
+
+        // Runs task(0) .. task(count - 1), the calling thread acting as the first
+        // worker, and returns once all of them are done.  With a single worker the
+        // tasks run in index order on the calling thread.
+        void run(size_t count, const std::function<void(size_t)>& task)
+        {
+            for (size_t i = 0; i < count; ++i)
+                queues[i % queues.size()].items.push_back(i);
+
+            std::vector<std::thread> threads;
+            for (size_t w = 1; w < queues.size() && w < count; ++w)
+                threads.emplace_back([this, w, &task]() { work(w, task); });
+            work(0, task);
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+    protected:
+        struct TQueue {
+            std::mutex mutex;
+            std::deque<size_t> items;
+        };
+
+        bool pop(size_t w, size_t& item)
+        {
+            std::lock_guard<std::mutex> guard(queues[w].mutex);
+            if (queues[w].items.empty())
+                return false;
+            item = queues[w].items.front();
+            queues[w].items.pop_front();
+            return true;
+        }
+
+        bool steal(size_t w, size_t& item)
+        {
+            for (size_t i = 1; i < queues.size(); ++i) {
+                TQueue& victim = queues[(w + i) % queues.size()];
+                std::lock_guard<std::mutex> guard(victim.mutex);
+                if (! victim.items.empty()) {
+                    item = victim.items.back();
+                    victim.items.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void work(size_t w, const std::function<void(size_t)>& task)
+        {
+            size_t item;
+            while (pop(w, item) || steal(w, item))
+                task(item);
+        }
+
+        std::vector<TQueue> queues;
+    };
+
 } // end namespace glslang
 
 #endif // WORKLIST_H_INCLUDED
@@ -69,44 +69,63 @@ namespace {
         return (sepLoc == filename.npos) ? filename : filename.substr(sepLoc+1);
     }
 
+    // Serializes messages from modules being remapped concurrently
+    std::mutex outputMutex;
+
+    // With several inputs, errors are prefixed by the module they came from
+    bool labelErrors = false;
+
+    // The module being processed by this thread, and whether it has failed
+    thread_local const std::string* currentInput = nullptr;
+    thread_local bool currentFailed = false;
+
+    // Report an error in the current module.  The remapper's error latch abandons
+    // the module, and the others carry on.
     void errHandler(const std::string& str) {
+        std::lock_guard<std::mutex> guard(outputMutex);
+        if (labelErrors && currentInput != nullptr)
+            std::cout << *currentInput << ": ";
         std::cout << str << std::endl;
+        currentFailed = true;
+    }
+
+    // Report an error that leaves nothing to process, and exit
+    void fatalError(const std::string& str) {
+        errHandler(str);
         exit(5);
     }
 
     void logHandler(const std::string& str) {
+        std::lock_guard<std::mutex> guard(outputMutex);
         std::cout << str << std::endl;
     }
 
-    // Read word stream from disk
-    void read(std::vector<SpvWord>& spv, const std::string& inFilename, int verbosity)
+    // Read word stream from disk, through a read-only mapping of the file
+    bool read(std::vector<SpvWord>& spv, const std::string& inFilename, int verbosity)
     {
-        std::ifstream fp;
-
         if (verbosity > 0)
             logHandler(std::string("  reading: ") + inFilename);
 
         spv.clear();
-        fp.open(inFilename, std::fstream::in | std::fstream::binary);
 
-        if (fp.fail())
-            errHandler("error opening file for read: ");
+        size_t size = 0;
+        const void* data = glslang::OS_MapFile(inFilename.c_str(), size);
+        if (data == nullptr) {
+            // an empty file cannot be mapped, but is left for the remapper to reject
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(inFilename, ec) && std::filesystem::file_size(inFilename, ec) == 0)
+                return true;
 
-        // Reserve space (for efficiency, not for correctness)
-        fp.seekg(0, fp.end);
-        spv.reserve(size_t(fp.tellg()) / sizeof(SpvWord));
-        fp.seekg(0, fp.beg);
+            errHandler(std::string("error opening file for read: ") + inFilename);
+            return false;
+        }
 
-        while (!fp.eof()) {
-            SpvWord inWord;
-            fp.read((char *)&inWord, sizeof(inWord));
+        // a trailing partial word is dropped
+        spv.resize(size / sizeof(SpvWord));
+        std::memcpy(spv.data(), data, spv.size() * sizeof(SpvWord));
+        glslang::OS_UnmapFile(data, size);
 
-            if (!fp.eof()) {
-                spv.push_back(inWord);
-                if (fp.fail())
-                    errHandler(std::string("error reading file: ") + inFilename);
-            }
-        }
+        return true;
     }
 
     // Read strings from a file
@@ -121,7 +140,7 @@ namespace {
         fp.open(inFilename, std::fstream::in);
 
         if (fp.fail())
-            errHandler("error opening file for read: ");
+            fatalError(std::string("error opening file for read: ") + inFilename);
 
         std::string line;
         while (std::getline(fp, line))
@@ -135,29 +154,80 @@ namespace {
         }
     }
 
-    void write(std::vector<SpvWord>& spv, const std::string& outFile, int verbosity)
+    // Write word stream to disk, through a writable mapping of the file
+    bool write(const std::vector<SpvWord>& spv, const std::string& outFile, int verbosity)
     {
-        if (outFile.empty())
+        if (outFile.empty()) {
             errHandler("missing output filename.");
-
-        std::ofstream fp;
+            return false;
+        }
 
         if (verbosity > 0)
             logHandler(std::string("  writing: ") + outFile);
 
-        fp.open(outFile, std::fstream::out | std::fstream::binary);
+        const size_t size = spv.size() * sizeof(SpvWord);
+        if (size == 0) {
+            // nothing to map; just create the file
+            std::ofstream fp(outFile, std::fstream::out | std::fstream::binary);
+            if (fp.fail()) {
+                errHandler(std::string("error opening file for write: ") + outFile);
+                return false;
+            }
+            return true;
+        }
 
-        if (fp.fail())
+        void* data = glslang::OS_MapFileForWrite(outFile.c_str(), size);
+        if (data == nullptr) {
             errHandler(std::string("error opening file for write: ") + outFile);
+            return false;
+        }
+
+        std::memcpy(data, spv.data(), size);
+        glslang::OS_UnmapFile(data, size);
+
+        return true;
+    }
+
+    // Replace each directory among the inputs by the SPIR-V (*.spv) files it
+    // contains, in name order
+    void expandDirectories(std::vector<std::string>& inputFiles)
+    {
+        std::vector<std::string> expanded;
+
+        for (const auto& input : inputFiles) {
+            std::error_code ec;
+            if (! std::filesystem::is_directory(input, ec)) {
+                expanded.push_back(input);
+                continue;
+            }
+
+            std::vector<std::string> modules;
+            for (const auto& entry : std::filesystem::directory_iterator(input, ec)) {
+                if (entry.is_regular_file(ec) && entry.path().extension() == ".spv")
+                    modules.push_back(entry.path().string());
+            }
+            if (ec)
+                fatalError(std::string("error reading directory: ") + input);
 
-        for (auto it = spv.cbegin(); it != spv.cend(); ++it) {
-            SpvWord word = *it;
-            fp.write((char *)&word, sizeof(word));
-            if (fp.fail())
-                errHandler(std::string("error writing file: ") + outFile);
+            std::sort(modules.begin(), modules.end());
+            expanded.insert(expanded.end(), modules.begin(), modules.end());
         }
 
-        // file is closed by destructor
+        inputFiles.swap(expanded);
+    }
+
+    // Add the modules listed in a manifest, one path per line, to the inputs.
+    // Relative paths are taken relative to the manifest's own directory.
+    void readManifest(std::vector<std::string>& inputFiles, const std::string& manifestFile, int verbosity)
+    {
+        std::vector<std::string> lines;
+        read(lines, manifestFile, verbosity);
+
+        const std::filesystem::path base = std::filesystem::path(manifestFile).parent_path();
+        for (const auto& line : lines) {
+            const std::filesystem::path path(line);
+            inputFiles.push_back(path.is_absolute() ? line : (base / path).string());
+        }
     }
 
     // Print helpful usage message to stdout, and exit
@@ -0,0 +1,25 @@
+#version 450
+
+// Each level refers to the one below it twice, so hashing a level by
+// rehashing its members does work exponential in the depth.
+
+struct S0 { vec4 a; float b[2]; };
+struct S1 { S0 a; S0 b[2]; vec2 c; };
+struct S2 { S1 a; S1 b[2]; vec2 c; };
+struct S3 { S2 a; S2 b[2]; vec2 c; };
+struct S4 { S3 a; S3 b[2]; vec2 c; };
+struct S5 { S4 a; S4 b[2]; vec2 c; };
+struct S6 { S5 a; S5 b[2]; vec2 c; };
+struct S7 { S6 a; S6 b[2]; vec2 c; };
+struct S8 { S7 a; S7 b[2]; vec2 c; };
+struct S9 { S8 a; S8 b[2]; vec2 c; };
+struct S10 { S9 a; S9 b[2]; vec2 c; };
+
+layout(std140, binding = 0) uniform Heap { S10 s; } heap;
+
+layout(location = 0) out vec4 outf4;
+
+void main()
+{
+    outf4 = heap.s.a.b[1].a.a.b[0].a.a.a.b[1].a.a + vec4(heap.s.c, heap.s.b[0].c);
+}
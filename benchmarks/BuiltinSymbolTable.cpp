@@ -0,0 +1,168 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures cold-start construction of the process-wide built-in symbol tables.
+//
+// Each round starts from an uninitialized process, then has N threads compile a
+// trivial shader for every entry of a list of version/profile/client combinations.
+// Each combination forces one built-in table cell to be built, so the round time
+// shows how well cell construction scales with the number of threads.
+//
+// Usage: glslang-bench-builtin-tables [max-threads] [rounds]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+struct Combination {
+    int version;
+    EProfile profile;
+    bool vulkan;
+};
+
+const Combination Combinations[] = {
+    { 110, ENoProfile, false },     { 120, ENoProfile, false },   { 130, ENoProfile, false },
+    { 140, ENoProfile, false },     { 150, ECoreProfile, false }, { 330, ECoreProfile, false },
+    { 400, ECoreProfile, false },   { 410, ECoreProfile, false }, { 420, ECoreProfile, false },
+    { 430, ECoreProfile, false },   { 440, ECoreProfile, false }, { 450, ECoreProfile, false },
+    { 460, ECoreProfile, false },   { 150, ECompatibilityProfile, false },
+    { 450, ECompatibilityProfile, false },
+    { 100, EEsProfile, false },     { 300, EEsProfile, false },   { 310, EEsProfile, false },
+    { 320, EEsProfile, false },     { 450, ECoreProfile, true },  { 460, ECoreProfile, true },
+    { 310, EEsProfile, true },      { 320, EEsProfile, true },
+};
+const int CombinationCount = sizeof(Combinations) / sizeof(Combinations[0]);
+
+bool CompileTrivialShader(const Combination& combination)
+{
+    std::string source = "#version " + std::to_string(combination.version);
+    if (combination.profile == EEsProfile && combination.version > 100)
+        source += " es";
+    else if (combination.profile == ECompatibilityProfile)
+        source += " compatibility";
+    else if (combination.profile == ECoreProfile && combination.version >= 150)
+        source += " core";
+    source += "\nvoid main() { }\n";
+
+    const char* strings[] = { source.c_str() };
+    glslang::TShader shader(EShLangVertex);
+    shader.setStrings(strings, 1);
+    EShMessages messages = EShMsgDefault;
+    if (combination.vulkan) {
+        shader.setEnvInput(glslang::EShSourceGlsl, EShLangVertex, glslang::EShClientVulkan, 100);
+        shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+        messages = static_cast<EShMessages>(messages | EShMsgSpvRules | EShMsgVulkanRules);
+    }
+
+    return shader.parse(GetDefaultResources(), combination.version, false, messages);
+}
+
+// Returns the wall time, in milliseconds, for 'threadCount' threads to build every
+// combination's tables starting from a cold process.
+double RunRound(int threadCount, bool& ok)
+{
+    glslang::InitializeProcess();
+
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&]() {
+        for (int i = next++; i < CombinationCount; i = next++) {
+            if (!CompileTrivialShader(Combinations[i]))
+                failed = true;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    for (auto& thread : threads)
+        thread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    glslang::FinalizeProcess();
+
+    ok = !failed;
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int rounds = 3;
+    if (argc > 1)
+        maxThreads = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        rounds = std::max(1, atoi(argv[2]));
+
+    printf("%d built-in table combinations per round, best of %d rounds\n", CombinationCount, rounds);
+    printf("%8s %12s %14s %10s\n", "threads", "time (ms)", "tables/second", "speedup");
+
+    double serialTime = 0.0;
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+        double best = 0.0;
+        for (int round = 0; round < rounds; ++round) {
+            bool ok = false;
+            double time = RunRound(threadCount, ok);
+            if (!ok) {
+                fprintf(stderr, "compilation failed with %d threads\n", threadCount);
+                return EXIT_FAILURE;
+            }
+            if (round == 0 || time < best)
+                best = time;
+        }
+        if (threadCount == 1)
+            serialTime = best;
+        printf("%8d %12.2f %14.1f %9.2fx\n", threadCount, best, CombinationCount * 1000.0 / best,
+               serialTime / best);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures the link-time call-graph checks on generated compute shaders.
+//
+// Each shader has N helper functions.  The first 7/8 of them form a random DAG
+// reachable from main, with up to 'fanout' calls each; the rest call into the DAG
+// but are never called, so linking drops them as dead bodies.  The link time
+// (recursion check, reachability and dead-body removal) should grow linearly with
+// the number of calls.  A recursive variant of each shader checks that the
+// recursion is still reported.
+//
+// Usage: glslang-bench-call-graph [max-functions] [fanout]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+std::string GenerateShader(int functions, int fanout, bool recursive)
+{
+    const int reachable = functions - functions / 8;
+    std::mt19937 random(12345);
+    std::string source = "#version 450\n"
+                         "layout(local_size_x = 64) in;\n"
+                         "layout(std430, binding = 0) buffer Data { float data[]; };\n";
+
+    // Declare everything first, so calls may go either way in source order.
+    for (int f = 0; f < functions; ++f)
+        source += "float f" + std::to_string(f) + "(float x);\n";
+
+    for (int f = 0; f < functions; ++f) {
+        source += "float f" + std::to_string(f) + "(float x)\n{\n    float r = x;\n";
+        const int first = f < reachable ? f + 1 : 0;
+        if (first < reachable) {
+            std::uniform_int_distribution<int> callee(first, reachable - 1);
+            for (int c = 0; c < fanout; ++c)
+                source += "    r += 0.5 * f" + std::to_string(callee(random)) + "(r);\n";
+        }
+        if (recursive && f == reachable - 1)
+            source += "    r += f0(r);\n";
+        source += "    return r;\n}\n";
+    }
+
+    source += "void main()\n{\n    data[gl_GlobalInvocationID.x] = f0(data[gl_GlobalInvocationID.x]);\n}\n";
+    return source;
+}
+
+struct Timing {
+    double parse;
+    double link;
+    bool linked;
+    bool recursionReported;
+};
+
+Timing CompileAndLink(const std::string& source)
+{
+    Timing timing = {};
+    const char* strings[] = { source.c_str() };
+    glslang::TShader shader(EShLangCompute);
+    shader.setStrings(strings, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!shader.parse(GetDefaultResources(), 450, false, messages)) {
+        fprintf(stderr, "%s\n", shader.getInfoLog());
+        return timing;
+    }
+    auto parsed = std::chrono::steady_clock::now();
+
+    glslang::TProgram program;
+    program.addShader(&shader);
+    timing.linked = program.link(messages);
+    auto linked = std::chrono::steady_clock::now();
+
+    timing.parse = std::chrono::duration<double, std::milli>(parsed - start).count();
+    timing.link = std::chrono::duration<double, std::milli>(linked - parsed).count();
+    timing.recursionReported = std::string(program.getInfoLog()).find("Recursion detected") != std::string::npos;
+    return timing;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int maxFunctions = 4000;
+    int fanout = 4;
+    if (argc > 1)
+        maxFunctions = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        fanout = std::max(1, atoi(argv[2]));
+
+    glslang::InitializeProcess();
+
+    printf("up to %d calls per function\n", fanout);
+    printf("%10s %12s %12s %14s\n", "functions", "parse (ms)", "link (ms)", "link/call (us)");
+    for (int functions = 250; functions <= maxFunctions; functions *= 2) {
+        const Timing acyclic = CompileAndLink(GenerateShader(functions, fanout, false));
+        const Timing cyclic = CompileAndLink(GenerateShader(functions, fanout, true));
+        if (!acyclic.linked || cyclic.linked || !cyclic.recursionReported) {
+            fprintf(stderr, "unexpected link result with %d functions\n", functions);
+            glslang::FinalizeProcess();
+            return EXIT_FAILURE;
+        }
+        printf("%10d %12.2f %12.2f %14.3f\n", functions, acyclic.parse, acyclic.link,
+               acyclic.link * 1000.0 / (functions * fanout));
+    }
+
+    glslang::FinalizeProcess();
+    return EXIT_SUCCESS;
+}
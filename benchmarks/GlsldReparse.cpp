@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures glsld's reparse latency on a large generated compute shader.
+//
+// Each edit inserts one statement into the body of a function, the way typing does,
+// and is reparsed both from scratch and incrementally, where only the edited function
+// is parsed again. After every edit the incremental result is checked against the
+// full parse.
+//
+// Usage: glsld-bench-reparse [functions] [statements-per-function] [edits]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "glsld/doc.hpp"
+
+namespace {
+
+const char* const Uri = "file:///bench/uber.comp";
+
+std::string GenerateShader(int functions, int statements)
+{
+    std::string text = "#version 450\n"
+                       "layout(local_size_x = 64) in;\n"
+                       "struct Sample { vec4 color; float weight; };\n"
+                       "layout(std430, binding = 0) buffer Data { Sample samples[]; };\n"
+                       "layout(binding = 1) uniform Params { float scale; float bias; } params;\n";
+    for (int f = 0; f < functions; ++f) {
+        std::string name = "stage_" + std::to_string(f);
+        text += "\n// " + name + "\n";
+        text += "Sample " + name + "(Sample s, float t)\n{\n";
+        text += "    float acc = s.weight * params.scale;\n";
+        for (int i = 0; i < statements; ++i) {
+            text += "    acc = acc * " + std::to_string(i % 7 + 1) + ".5 + t;\n";
+            if (i % 4 == 3)
+                text += "    s.color.xyz = mix(s.color.xyz, vec3(acc), 0.25);\n";
+        }
+        text += "    s.weight = acc + params.bias;\n    return s;\n}\n";
+    }
+    text += "\nvoid main()\n{\n    uint id = gl_GlobalInvocationID.x;\n    Sample s = samples[id];\n";
+    for (int f = 0; f < functions; ++f)
+        text += "    s = stage_" + std::to_string(f) + "(s, " + std::to_string(f) + ".0);\n";
+    text += "    samples[id] = s;\n}\n";
+    return text;
+}
+
+double Milliseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool SameResult(Doc& incremental, Doc& full)
+{
+    auto& a = incremental.func_defs();
+    auto& b = full.func_defs();
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].start.line != b[i].start.line || a[i].end.line != b[i].end.line ||
+            a[i].local_defs.size() != b[i].local_defs.size() || a[i].local_uses.size() != b[i].local_uses.size())
+            return false;
+        for (size_t u = 0; u < a[i].local_uses.size(); ++u) {
+            auto loc = a[i].local_uses[u]->getLoc();
+            auto expected_loc = b[i].local_uses[u]->getLoc();
+            if (loc.line != expected_loc.line || loc.column != expected_loc.column ||
+                incremental.lookup_nodes_at(loc.line, loc.column).size() !=
+                    full.lookup_nodes_at(loc.line, loc.column).size())
+                return false;
+            // globals are skipped: the parser moves their location to the latest use, which
+            // differs between the reduced and the full source
+            auto is_local = [&](glslang::TIntermSymbol* def) { return def->getId() == b[i].local_uses[u]->getId(); };
+            if (std::none_of(b[i].local_defs.begin(), b[i].local_defs.end(), is_local) &&
+                std::none_of(b[i].args.begin(), b[i].args.end(), is_local))
+                continue;
+            auto expected_def = full.locate_symbol_def(&b[i], b[i].local_uses[u]);
+            auto def = incremental.locate_symbol_def(&a[i], a[i].local_uses[u]);
+            if (def.line != expected_def.line || def.column != expected_def.column)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int functions = 200;
+    int statements = 24;
+    int edits = 20;
+    if (argc > 1)
+        functions = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        statements = std::max(1, atoi(argv[2]));
+    if (argc > 3)
+        edits = std::max(1, atoi(argv[3]));
+
+    const std::vector<std::string> include_dirs = { "/" };
+    Doc doc(Uri, 1, GenerateShader(functions, statements));
+    if (!doc.parse(include_dirs)) {
+        fprintf(stderr, "parse failed:\n%s\n", doc.info_log());
+        return EXIT_FAILURE;
+    }
+    printf("%d functions, %zu lines, %d edits\n", functions, doc.lines().size(), edits);
+
+    double full_total = 0.0, full_worst = 0.0;
+    double incremental_total = 0.0, incremental_worst = 0.0;
+    for (int e = 0; e < edits; ++e) {
+        // insert a statement after the first statement of one function; start is 1-based, LSP lines are not
+        auto& func = doc.func_defs()[(e * 7919) % functions];
+        Doc::TextChange change = { false, func.start.line + 2, 0, func.start.line + 2, 0 };
+        change.text = "    acc += " + std::to_string(e) + ".0;\n";
+        doc.update(e + 2, { change });
+
+        auto start = std::chrono::steady_clock::now();
+        if (!doc.parse(include_dirs)) {
+            fprintf(stderr, "incremental parse failed:\n%s\n", doc.info_log());
+            return EXIT_FAILURE;
+        }
+        double incremental = Milliseconds(start);
+
+        Doc full(Uri, e + 2, doc.text());
+        start = std::chrono::steady_clock::now();
+        if (!full.parse(include_dirs)) {
+            fprintf(stderr, "full parse failed:\n%s\n", full.info_log());
+            return EXIT_FAILURE;
+        }
+        double full_time = Milliseconds(start);
+
+        if (!SameResult(doc, full)) {
+            fprintf(stderr, "edit %d: incremental result differs from a full parse\n", e);
+            return EXIT_FAILURE;
+        }
+
+        full_total += full_time;
+        full_worst = std::max(full_worst, full_time);
+        incremental_total += incremental;
+        incremental_worst = std::max(incremental_worst, incremental);
+    }
+
+    printf("%12s %12s %12s\n", "reparse", "mean (ms)", "worst (ms)");
+    printf("%12s %12.2f %12.2f\n", "full", full_total / edits, full_worst);
+    printf("%12s %12.2f %12.2f\n", "incremental", incremental_total / edits, incremental_worst);
+    printf("speedup %.2fx\n", full_total / incremental_total);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures cold-start HLSL compiles.
+//
+// Each round starts from an uninitialized process and parses a small pixel
+// shader calling a handful of intrinsics, then parses it again a number of
+// times.  The first parse pays for setting up the HLSL built-ins, including
+// the intrinsics it calls; the others show the cost once they are in place.
+//
+// Usage: glslang-bench-hlsl-cold-start [warm-parses] [rounds]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+const char* const Shader =
+    "Texture2D tex : register(t0);\n"
+    "SamplerState samp : register(s0);\n"
+    "float4x4 transform;\n"
+    "float4 main(float4 pos : SV_Position, float2 uv : TEXCOORD0) : SV_Target\n"
+    "{\n"
+    "    float4 color = tex.Sample(samp, uv);\n"
+    "    float shade = saturate(dot(normalize(pos.xyz), float3(0, 0, 1)));\n"
+    "    return lerp(color, mul(transform, color), shade) + abs(sin(pos.x));\n"
+    "}\n";
+
+// Time one parse of the shader, in milliseconds; negative if it fails.
+double Parse()
+{
+    auto start = std::chrono::steady_clock::now();
+    glslang::TShader shader(EShLangFragment);
+    shader.setStrings(&Shader, 1);
+    shader.setEntryPoint("main");
+    shader.setEnvInput(glslang::EShSourceHlsl, EShLangFragment, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgReadHlsl | EShMsgSpvRules | EShMsgVulkanRules);
+    if (! shader.parse(GetDefaultResources(), 100, false, messages)) {
+        fprintf(stderr, "could not parse:\n%s%s\n", Shader, shader.getInfoLog());
+        return -1;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int warmParses = 20;
+    int rounds = 5;
+    if (argc > 1)
+        warmParses = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        rounds = std::max(1, atoi(argv[2]));
+
+    double bestCold = 0;
+    double bestWarm = 0;
+    for (int round = 0; round < rounds; ++round) {
+        glslang::InitializeProcess();
+        const double cold = Parse();
+        double warm = 0;
+        for (int p = 0; p < warmParses && cold >= 0; ++p) {
+            const double ms = Parse();
+            if (ms < 0) {
+                warm = -1;
+                break;
+            }
+            warm += ms;
+        }
+        glslang::FinalizeProcess();
+
+        if (cold < 0 || warm < 0)
+            return EXIT_FAILURE;
+        if (round == 0 || cold < bestCold)
+            bestCold = cold;
+        if (round == 0 || warm < bestWarm)
+            bestWarm = warm;
+    }
+
+    printf("%d rounds of 1 cold and %d warm parses\n", rounds, warmParses);
+    printf("%14s %14s\n", "cold (ms)", "warm (ms)");
+    printf("%14.2f %14.3f\n", bestCold, bestWarm / warmParses);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures reading #include files through DirStackFileIncluder.
+//
+// Writes a directory of headers, then resolves each of them once per compile,
+// with a fresh includer per compile, as a driver compiling many permutations of
+// shaders sharing the same headers does.  Also times parsing a shader including
+// all of the headers, to show the share of the parse spent reading them.
+//
+// Usage: glslang-bench-include-files [headers] [compiles] [directory]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "StandAlone/DirStackFileIncluder.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+std::string HeaderName(int h)
+{
+    return "header" + std::to_string(h) + ".glsl";
+}
+
+// A header of a few hundred lines, mostly comments and small functions.
+std::string HeaderText(int h)
+{
+    std::string text = "// header " + std::to_string(h) + "\n";
+    for (int f = 0; f < 32; ++f) {
+        const std::string name = "h" + std::to_string(h) + "_" + std::to_string(f);
+        text += "// " + name + ": scales and offsets a vector; kept long enough to look like a real library header.\n"
+                "vec4 " + name + "(vec4 v)\n"
+                "{\n"
+                "    return v * " + std::to_string(f) + ".5 + vec4(" + std::to_string(h) + ".0);\n"
+                "}\n";
+    }
+    return text;
+}
+
+bool WriteHeaders(const std::string& directory, int headers)
+{
+    for (int h = 0; h < headers; ++h) {
+        const std::string path = directory + "/" + HeaderName(h);
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            fprintf(stderr, "could not write %s\n", path.c_str());
+            return false;
+        }
+        const std::string text = HeaderText(h);
+        fwrite(text.data(), 1, text.size(), file);
+        fclose(file);
+    }
+    return true;
+}
+
+// Resolve every header once, with a new includer, as one compile would; returns
+// the bytes read, or -1 if a header can't be found.
+long long IncludeAll(const std::string& directory, int headers)
+{
+    DirStackFileIncluder includer;
+    includer.pushExternalLocalDirectory(directory);
+    long long bytes = 0;
+    for (int h = 0; h < headers; ++h) {
+        glslang::TShader::Includer::IncludeResult* result =
+            includer.includeLocal(HeaderName(h).c_str(), "main.comp", 1);
+        if (result == nullptr)
+            return -1;
+        bytes += static_cast<long long>(result->headerLength);
+        includer.releaseInclude(result);
+    }
+    return bytes;
+}
+
+// Time one parse of a compute shader including every header, in milliseconds;
+// negative if it fails.
+double Parse(const std::string& directory, int headers)
+{
+    std::string source = "#version 450\n#extension GL_GOOGLE_include_directive : require\n";
+    for (int h = 0; h < headers; ++h)
+        source += "#include \"" + HeaderName(h) + "\"\n";
+    source += "layout(local_size_x = 1) in;\nvoid main() { }\n";
+    const char* text = source.c_str();
+    const char* name = "main.comp";
+
+    auto start = std::chrono::steady_clock::now();
+    DirStackFileIncluder includer;
+    includer.pushExternalLocalDirectory(directory);
+    glslang::TShader shader(EShLangCompute);
+    shader.setStringsWithLengthsAndNames(&text, nullptr, &name, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    if (! shader.parse(GetDefaultResources(), 100, false, messages, includer)) {
+        fprintf(stderr, "could not parse:\n%s\n", shader.getInfoLog());
+        return -1;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int headers = 64;
+    int compiles = 200;
+    if (argc > 1)
+        headers = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        compiles = std::max(1, atoi(argv[2]));
+
+    std::error_code error;
+    std::string directory;
+    if (argc > 3)
+        directory = argv[3];
+    else
+        directory = (std::filesystem::temp_directory_path(error) / "glslang-bench-include-files").string();
+    std::filesystem::create_directories(directory, error);
+    if (! WriteHeaders(directory, headers))
+        return EXIT_FAILURE;
+
+    glslang::InitializeProcess();
+
+    long long bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < compiles; ++c) {
+        const long long read = IncludeAll(directory, headers);
+        if (read < 0) {
+            fprintf(stderr, "could not include the headers from %s\n", directory.c_str());
+            return EXIT_FAILURE;
+        }
+        bytes += read;
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double includeMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    double parseMs = -1;
+    for (int round = 0; round < 3; ++round) {
+        const double ms = Parse(directory, headers);
+        if (ms < 0)
+            return EXIT_FAILURE;
+        if (parseMs < 0 || ms < parseMs)
+            parseMs = ms;
+    }
+
+    glslang::FinalizeProcess();
+
+    printf("%d compiles of %d headers, %.1f KiB each\n", compiles, headers,
+           bytes / 1024.0 / (static_cast<double>(compiles) * headers));
+    printf("%14s %14s %14s\n", "include (ms)", "MiB/s", "parse (ms)");
+    printf("%14.3f %14.1f %14.2f\n", includeMs / compiles, bytes / (1024.0 * 1024.0) / (includeMs / 1000.0), parseMs);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures linking a stage made of many compilation units.
+//
+// A fragment stage is generated as a number of units, each declaring the same
+// set of shared uniforms, as many uniforms of its own, and a function body per
+// uniform.  Every unit is parsed ahead of time; only TProgram::link() is timed,
+// which for these units is dominated by matching their linker objects and
+// function bodies against everything merged so far.
+//
+// Usage: glslang-bench-link [units] [globals-per-unit] [passes]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+std::string GenerateUnit(int unit, int globals)
+{
+    std::string text = "#version 450\n";
+    for (int g = 0; g < globals; ++g)
+        text += "uniform vec4 shared" + std::to_string(g) + ";\n";
+    for (int g = 0; g < globals; ++g) {
+        const std::string name = std::to_string(unit) + "_" + std::to_string(g);
+        text += "uniform vec4 own" + name + ";\n";
+        text += "vec4 f" + name + "(vec4 v) { return v * own" + name + " + shared" + std::to_string(g) + "; }\n";
+    }
+    if (unit == 0)
+        text += "out vec4 color;\nvoid main() { color = f0_0(shared0); }\n";
+
+    return text;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int units = 32;
+    int globals = 200;
+    int passes = 5;
+    if (argc > 1)
+        units = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        globals = std::max(1, atoi(argv[2]));
+    if (argc > 3)
+        passes = std::max(1, atoi(argv[3]));
+
+    glslang::InitializeProcess();
+
+    std::vector<std::string> sources;
+    for (int unit = 0; unit < units; ++unit)
+        sources.push_back(GenerateUnit(unit, globals));
+
+    double best = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        // Linking changes the units, so each pass starts from freshly parsed ones.
+        std::vector<std::unique_ptr<glslang::TShader>> shaders;
+        glslang::TProgram program;
+        for (const std::string& source : sources) {
+            const char* text = source.c_str();
+            shaders.emplace_back(new glslang::TShader(EShLangFragment));
+            shaders.back()->setStrings(&text, 1);
+            if (! shaders.back()->parse(GetDefaultResources(), 100, false, EShMsgDefault)) {
+                fprintf(stderr, "could not parse:\n%s\n", shaders.back()->getInfoLog());
+                glslang::FinalizeProcess();
+                return EXIT_FAILURE;
+            }
+            program.addShader(shaders.back().get());
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        const bool linked = program.link(EShMsgDefault);
+        auto end = std::chrono::steady_clock::now();
+        if (! linked) {
+            fprintf(stderr, "could not link:\n%s\n", program.getInfoLog());
+            glslang::FinalizeProcess();
+            return EXIT_FAILURE;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = pass == 0 ? ms : std::min(best, ms);
+    }
+
+    printf("%d units, %d shared and %d own globals each\n", units, globals, globals);
+    printf("%14s %14s\n", "best (ms)", "units/s");
+    printf("%14.2f %14.1f\n", best, units * 1000.0 / best);
+
+    glslang::FinalizeProcess();
+    return EXIT_SUCCESS;
+}
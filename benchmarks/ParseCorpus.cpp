@@ -0,0 +1,170 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures front-end parse throughput over the GLSL shaders in Test/.
+//
+// A fixed set of GLSL shaders from the test directory, heavy on built-in
+// functions, is parsed several times from source, each for OpenGL or for
+// Vulkan, whichever it was written for.  Most identifiers in these shaders
+// are built-in variables and functions, so the time is largely that of the
+// lexer, the grammar, and symbol table lookups that fall through to the
+// shared built-in levels.
+//
+// Usage: glslang-bench-parse [test-directory] [passes]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+// Large shaders from Test/ calling many built-ins, so the workload stays fixed as tests are added.
+const char* const Shaders[] = {
+    "spv.nvgpushader5.frag", "spv.subgroupExtendedTypesArithmetic.comp", "spv.subgroupPartitioned.comp",
+    "glsl.es320.subgroupPartitioned.comp", "spv.subgroupArithmetic.comp", "spv.subgroupExtendedTypesPartitioned.comp",
+    "glsl.es320.subgroupArithmetic.comp", "spv.subgroupExtendedTypesClustered.comp", "spv.atomicFloat.comp",
+    "spv.subgroupExtendedTypesQuad.comp", "spv.shaderBallotAMD.comp", "spv.atomicFloat2.comp",
+    "spv.subgroupClustered.comp", "spv.nvAtomicFp16Vec.frag", "spv.subgroupQuad.comp", "loops.frag",
+    "rayQuery-allOps.comp", "spv.loops.frag", "rayQuery-allOps.frag", "spv.subgroupExtendedTypesShuffle.comp",
+    "spv.imageAtomic64.frag", "spv.constConstruct.vert", "spv.debuginfo.glsl.frag", "spv.int_dot.frag",
+    "stringToDouble.vert", "spv.subgroupBallot.comp", "spv.memoryScopeSemantics.comp", "spv.image.frag",
+    "spv.coopmatKHR_constructor.comp", "spv.shaderImageFootprint.frag", "spv.Operations.frag",
+};
+
+bool StageFromExtension(const std::string& extension, EShLanguage& stage)
+{
+    static const struct {
+        const char* extension;
+        EShLanguage stage;
+    } stages[] = {
+        { ".vert", EShLangVertex },       { ".tesc", EShLangTessControl },
+        { ".tese", EShLangTessEvaluation }, { ".geom", EShLangGeometry },
+        { ".frag", EShLangFragment },     { ".comp", EShLangCompute },
+    };
+    for (const auto& s : stages) {
+        if (extension == s.extension) {
+            stage = s.stage;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Source {
+    std::string text;
+    EShLanguage stage;
+    bool vulkan;
+};
+
+bool Parse(const Source& source)
+{
+    const char* strings[] = { source.text.c_str() };
+    glslang::TShader shader(source.stage);
+    shader.setStrings(strings, 1);
+    EShMessages messages = EShMsgDefault;
+    if (source.vulkan) {
+        shader.setEnvInput(glslang::EShSourceGlsl, source.stage, glslang::EShClientVulkan, 100);
+        shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+        messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    }
+
+    return shader.parse(GetDefaultResources(), 100, false, messages);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::string directory = GLSLANG_TEST_DIRECTORY;
+    int passes = 5;
+    if (argc > 1)
+        directory = argv[1];
+    if (argc > 2)
+        passes = std::max(1, atoi(argv[2]));
+
+    glslang::InitializeProcess();
+
+    // Parsing each shader once also builds the built-in tables they use.
+    std::vector<Source> sources;
+    size_t bytes = 0;
+    for (const char* name : Shaders) {
+        const std::filesystem::path path = std::filesystem::path(directory) / name;
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        Source source{ contents.str(), EShLangVertex, false };
+        bool parsed = StageFromExtension(path.extension().string(), source.stage) && Parse(source);
+        if (! parsed) {
+            source.vulkan = true;
+            parsed = Parse(source);
+        }
+        if (! parsed) {
+            fprintf(stderr, "could not parse %s\n", path.string().c_str());
+            glslang::FinalizeProcess();
+            return EXIT_FAILURE;
+        }
+        bytes += source.text.size();
+        sources.push_back(std::move(source));
+    }
+
+    double best = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (const Source& source : sources)
+            Parse(source);
+        auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = pass == 0 ? ms : std::min(best, ms);
+    }
+
+    printf("%zu shaders, %zu bytes\n", sources.size(), bytes);
+    printf("%14s %14s %14s\n", "best (ms)", "shaders/s", "MB/s");
+    printf("%14.2f %14.1f %14.2f\n", best, sources.size() * 1000.0 / best, bytes / 1000.0 / best);
+
+    glslang::FinalizeProcess();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures many small compiles, where setting up the built-ins is a large
+// share of each parse.
+//
+// A handful of tiny shaders, some using built-ins whose declarations depend on
+// the resource limits (gl_in, gl_FragData, gl_MaxDrawBuffers), are parsed over
+// and over under two different sets of limits.  Besides the time for all the
+// compiles, this reports how much of it TShader::getParseTimes() attributes to
+// the built-ins.
+//
+// Usage: glslang-bench-small-compiles [compiles] [passes]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+const struct {
+    EShLanguage stage;
+    const char* text;
+} Shaders[] = {
+    { EShLangVertex, "#version 450\n"
+                     "layout(location = 0) in vec4 position;\n"
+                     "void main() { gl_Position = position * float(gl_MaxDrawBuffers); }\n" },
+    { EShLangTessControl, "#version 450\n"
+                          "layout(vertices = 3) out;\n"
+                          "void main() {\n"
+                          "    gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;\n"
+                          "    gl_TessLevelOuter[0] = 1.0;\n"
+                          "}\n" },
+    { EShLangFragment, "#version 330\n"
+                       "in vec4 color;\n"
+                       "void main() { gl_FragData[0] = color; }\n" },
+    { EShLangCompute, "#version 450\n"
+                      "layout(local_size_x = 64) in;\n"
+                      "layout(std430, binding = 0) buffer Data { float values[]; };\n"
+                      "void main() { values[gl_GlobalInvocationID.x] *= 2.0; }\n" },
+};
+
+const int ShaderCount = sizeof(Shaders) / sizeof(Shaders[0]);
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int compiles = 2000;
+    int passes = 5;
+    if (argc > 1)
+        compiles = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        passes = std::max(1, atoi(argv[2]));
+
+    glslang::InitializeProcess();
+
+    TBuiltInResource resources[2] = { *GetDefaultResources(), *GetDefaultResources() };
+    resources[1].maxDrawBuffers = 8;
+    resources[1].maxPatchVertices = 16;
+
+    double best = 0;
+    double builtIns = 0;
+    double total = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        double passBuiltIns = 0;
+        double passTotal = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < compiles; ++c) {
+            const auto& shader = Shaders[c % ShaderCount];
+            glslang::TShader compile(shader.stage);
+            compile.setStrings(&shader.text, 1);
+            if (! compile.parse(&resources[(c / ShaderCount) % 2], 100, false, EShMsgDefault)) {
+                fprintf(stderr, "could not parse:\n%s%s\n", shader.text, compile.getInfoLog());
+                glslang::FinalizeProcess();
+                return EXIT_FAILURE;
+            }
+            passBuiltIns += compile.getParseTimes().builtIns;
+            passTotal += compile.getParseTimes().total;
+        }
+        auto end = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (pass == 0 || ms < best) {
+            best = ms;
+            builtIns = passBuiltIns;
+            total = passTotal;
+        }
+    }
+
+    printf("%d compiles of %d shaders\n", compiles, ShaderCount);
+    printf("%14s %14s %14s\n", "best (ms)", "compiles/s", "built-ins (%)");
+    printf("%14.2f %14.1f %14.1f\n", best, compiles * 1000.0 / best, total > 0 ? builtIns * 100.0 / total : 0.0);
+
+    glslang::FinalizeProcess();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures constant and type deduplication in spv::Builder.
+//
+// For each size N the benchmark creates N distinct float, N distinct int and N
+// distinct double constants, N/4 vec4 and N/4 array composites of them, and N
+// distinct array types, like a baked lookup table or an unrolled kernel would.
+// It then asks for every one of them again, which must return the ids made
+// the first time.
+//
+// Usage: glslang-bench-spv-constants [max-constants]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "SPIRV/SpvBuilder.h"
+
+namespace {
+
+struct Ids {
+    std::vector<spv::Id> scalars;
+    std::vector<spv::Id> composites;
+    std::vector<spv::Id> types;
+};
+
+Ids MakeConstants(spv::Builder& builder, int count)
+{
+    Ids ids;
+    for (int i = 0; i < count; ++i) {
+        ids.scalars.push_back(builder.makeFloatConstant(i + 0.5f));
+        ids.scalars.push_back(builder.makeIntConstant(i));
+        ids.scalars.push_back(builder.makeDoubleConstant(i * 0.25));
+    }
+
+    const spv::Id vec4 = builder.makeVectorType(builder.makeFloatType(32), 4);
+    const spv::Id array = builder.makeArrayType(builder.makeIntType(32), builder.makeUintConstant(4), 0);
+    for (int i = 0; i + 3 < count; i += 4) {
+        std::vector<spv::Id> floats, ints;
+        for (int c = 0; c < 4; ++c) {
+            floats.push_back(ids.scalars[3 * (i + c)]);
+            ints.push_back(ids.scalars[3 * (i + c) + 1]);
+        }
+        ids.composites.push_back(builder.makeCompositeConstant(vec4, floats));
+        ids.composites.push_back(builder.makeCompositeConstant(array, ints));
+    }
+
+    for (int i = 0; i < count; ++i)
+        ids.types.push_back(builder.makeArrayType(vec4, builder.makeUintConstant(i + 1), 0));
+
+    return ids;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int maxConstants = 100000;
+    if (argc > 1)
+        maxConstants = std::max(1, atoi(argv[1]));
+
+    printf("%10s %14s %14s %16s\n", "constants", "create (ms)", "reuse (ms)", "per constant (us)");
+    for (int count = 10000; count <= maxConstants; count = count < 30000 ? count * 3 : count * 10 / 3) {
+        spv::SpvBuildLogger logger;
+        spv::Builder builder(spv::Spv_1_0, 0, &logger);
+
+        auto start = std::chrono::steady_clock::now();
+        const Ids made = MakeConstants(builder, count);
+        auto created = std::chrono::steady_clock::now();
+        const Ids reused = MakeConstants(builder, count);
+        auto end = std::chrono::steady_clock::now();
+
+        if (made.scalars != reused.scalars || made.composites != reused.composites || made.types != reused.types) {
+            fprintf(stderr, "constants were not reused with %d constants\n", count);
+            return EXIT_FAILURE;
+        }
+
+        const double create = std::chrono::duration<double, std::milli>(created - start).count();
+        const double reuse = std::chrono::duration<double, std::milli>(end - created).count();
+        const size_t total = made.scalars.size() + made.composites.size() + made.types.size();
+        printf("%10d %14.2f %14.2f %16.3f\n", count, create, reuse, (create + reuse) * 1000.0 / (2 * total));
+    }
+
+    return EXIT_SUCCESS;
+}
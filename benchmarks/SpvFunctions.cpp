@@ -0,0 +1,159 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// Measures how SPIR-V generation scales with SpvOptions::functionThreads.
+//
+// A compute shader with many functions is generated, then parsed and
+// linked once.  GlslangToSpv runs over it with 1, 2, 4, ... threads, and
+// the benchmark reports the best wall time of each, checking that every
+// module is identical to the serial one.
+//
+// Usage: glslang-bench-spv-functions [functions] [passes] [max-threads]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+#include "SPIRV/GlslangToSpv.h"
+
+namespace {
+
+// Functions of similar size that share globals, types and constants, and
+// each declare a struct type of their own.
+std::string MakeShader(int functions)
+{
+    std::ostringstream source;
+    source << "#version 450\n"
+              "layout(local_size_x = 64) in;\n"
+              "layout(std430, binding = 0) buffer Data { vec4 d[]; };\n"
+              "shared vec4 scratch[64];\n";
+    for (int f = 0; f < functions; ++f) {
+        source << "struct S" << f << " { vec4 v; uint n; };\n"
+               << "vec4 f" << f << "(vec4 x, uint i) {\n"
+               << "  S" << f << " s = S" << f << "(x, i);\n";
+        for (int s = 0; s < 16; ++s) {
+            source << "  s.v = s.v * vec4(" << s << ".25, " << f << ".5, 1.0, 2.0) + d[s.n + " << s << "u].wzyx;\n";
+            if (s % 4 == 0)
+                source << "  if (s.v.x > " << s << ".0) s.v.y = sin(s.v.z); else scratch[s.n % 64u] = s.v;\n";
+        }
+        source << "  for (uint k = 0u; k < " << (f % 4 + 1) << "u; ++k) s.v += d[s.n + k];\n"
+               << "  return s.v;\n"
+               << "}\n";
+    }
+    source << "void main() {\n"
+              "  uint i = gl_GlobalInvocationID.x;\n"
+              "  vec4 a = vec4(0.0);\n";
+    for (int f = 0; f < functions; ++f)
+        source << "  a += f" << f << "(d[i], i);\n";
+    source << "  d[i] = a;\n"
+              "}\n";
+    return source.str();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    int functions = 400;
+    int passes = 5;
+    int maxThreads = std::max(4, (int)std::thread::hardware_concurrency());
+    if (argc > 1)
+        functions = std::max(1, atoi(argv[1]));
+    if (argc > 2)
+        passes = std::max(1, atoi(argv[2]));
+    if (argc > 3)
+        maxThreads = std::max(1, atoi(argv[3]));
+
+    glslang::InitializeProcess();
+
+    const std::string source = MakeShader(functions);
+    const char* strings[] = { source.c_str() };
+    glslang::TShader shader(EShLangCompute);
+    shader.setStrings(strings, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    glslang::TProgram program;
+    program.addShader(&shader);
+    if (!shader.parse(GetDefaultResources(), 100, false, messages) || !program.link(messages)) {
+        fprintf(stderr, "could not compile the generated shader:\n%s\n%s\n", shader.getInfoLog(), program.getInfoLog());
+        glslang::FinalizeProcess();
+        return EXIT_FAILURE;
+    }
+    const glslang::TIntermediate& intermediate = *program.getIntermediate(EShLangCompute);
+
+    printf("%d functions, %u hardware threads\n", functions, std::thread::hardware_concurrency());
+    printf("%8s %12s %10s %10s\n", "threads", "best (ms)", "speedup", "identical");
+
+    std::vector<unsigned int> serial;
+    double serialBest = 0;
+    bool identical = true;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        glslang::SpvOptions options;
+        options.disableOptimizer = true;
+        options.validate = false;
+        options.functionThreads = threads;
+
+        std::vector<unsigned int> spirv;
+        double best = 0;
+        for (int pass = 0; pass < passes; ++pass) {
+            spirv.clear();
+            auto start = std::chrono::steady_clock::now();
+            glslang::GlslangToSpv(intermediate, spirv, &options);
+            auto end = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            best = pass == 0 ? ms : std::min(best, ms);
+        }
+        if (threads == 1) {
+            serial = spirv;
+            serialBest = best;
+        }
+        const bool same = spirv == serial;
+        identical = identical && same;
+        printf("%8d %12.2f %9.2fx %10s\n", threads, best, serialBest / best, same ? "yes" : "NO");
+    }
+
+    glslang::FinalizeProcess();
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
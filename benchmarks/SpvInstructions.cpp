@@ -0,0 +1,202 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Measures SPIR-V generation over the shaders in Test/.
+//
+// A fixed set of GLSL shaders from the test directory is parsed and linked
+// once for Vulkan.  GlslangToSpv then runs over all of them several
+// times.  The benchmark reports the wall time and the number of heap
+// allocations made while generating SPIR-V, which is mostly the cost of
+// building spv::Instruction objects and their operand lists.
+//
+// Usage: glslang-bench-spv-instructions [test-directory] [passes]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+#include "SPIRV/GlslangToSpv.h"
+
+namespace {
+
+// The largest spv.* GLSL shaders in Test/, so the workload stays fixed as tests are added.
+const char* const Shaders[] = {
+    "spv.shaderBallotAMD.comp", "spv.debuginfo.glsl.comp", "spv.nvAtomicFp16Vec.frag", "spv.atomicFloat.comp",
+    "spv.imageAtomic64.frag", "spv.atomicFloat2.comp", "spv.debuginfo.glsl.frag", "spv.coopmatKHR_constructor.comp",
+    "spv.shaderBallot.comp", "spv.nonuniform.frag", "spv.debuginfo.glsl.vert", "spv.int_dot.frag",
+    "spv.debuginfo.glsl.tese", "spv.memoryScopeSemantics.comp", "spv.1.4.OpCopyLogicalBool.comp", "spv.multiStruct.comp",
+    "spv.coopmatKHR_arithmetic.comp", "spv.1.4.OpCopyLogical.comp", "spv.bufferhandle6.frag", "spv.bufferhandle12.frag",
+    "spv.debuginfo.glsl.geom", "spv.textureoffset_non_const.vert", "spv.sparsetextureoffset_non_const.vert", "spv.constConstruct.vert",
+    "spv.precise.tese", "spv.qcom.tileShading.1.frag", "spv.coopvecloadstore.comp", "spv.1.4.OpSelect.frag",
+    "spv.controlFlowAttributes.frag", "spv.boolInBlock.frag", "spv.structCopy.comp", "spv.prepost.frag",
+};
+
+std::atomic<bool> countAllocations(false);
+std::atomic<unsigned long long> allocations(0);
+
+void* CountedAlloc(std::size_t size)
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    std::abort();
+}
+
+bool StageFromExtension(const std::string& extension, EShLanguage& stage)
+{
+    static const struct {
+        const char* extension;
+        EShLanguage stage;
+    } stages[] = {
+        { ".vert", EShLangVertex },       { ".tesc", EShLangTessControl },
+        { ".tese", EShLangTessEvaluation }, { ".geom", EShLangGeometry },
+        { ".frag", EShLangFragment },     { ".comp", EShLangCompute },
+    };
+    for (const auto& s : stages) {
+        if (extension == s.extension) {
+            stage = s.stage;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Compiled {
+    std::unique_ptr<glslang::TShader> shader;
+    std::unique_ptr<glslang::TProgram> program;
+    EShLanguage stage;
+};
+
+bool Compile(const std::filesystem::path& path, EShLanguage stage, Compiled& compiled)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string source = contents.str();
+    const char* strings[] = { source.c_str() };
+
+    compiled.stage = stage;
+    compiled.shader.reset(new glslang::TShader(stage));
+    compiled.shader->setStrings(strings, 1);
+    compiled.shader->setEnvInput(glslang::EShSourceGlsl, stage, glslang::EShClientVulkan, 100);
+    compiled.shader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    compiled.shader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    if (!compiled.shader->parse(GetDefaultResources(), 100, false, messages))
+        return false;
+
+    compiled.program.reset(new glslang::TProgram);
+    compiled.program->addShader(compiled.shader.get());
+    return compiled.program->link(messages) && compiled.program->getIntermediate(stage) != nullptr;
+}
+
+} // end anonymous namespace
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char* argv[])
+{
+    std::string directory = GLSLANG_TEST_DIRECTORY;
+    int passes = 20;
+    if (argc > 1)
+        directory = argv[1];
+    if (argc > 2)
+        passes = std::max(1, atoi(argv[2]));
+
+    glslang::InitializeProcess();
+
+    std::vector<Compiled> shaders;
+    for (const char* name : Shaders) {
+        const std::filesystem::path path = std::filesystem::path(directory) / name;
+        EShLanguage stage;
+        Compiled compiled;
+        if (!StageFromExtension(path.extension().string(), stage) || !Compile(path, stage, compiled)) {
+            fprintf(stderr, "could not compile %s\n", path.string().c_str());
+            glslang::FinalizeProcess();
+            return EXIT_FAILURE;
+        }
+        shaders.push_back(std::move(compiled));
+    }
+
+    glslang::SpvOptions options;
+    options.disableOptimizer = true;
+    options.validate = false;
+
+    unsigned long long words = 0;
+    unsigned long long passAllocations = 0;
+    double best = 0;
+    for (int pass = 0; pass < passes; ++pass) {
+        words = 0;
+        allocations = 0;
+        countAllocations = true;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& compiled : shaders) {
+            std::vector<unsigned int> spirv;
+            glslang::GlslangToSpv(*compiled.program->getIntermediate(compiled.stage), spirv, &options);
+            words += spirv.size();
+        }
+        auto end = std::chrono::steady_clock::now();
+        countAllocations = false;
+        passAllocations = allocations;
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best = pass == 0 ? ms : std::min(best, ms);
+    }
+
+    printf("%zu shaders, %llu SPIR-V words\n", shaders.size(), words);
+    printf("%14s %14s %18s\n", "best (ms)", "allocations", "allocations/word");
+    printf("%14.2f %14llu %18.3f\n", best, passAllocations, words ? double(passAllocations) / words : 0.0);
+
+    glslang::FinalizeProcess();
+    return EXIT_SUCCESS;
+}
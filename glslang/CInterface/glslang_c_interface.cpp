@@ -44,6 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "glslang/MachineIndependent/Versions.h"
 #include "glslang/MachineIndependent/localintermediate.h"
 
+#ifdef ENABLE_SPIRV
+#include <memory>
+
+#include "SPIRV/CompileCache.h"
+#endif
+
 static_assert(int(GLSLANG_STAGE_COUNT) == EShLangCount, "");
 static_assert(int(GLSLANG_STAGE_MASK_COUNT) == EShLanguageMaskCount, "");
 static_assert(int(GLSLANG_SOURCE_COUNT) == glslang::EShSourceCount, "");
@@ -72,6 +78,15 @@ typedef struct glslang_program_s {
     std::string loggerMessages;
 } glslang_program_t;
 
+#ifdef ENABLE_SPIRV
+typedef struct glslang_compile_cache_s {
+    std::unique_ptr<glslang::TCompileCacheStore> store;
+    std::unique_ptr<glslang::TCompileCache> cache;
+} glslang_compile_cache_t;
+
+static_assert(sizeof(glslang_compile_cache_stats_t) == sizeof(glslang::TCompileCacheStats), "");
+#endif
+
 /* Wrapper/Adapter for C glsl_include_callbacks_t functions
 
    This class contains a 'glsl_include_callbacks_t' structure
@@ -448,6 +463,24 @@ GLSLANG_EXPORT const char* glslang_shader_get_info_log(glslang_shader_t* shader)
 
 GLSLANG_EXPORT const char* glslang_shader_get_info_debug_log(glslang_shader_t* shader) { return shader->shader->getInfoDebugLog(); }
 
+static void c_copy_memory_stats(const glslang::TMemoryStats& memoryStats, glslang_memory_stats_t* stats)
+{
+    stats->allocations = memoryStats.allocations;
+    stats->bytes_requested = memoryStats.bytesRequested;
+    stats->pages_allocated = memoryStats.pagesAllocated;
+    stats->pages_reused = memoryStats.pagesReused;
+    stats->large_allocations = memoryStats.largeAllocations;
+    stats->bytes_reserved = memoryStats.bytesReserved;
+    stats->high_water_mark = memoryStats.highWaterMark;
+    stats->scope_depth = memoryStats.scopeDepth;
+    stats->scope_bytes_requested = memoryStats.scopeBytesRequested;
+}
+
+GLSLANG_EXPORT void glslang_shader_get_memory_stats(const glslang_shader_t* shader, glslang_memory_stats_t* stats)
+{
+    c_copy_memory_stats(shader->shader->getMemoryStats(), stats);
+}
+
 GLSLANG_EXPORT void glslang_shader_delete(glslang_shader_t* shader)
 {
     if (!shader)
@@ -513,6 +546,11 @@ GLSLANG_EXPORT const char* glslang_program_get_info_debug_log(glslang_program_t*
     return program->program->getInfoDebugLog();
 }
 
+GLSLANG_EXPORT void glslang_program_get_memory_stats(const glslang_program_t* program, glslang_memory_stats_t* stats)
+{
+    c_copy_memory_stats(program->program->getArena().getStats(), stats);
+}
+
 GLSLANG_EXPORT glslang_mapper_t* glslang_glsl_mapper_create()
 {
     return reinterpret_cast<glslang_mapper_t*>(new glslang::TGlslIoMapper());
@@ -539,3 +577,84 @@ GLSLANG_EXPORT void glslang_glsl_resolver_delete(glslang_resolver_t* resolver)
 
     delete reinterpret_cast<glslang::TDefaultGlslIoResolver* >(resolver);
 }
+
+#ifdef ENABLE_SPIRV
+static glslang_compile_cache_t* c_compile_cache_create(glslang::TCompileCacheStore* store)
+{
+    glslang_compile_cache_t* cache = new glslang_compile_cache_t();
+    cache->store.reset(store);
+    cache->cache.reset(new glslang::TCompileCache(*store));
+    return cache;
+}
+
+GLSLANG_EXPORT glslang_compile_cache_t* glslang_compile_cache_create_memory(size_t capacity_bytes)
+{
+    return c_compile_cache_create(new glslang::TMemoryCompileCacheStore(capacity_bytes));
+}
+
+GLSLANG_EXPORT glslang_compile_cache_t* glslang_compile_cache_create_directory(const char* directory)
+{
+    if (!directory)
+        return nullptr;
+
+    return c_compile_cache_create(new glslang::TDirectoryCompileCacheStore(directory));
+}
+
+GLSLANG_EXPORT void glslang_compile_cache_delete(glslang_compile_cache_t* cache)
+{
+    if (!cache)
+        return;
+
+    delete cache;
+}
+
+GLSLANG_EXPORT int glslang_compile_cache_compile(glslang_compile_cache_t* cache, const glslang_input_t* input,
+                                                 const glslang_spv_options_t* spv_options, glslang_program_t* program)
+{
+    if (!input || !input->code)
+        return 0;
+
+    glslang::TCompileCacheInput cacheInput;
+    cacheInput.code = input->code;
+    cacheInput.environment.input = { c_shader_source(input->language), c_shader_stage(input->stage),
+                                     c_shader_client(input->client), input->default_version, false };
+    cacheInput.environment.client = { c_shader_client(input->client), c_shader_client_version(input->client_version) };
+    cacheInput.environment.target = { c_shader_target_language(input->target_language),
+                                      c_shader_target_language_version(input->target_language_version), false };
+    cacheInput.resources = reinterpret_cast<const TBuiltInResource*>(input->resource);
+    cacheInput.defaultVersion = input->default_version;
+    cacheInput.defaultProfile = c_shader_profile(input->default_profile);
+    cacheInput.forceDefaultVersionAndProfile = input->force_default_version_and_profile != 0;
+    cacheInput.forwardCompatible = input->forward_compatible != 0;
+    cacheInput.messages = (EShMessages)c_shader_messages(input->messages);
+
+    DirStackFileIncluder dirStackFileIncluder;
+    CallbackIncluder callbackIncluder(input->callbacks, input->callbacks_ctx);
+    cacheInput.includer = (input->callbacks.include_local || input->callbacks.include_system)
+        ? static_cast<glslang::TShader::Includer*>(&callbackIncluder)
+        : static_cast<glslang::TShader::Includer*>(&dirStackFileIncluder);
+
+    // Same defaults as glslang_program_SPIRV_generate
+    glslang::SpvOptions options;
+    if (spv_options)
+        options = *reinterpret_cast<const glslang::SpvOptions*>(spv_options);
+    else
+        options.validate = true;
+
+    return cache->cache->compile(cacheInput, options, program->spirv, program->loggerMessages) ? 1 : 0;
+}
+
+GLSLANG_EXPORT void glslang_compile_cache_get_stats(const glslang_compile_cache_t* cache, glslang_compile_cache_stats_t* stats)
+{
+    const glslang::TCompileCacheStats cacheStats = cache->cache->getStats();
+    stats->hits = cacheStats.hits;
+    stats->misses = cacheStats.misses;
+    stats->stores = cacheStats.stores;
+    stats->evictions = cacheStats.evictions;
+}
+
+GLSLANG_EXPORT void glslang_compile_cache_reset_stats(glslang_compile_cache_t* cache)
+{
+    cache->cache->resetStats();
+}
+#endif
@@ -53,6 +53,10 @@
 #include <cctype>
 #include <utility>
 #include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace {  // anonymous namespace functions
 
@@ -382,6 +386,566 @@ inline void FindVectorMatrixBounds(const char* argOrder, int fixedVecSize, int&
         dim0Min = dim0Max = fixedVecSize;
 }
 
+const EShLanguageMask EShLangAll    = EShLanguageMask(EShLangCount - 1);
+
+// These are the actual stage masks defined in the documentation, in case they are
+// needed for future validation.  For now, they are commented out, and set below
+// to EShLangAll, to allow any intrinsic to be used in any shader, which is legal
+// if it is not called.
+//
+// const EShLanguageMask EShLangPSCS   = EShLanguageMask(EShLangFragmentMask | EShLangComputeMask);
+// const EShLanguageMask EShLangVSPSGS = EShLanguageMask(EShLangVertexMask | EShLangFragmentMask | EShLangGeometryMask);
+// const EShLanguageMask EShLangCS     = EShLangComputeMask;
+// const EShLanguageMask EShLangPS     = EShLangFragmentMask;
+// const EShLanguageMask EShLangHS     = EShLangTessControlMask;
+
+// This set uses EShLangAll for everything.
+const EShLanguageMask EShLangPSCS   = EShLangAll;
+const EShLanguageMask EShLangVSPSGS = EShLangAll;
+const EShLanguageMask EShLangCS     = EShLangAll;
+const EShLanguageMask EShLangPS     = EShLangAll;
+const EShLanguageMask EShLangHS     = EShLangAll;
+const EShLanguageMask EShLangGS     = EShLangAll;
+
+// This structure encodes the prototype information for each HLSL intrinsic.
+// Because explicit enumeration would be cumbersome, it's procedurally generated.
+// orderKey can be:
+//   S = scalar, V = vector, M = matrix, - = void
+// typekey can be:
+//   D = double, F = float, U = uint, I = int, B = bool, S = sampler, s = shadowSampler, M = uint64_t, L = int64_t
+// An empty order or type key repeats the first one.  E.g: SVM,, means 3 args each of SVM.
+// '>' as first letter of order creates an output parameter
+// '<' as first letter of order creates an input parameter
+// '^' as first letter of order takes transpose dimensions
+// '%' as first letter of order creates texture of given F/I/U type (texture, itexture, etc)
+// '@' as first letter of order creates arrayed texture of given type
+// '$' / '&' as first letter of order creates 2DMS / 2DMSArray textures
+// '*' as first letter of order creates buffer object
+// '!' as first letter of order creates image object
+// '#' as first letter of order creates arrayed image object
+// '~' as first letter of order creates an image buffer object
+// '[' / ']' as first letter of order creates a SubpassInput/SubpassInputMS object
+
+struct TIntrinsic {
+    const char*   name;      // intrinsic name
+    const char*   retOrder;  // return type key: empty matches order of 1st argument
+    const char*   retType;   // return type key: empty matches type of 1st argument
+    const char*   argOrder;  // argument order key
+    const char*   argType;   // argument type key
+    unsigned int  stage;     // stage mask
+    bool          method;    // true if it's a method.
+};
+
+const TIntrinsic hlslIntrinsics[] = {
+    // name                               retOrd   retType    argOrder          argType          stage mask     method
+    // ----------------------------------------------------------------------------------------------------------------
+    { "abort",                            nullptr, nullptr,   "-",              "-",             EShLangAll,    false },
+    { "abs",                              nullptr, nullptr,   "SVM",            "DFUI",          EShLangAll,    false },
+    { "acos",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "all",                              "S",    "B",        "SVM",            "BFIU",          EShLangAll,    false },
+    { "AllMemoryBarrier",                 nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
+    { "AllMemoryBarrierWithGroupSync",    nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
+    { "any",                              "S",     "B",       "SVM",            "BFIU",          EShLangAll,    false },
+    { "asdouble",                         "S",     "D",       "S,",             "UI,",           EShLangAll,    false },
+    { "asdouble",                         "V2",    "D",       "V2,",            "UI,",           EShLangAll,    false },
+    { "asfloat",                          nullptr, "F",       "SVM",            "BFIU",          EShLangAll,    false },
+    { "asin",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "asint",                            nullptr, "I",       "SVM",            "FIU",           EShLangAll,    false },
+    { "asuint",                           nullptr, "U",       "SVM",            "FIU",           EShLangAll,    false },
+    { "atan",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "atan2",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "ceil",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "CheckAccessFullyMapped",           "S",     "B" ,      "S",              "U",             EShLangPSCS,   false },
+    { "clamp",                            nullptr, nullptr,   "SVM,,",          "FUI,,",         EShLangAll,    false },
+    { "clip",                             "-",     "-",       "SVM",            "FUI",           EShLangPS,     false },
+    { "cos",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "cosh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "countbits",                        nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
+    { "cross",                            nullptr, nullptr,   "V3,",            "F,",            EShLangAll,    false },
+    { "D3DCOLORtoUBYTE4",                 "V4",    "I",       "V4",             "F",             EShLangAll,    false },
+    { "ddx",                              nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "ddx_coarse",                       nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "ddx_fine",                         nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "ddy",                              nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "ddy_coarse",                       nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "ddy_fine",                         nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "degrees",                          nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "determinant",                      "S",     "F",       "M",              "F",             EShLangAll,    false },
+    { "DeviceMemoryBarrier",              nullptr, nullptr,   "-",              "-",             EShLangPSCS,   false },
+    { "DeviceMemoryBarrierWithGroupSync", nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
+    { "distance",                         "S",     "F",       "SV,",            "F,",            EShLangAll,    false },
+    { "dot",                              "S",     nullptr,   "SV,",            "FI,",           EShLangAll,    false },
+    { "dst",                              nullptr, nullptr,   "V4,",            "F,",            EShLangAll,    false },
+    // { "errorf",                           "-",     "-",       "",             "",             EShLangAll,    false }, TODO: varargs
+    { "EvaluateAttributeAtCentroid",      nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "EvaluateAttributeAtSample",        nullptr, nullptr,   "SVM,S",          "F,U",           EShLangPS,     false },
+    { "EvaluateAttributeSnapped",         nullptr, nullptr,   "SVM,V2",         "F,I",           EShLangPS,     false },
+    { "exp",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "exp2",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "f16tof32",                         nullptr, "F",       "SV",             "U",             EShLangAll,    false },
+    { "f32tof16",                         nullptr, "U",       "SV",             "F",             EShLangAll,    false },
+    { "faceforward",                      nullptr, nullptr,   "V,,",            "F,,",           EShLangAll,    false },
+    { "firstbithigh",                     nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
+    { "firstbitlow",                      nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
+    { "floor",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "fma",                              nullptr, nullptr,   "SVM,,",          "D,,",           EShLangAll,    false },
+    { "fmod",                             nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "frac",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "frexp",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "fwidth",                           nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
+    { "GetRenderTargetSampleCount",       "S",     "U",       "-",              "-",             EShLangAll,    false },
+    { "GetRenderTargetSamplePosition",    "V2",    "F",       "V1",             "I",             EShLangAll,    false },
+    { "GroupMemoryBarrier",               nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
+    { "GroupMemoryBarrierWithGroupSync",  nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
+    { "InterlockedAdd",                   "-",     "-",       "SVM,,>",         "FUI,,",          EShLangPSCS,   false },
+    { "InterlockedAdd",                   "-",     "-",       "SVM,",           "FUI,",           EShLangPSCS,   false },
+    { "InterlockedAnd",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedAnd",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
+    { "InterlockedCompareExchange",       "-",     "-",       "SVM,,,>",        "UI,,,",         EShLangPSCS,   false },
+    { "InterlockedCompareStore",          "-",     "-",       "SVM,,",          "UI,,",          EShLangPSCS,   false },
+    { "InterlockedExchange",              "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedMax",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedMax",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
+    { "InterlockedMin",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedMin",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
+    { "InterlockedOr",                    "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedOr",                    "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
+    { "InterlockedXor",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
+    { "InterlockedXor",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
+    { "isfinite",                         nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
+    { "isinf",                            nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
+    { "isnan",                            nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
+    { "ldexp",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "length",                           "S",     "F",       "SV",             "F",             EShLangAll,    false },
+    { "lerp",                             nullptr, nullptr,   "VM,,",           "F,,",           EShLangAll,    false },
+    { "lerp",                             nullptr, nullptr,   "SVM,,S",         "F,,",           EShLangAll,    false },
+    { "lit",                              "V4",    "F",       "S,,",            "F,,",           EShLangAll,    false },
+    { "log",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "log10",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "log2",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "mad",                              nullptr, nullptr,   "SVM,,",          "DFUI,,",        EShLangAll,    false },
+    { "max",                              nullptr, nullptr,   "SVM,",           "FIU,",          EShLangAll,    false },
+    { "min",                              nullptr, nullptr,   "SVM,",           "FIU,",          EShLangAll,    false },
+    { "modf",                             nullptr, nullptr,   "SVM,>",          "FIU,",          EShLangAll,    false },
+    { "msad4",                            "V4",    "U",       "S,V2,V4",        "U,,",           EShLangAll,    false },
+    { "mul",                              "S",     nullptr,   "S,S",            "FI,",           EShLangAll,    false },
+    { "mul",                              "V",     nullptr,   "S,V",            "FI,",           EShLangAll,    false },
+    { "mul",                              "M",     nullptr,   "S,M",            "FI,",           EShLangAll,    false },
+    { "mul",                              "V",     nullptr,   "V,S",            "FI,",           EShLangAll,    false },
+    { "mul",                              "S",     nullptr,   "V,V",            "FI,",           EShLangAll,    false },
+    { "mul",                              "M",     nullptr,   "M,S",            "FI,",           EShLangAll,    false },
+    // mat*mat form of mul is handled in createMatTimesMat()
+    { "noise",                            "S",     "F",       "V",              "F",             EShLangPS,     false },
+    { "normalize",                        nullptr, nullptr,   "V",              "F",             EShLangAll,    false },
+    { "pow",                              nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "printf",                           nullptr, nullptr,   "-",              "-",             EShLangAll,    false },
+    { "Process2DQuadTessFactorsAvg",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
+    { "Process2DQuadTessFactorsMax",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
+    { "Process2DQuadTessFactorsMin",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
+    { "ProcessIsolineTessFactors",        "-",     "-",       "S,,>,>",         "F,,,",          EShLangHS,     false },
+    { "ProcessQuadTessFactorsAvg",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
+    { "ProcessQuadTessFactorsMax",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
+    { "ProcessQuadTessFactorsMin",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
+    { "ProcessTriTessFactorsAvg",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
+    { "ProcessTriTessFactorsMax",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
+    { "ProcessTriTessFactorsMin",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
+    { "radians",                          nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "rcp",                              nullptr, nullptr,   "SVM",            "FD",            EShLangAll,    false },
+    { "reflect",                          nullptr, nullptr,   "V,",             "F,",            EShLangAll,    false },
+    { "refract",                          nullptr, nullptr,   "V,V,S",          "F,,",           EShLangAll,    false },
+    { "reversebits",                      nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
+    { "round",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "rsqrt",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "saturate",                         nullptr, nullptr ,  "SVM",            "F",             EShLangAll,    false },
+    { "sign",                             nullptr, nullptr,   "SVM",            "FI",            EShLangAll,    false },
+    { "sin",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "sincos",                           "-",     "-",       "SVM,>,>",        "F,,",           EShLangAll,    false },
+    { "sinh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "smoothstep",                       nullptr, nullptr,   "SVM,,",          "F,,",           EShLangAll,    false },
+    { "sqrt",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "step",                             nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
+    { "tan",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "tanh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+    { "tex1D",                            "V4",    "F",       "S,S",            "S,F",           EShLangPS,     false },
+    { "tex1D",                            "V4",    "F",       "S,S,V1,",        "S,F,,",         EShLangPS,     false },
+    { "tex1Dbias",                        "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
+    { "tex1Dgrad",                        "V4",    "F",       "S,,,",           "S,F,,",         EShLangPS,     false },
+    { "tex1Dlod",                         "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
+    { "tex1Dproj",                        "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
+    { "tex2D",                            "V4",    "F",       "V2,",            "S,F",           EShLangPS,     false },
+    { "tex2D",                            "V4",    "F",       "V2,,,",          "S,F,,",         EShLangPS,     false },
+    { "tex2Dbias",                        "V4",    "F",       "V2,V4",          "S,F",           EShLangPS,     false },
+    { "tex2Dgrad",                        "V4",    "F",       "V2,,,",          "S,F,,",         EShLangPS,     false },
+    { "tex2Dlod",                         "V4",    "F",       "V2,V4",          "S,F",           EShLangAll,    false },
+    { "tex2Dproj",                        "V4",    "F",       "V2,V4",          "S,F",           EShLangPS,     false },
+    { "tex3D",                            "V4",    "F",       "V3,",            "S,F",           EShLangPS,     false },
+    { "tex3D",                            "V4",    "F",       "V3,,,",          "S,F,,",         EShLangPS,     false },
+    { "tex3Dbias",                        "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
+    { "tex3Dgrad",                        "V4",    "F",       "V3,,,",          "S,F,,",         EShLangPS,     false },
+    { "tex3Dlod",                         "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
+    { "tex3Dproj",                        "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
+    { "texCUBE",                          "V4",    "F",       "V4,V3",          "S,F",           EShLangPS,     false },
+    { "texCUBE",                          "V4",    "F",       "V4,V3,,",        "S,F,,",         EShLangPS,     false },
+    { "texCUBEbias",                      "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
+    { "texCUBEgrad",                      "V4",    "F",       "V4,V3,,",        "S,F,,",         EShLangPS,     false },
+    { "texCUBElod",                       "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
+    { "texCUBEproj",                      "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
+    { "transpose",                        "^M",    nullptr,   "M",              "FUIB",          EShLangAll,    false },
+    { "trunc",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
+
+    // Texture object methods.  Return type can be overridden by shader declaration.
+    // !O = no offset, O = offset
+    { "Sample",             /*!O*/        "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangPS,    true },
+    { "Sample",             /* O*/        "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangPS,    true },
+
+    { "SampleBias",         /*!O*/        "V4",    nullptr,   "%@,S,V,S",       "FIU,S,F,F",      EShLangPS,    true },
+    { "SampleBias",         /* O*/        "V4",    nullptr,   "%@,S,V,S,V",     "FIU,S,F,F,I",    EShLangPS,    true },
+
+    // TODO: FXC accepts int/uint samplers here.  unclear what that means.
+    { "SampleCmp",          /*!O*/        "S",     "F",       "%@,S,V,S",       "FIU,s,F,",       EShLangPS,    true },
+    { "SampleCmp",          /* O*/        "S",     "F",       "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangPS,    true },
+
+    // TODO: FXC accepts int/uint samplers here.  unclear what that means.
+    { "SampleCmpLevelZero", /*!O*/        "S",     "F",       "%@,S,V,S",       "FIU,s,F,F",      EShLangPS,    true },
+    { "SampleCmpLevelZero", /* O*/        "S",     "F",       "%@,S,V,S,V",     "FIU,s,F,F,I",    EShLangPS,    true },
+
+    { "SampleGrad",         /*!O*/        "V4",    nullptr,   "%@,S,V,,",       "FIU,S,F,,",      EShLangAll,   true },
+    { "SampleGrad",         /* O*/        "V4",    nullptr,   "%@,S,V,,,",      "FIU,S,F,,,I",    EShLangAll,   true },
+
+    { "SampleLevel",        /*!O*/        "V4",    nullptr,   "%@,S,V,S",       "FIU,S,F,",       EShLangAll,   true },
+    { "SampleLevel",        /* O*/        "V4",    nullptr,   "%@,S,V,S,V",     "FIU,S,F,,I",     EShLangAll,   true },
+
+    { "Load",               /*!O*/        "V4",    nullptr,   "%@,V",           "FIU,I",          EShLangAll,   true },
+    { "Load",               /* O*/        "V4",    nullptr,   "%@,V,V",         "FIU,I,I",        EShLangAll,   true },
+    { "Load", /* +sampleidex*/            "V4",    nullptr,   "$&,V,S",         "FIU,I,I",        EShLangAll,   true },
+    { "Load", /* +samplindex, offset*/    "V4",    nullptr,   "$&,V,S,V",       "FIU,I,I,I",      EShLangAll,   true },
+
+    // RWTexture loads
+    { "Load",                             "V4",    nullptr,   "!#,V",           "FIU,I",          EShLangAll,   true },
+    // (RW)Buffer loads
+    { "Load",                             "V4",    nullptr,   "~*1,V",          "FIU,I",          EShLangAll,   true },
+
+    { "Gather",             /*!O*/        "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
+    { "Gather",             /* O*/        "V4",    nullptr,   "%@,S,V,V",       "FIU,S,F,I",      EShLangAll,   true },
+
+    { "CalculateLevelOfDetail",           "S",     "F",       "%@,S,V",         "FUI,S,F",        EShLangPS,    true },
+    { "CalculateLevelOfDetailUnclamped",  "S",     "F",       "%@,S,V",         "FUI,S,F",        EShLangPS,    true },
+
+    { "GetSamplePosition",                "V2",    "F",       "$&2,S",          "FUI,I",          EShLangVSPSGS,true },
+
+    //
+    // UINT Width
+    // UINT MipLevel, UINT Width, UINT NumberOfLevels
+    { "GetDimensions",   /* 1D */         "-",     "-",       "%!~1,>S",        "FUI,U",          EShLangAll,   true },
+    { "GetDimensions",   /* 1D */         "-",     "-",       "%!~1,>S",        "FUI,F",          EShLangAll,   true },
+    { "GetDimensions",   /* 1D */         "-",     "-",       "%1,S,>S,",       "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 1D */         "-",     "-",       "%1,S,>S,",       "FUI,U,F,",       EShLangAll,   true },
+
+    // UINT Width, UINT Elements
+    // UINT MipLevel, UINT Width, UINT Elements, UINT NumberOfLevels
+    { "GetDimensions",   /* 1DArray */    "-",     "-",       "@#1,>S,",        "FUI,U,",         EShLangAll,   true },
+    { "GetDimensions",   /* 1DArray */    "-",     "-",       "@#1,>S,",        "FUI,F,",         EShLangAll,   true },
+    { "GetDimensions",   /* 1DArray */    "-",     "-",       "@1,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
+    { "GetDimensions",   /* 1DArray */    "-",     "-",       "@1,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
+
+    // UINT Width, UINT Height
+    // UINT MipLevel, UINT Width, UINT Height, UINT NumberOfLevels
+    { "GetDimensions",   /* 2D */         "-",     "-",       "%!2,>S,",        "FUI,U,",         EShLangAll,   true },
+    { "GetDimensions",   /* 2D */         "-",     "-",       "%!2,>S,",        "FUI,F,",         EShLangAll,   true },
+    { "GetDimensions",   /* 2D */         "-",     "-",       "%2,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
+    { "GetDimensions",   /* 2D */         "-",     "-",       "%2,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
+
+    // UINT Width, UINT Height, UINT Elements
+    // UINT MipLevel, UINT Width, UINT Height, UINT Elements, UINT NumberOfLevels
+    { "GetDimensions",   /* 2DArray */    "-",     "-",       "@#2,>S,,",       "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 2DArray */    "-",     "-",       "@#2,>S,,",       "FUI,F,F,F",      EShLangAll,   true },
+    { "GetDimensions",   /* 2DArray */    "-",     "-",       "@2,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
+    { "GetDimensions",   /* 2DArray */    "-",     "-",       "@2,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
+
+    // UINT Width, UINT Height, UINT Depth
+    // UINT MipLevel, UINT Width, UINT Height, UINT Depth, UINT NumberOfLevels
+    { "GetDimensions",   /* 3D */         "-",     "-",       "%!3,>S,,",       "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 3D */         "-",     "-",       "%!3,>S,,",       "FUI,F,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 3D */         "-",     "-",       "%3,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
+    { "GetDimensions",   /* 3D */         "-",     "-",       "%3,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
+
+    // UINT Width, UINT Height
+    // UINT MipLevel, UINT Width, UINT Height, UINT NumberOfLevels
+    { "GetDimensions",   /* Cube */       "-",     "-",       "%4,>S,",         "FUI,U,",         EShLangAll,   true },
+    { "GetDimensions",   /* Cube */       "-",     "-",       "%4,>S,",         "FUI,F,",         EShLangAll,   true },
+    { "GetDimensions",   /* Cube */       "-",     "-",       "%4,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
+    { "GetDimensions",   /* Cube */       "-",     "-",       "%4,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
+
+    // UINT Width, UINT Height, UINT Elements
+    // UINT MipLevel, UINT Width, UINT Height, UINT Elements, UINT NumberOfLevels
+    { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,>S,,",        "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,>S,,",        "FUI,F,,",        EShLangAll,   true },
+    { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
+    { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
+
+    // UINT Width, UINT Height, UINT Samples
+    // UINT Width, UINT Height, UINT Elements, UINT Samples
+    { "GetDimensions",   /* 2DMS */       "-",     "-",       "$2,>S,,",        "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 2DMS */       "-",     "-",       "$2,>S,,",        "FUI,U,,",        EShLangAll,   true },
+    { "GetDimensions",   /* 2DMSArray */  "-",     "-",       "&2,>S,,,",       "FUI,U,,,",       EShLangAll,   true },
+    { "GetDimensions",   /* 2DMSArray */  "-",     "-",       "&2,>S,,,",       "FUI,U,,,",       EShLangAll,   true },
+
+    // SM5 texture methods
+    { "GatherRed",       /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
+    { "GatherRed",       /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
+    { "GatherRed",       /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
+    { "GatherRed",       /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
+    { "GatherRed",       /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
+
+    { "GatherGreen",     /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
+    { "GatherGreen",     /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
+    { "GatherGreen",     /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
+    { "GatherGreen",     /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
+    { "GatherGreen",     /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
+
+    { "GatherBlue",      /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
+    { "GatherBlue",      /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
+    { "GatherBlue",      /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
+    { "GatherBlue",      /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
+    { "GatherBlue",      /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
+
+    { "GatherAlpha",     /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
+    { "GatherAlpha",     /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
+    { "GatherAlpha",     /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
+    { "GatherAlpha",     /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
+    { "GatherAlpha",     /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
+
+    { "GatherCmp",       /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
+    { "GatherCmp",       /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
+    { "GatherCmp",       /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
+    { "GatherCmp",       /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
+    { "GatherCmp",       /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,V,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
+
+    { "GatherCmpRed",    /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
+    { "GatherCmpRed",    /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
+    { "GatherCmpRed",    /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
+    { "GatherCmpRed",    /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
+    { "GatherCmpRed",    /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,V,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
+
+    { "GatherCmpGreen",  /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
+    { "GatherCmpGreen",  /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
+    { "GatherCmpGreen",  /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
+    { "GatherCmpGreen",  /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
+    { "GatherCmpGreen",  /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
+
+    { "GatherCmpBlue",   /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
+    { "GatherCmpBlue",   /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
+    { "GatherCmpBlue",   /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
+    { "GatherCmpBlue",   /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
+    { "GatherCmpBlue",   /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
+
+    { "GatherCmpAlpha",  /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
+    { "GatherCmpAlpha",  /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
+    { "GatherCmpAlpha",  /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
+    { "GatherCmpAlpha",  /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
+    { "GatherCmpAlpha",  /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
+
+    // geometry methods
+    { "Append",                           "-",     "-",       "-",              "-",              EShLangGS ,   true },
+    { "RestartStrip",                     "-",     "-",       "-",              "-",              EShLangGS ,   true },
+
+    // Methods for structurebuffers.  TODO: wildcard type matching.
+    { "Load",                             nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Load2",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Load3",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Load4",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Store",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Store2",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Store3",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Store4",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "GetDimensions",                    nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedAdd",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedAnd",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedCompareExchange",       nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedCompareStore",          nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedExchange",              nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedMax",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedMin",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedOr",                    nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "InterlockedXor",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "IncrementCounter",                 nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "DecrementCounter",                 nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+    { "Consume",                          nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
+
+    // SM 6.0
+
+    { "WaveIsFirstLane",                  "S",     "B",       "-",              "-",              EShLangPSCS,  false},
+    { "WaveGetLaneCount",                 "S",     "U",       "-",              "-",              EShLangPSCS,  false},
+    { "WaveGetLaneIndex",                 "S",     "U",       "-",              "-",              EShLangPSCS,  false},
+    { "WaveActiveAnyTrue",                "S",     "B",       "S",              "B",              EShLangPSCS,  false},
+    { "WaveActiveAllTrue",                "S",     "B",       "S",              "B",              EShLangPSCS,  false},
+    { "WaveActiveBallot",                 "V4",    "U",       "S",              "B",              EShLangPSCS,  false},
+    { "WaveReadLaneAt",                   nullptr, nullptr,   "SV,S",           "DFUI,U",         EShLangPSCS,  false},
+    { "WaveReadLaneFirst",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveAllEqual",               "S",     "B",       "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveAllEqualBool",           "S",     "B",       "S",              "B",              EShLangPSCS,  false},
+    { "WaveActiveCountBits",              "S",     "U",       "S",              "B",              EShLangPSCS,  false},
+
+    { "WaveActiveSum",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveProduct",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveBitAnd",                 nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveBitOr",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveBitXor",                 nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveMin",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WaveActiveMax",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WavePrefixSum",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WavePrefixProduct",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "WavePrefixCountBits",              "S",     "U",       "S",              "B",              EShLangPSCS,  false},
+    { "QuadReadAcrossX",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "QuadReadAcrossY",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "QuadReadAcrossDiagonal",           nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
+    { "QuadReadLaneAt",                   nullptr, nullptr,   "SV,S",           "DFUI,U",         EShLangPSCS,  false},
+
+    // Methods for subpass input objects
+    { "SubpassLoad",                      "V4",    nullptr,   "[",              "FIU",            EShLangPS,    true },
+    { "SubpassLoad",                      "V4",    nullptr,   "],S",            "FIU,I",          EShLangPS,    true },
+
+    // Mark end of list, since we want to avoid a range-based for, as some compilers don't handle it yet.
+    { nullptr,                            nullptr, nullptr,   nullptr,      nullptr,  0, false },
+};
+
+// Append the prototypes for one entry of the table above.
+void AppendIntrinsic(glslang::TString& s, const TIntrinsic& intrinsic)
+{
+    for (const char* argOrder = intrinsic.argOrder; !IsEndOfArg(argOrder); ++argOrder) { // for each order...
+        const bool isTexture   = IsTextureType(*argOrder);
+        const bool isArrayed   = IsArrayed(*argOrder);
+        const bool isMS        = IsTextureMS(*argOrder);
+        const bool isBuffer    = IsBuffer(*argOrder);
+        const bool isImage     = IsImage(*argOrder);
+        const bool mipInCoord  = HasMipInCoord(intrinsic.name, isMS, isBuffer, isImage);
+        const int fixedVecSize = FixedVecSize(argOrder);
+        const int coordArg     = CoordinateArgPos(intrinsic.name, isTexture);
+
+        // calculate min and max vector and matrix dimensions
+        int dim0Min = 1;
+        int dim0Max = 1;
+        int dim1Min = 1;
+        int dim1Max = 1;
+
+        FindVectorMatrixBounds(argOrder, fixedVecSize, dim0Min, dim0Max, dim1Min, dim1Max);
+
+        for (const char* argType = intrinsic.argType; !IsEndOfArg(argType); ++argType) { // for each type...
+            for (int dim0 = dim0Min; dim0 <= dim0Max; ++dim0) {          // for each dim 0...
+                for (int dim1 = dim1Min; dim1 <= dim1Max; ++dim1) {      // for each dim 1...
+                    const char* retOrder = intrinsic.retOrder ? intrinsic.retOrder : argOrder;
+                    const char* retType  = intrinsic.retType  ? intrinsic.retType  : argType;
+
+                    if (!IsValid(intrinsic.name, *retOrder, *retType, *argOrder, *argType, dim0, dim1))
+                        continue;
+
+                    // Reject some forms of sample methods that don't exist.
+                    if (isTexture && IsIllegalSample(intrinsic.name, argOrder, dim0))
+                        continue;
+
+                    AppendTypeName(s, retOrder, retType, dim0, dim1);  // add return type
+                    s.append(" ");                                     // space between type and name
+
+                    // methods have a prefix.  TODO: it would be better as an invalid identifier character,
+                    // but that requires a scanner change.
+                    if (intrinsic.method)
+                        s.append(BUILTIN_PREFIX);
+
+                    s.append(intrinsic.name);                          // intrinsic name
+                    s.append("(");                                     // open paren
+
+                    const char* prevArgOrder = nullptr;
+                    const char* prevArgType = nullptr;
+
+                    // Append argument types, if any.
+                    for (int arg = 0; ; ++arg) {
+                        const char* nthArgOrder(NthArg(argOrder, arg));
+                        const char* nthArgType(NthArg(argType, arg));
+
+                        if (nthArgOrder == nullptr || nthArgType == nullptr)
+                            break;
+
+                        // cube textures use vec3 coordinates
+                        int argDim0 = isTexture && arg > 0 ? std::min(dim0, 3) : dim0;
+
+                        s.append(arg > 0 ? ", ": "");  // comma separator if needed
+
+                        const char* orderBegin = nthArgOrder;
+                        nthArgOrder = IoParam(s, nthArgOrder);
+
+                        // Comma means use the previous argument order and type.
+                        HandleRepeatArg(nthArgOrder, prevArgOrder, orderBegin);
+                        HandleRepeatArg(nthArgType,  prevArgType, nthArgType);
+
+                        // In case the repeated arg has its own I/O marker
+                        nthArgOrder = IoParam(s, nthArgOrder);
+
+                        // arrayed textures have one extra coordinate dimension, except for
+                        // the CalculateLevelOfDetail family.
+                        if (isArrayed && arg == coordArg && !NoArrayCoord(intrinsic.name))
+                            argDim0++;
+
+                        // Some texture methods use an addition arg dimension to hold mip
+                        if (arg == coordArg && mipInCoord)
+                            argDim0++;
+
+                        // For textures, the 1D case isn't a 1-vector, but a scalar.
+                        if (isTexture && argDim0 == 1 && arg > 0 && *nthArgOrder == 'V')
+                            nthArgOrder = "S";
+
+                        AppendTypeName(s, nthArgOrder, nthArgType, argDim0, dim1); // Add arguments
+                    }
+
+                    s.append(");\n");            // close paren and trailing semicolon
+                } // dim 1 loop
+            } // dim 0 loop
+        } // arg type loop
+
+        // skip over special characters
+        if (isTexture && isalpha(argOrder[1]))
+            ++argOrder;
+        if (isdigit(argOrder[1]))
+            ++argOrder;
+    } // arg order loop
+}
+
+// The intrinsics available to every stage, by the name they are prototyped under,
+// which for methods includes BUILTIN_PREFIX.  Built once per process.
+struct TLazyIntrinsics {
+    TLazyIntrinsics()
+    {
+        std::unordered_map<std::string, int> first;
+        for (int icount = 0; hlslIntrinsics[icount].name; ++icount) {
+            const TIntrinsic& intrinsic = hlslIntrinsics[icount];
+            if (intrinsic.stage != EShLangAll)
+                continue;
+
+            std::string name = intrinsic.method ? BUILTIN_PREFIX : "";
+            name += intrinsic.name;
+            auto added = first.insert({ name, (int)names.size() });
+            if (added.second) {
+                names.push_back(name);
+                entries.emplace_back();
+            }
+            entries[added.first->second].push_back(icount);
+        }
+
+        // 'names' no longer moves, so it can hold the keys.
+        for (int n = 0; n < (int)names.size(); ++n)
+            byName[names[n]] = n;
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::vector<int>> entries;             // into hlslIntrinsics, in table order
+    std::unordered_map<std::string_view, int> byName;  // into names
+};
+
+const TLazyIntrinsics& GetLazyIntrinsics()
+{
+    static const TLazyIntrinsics lazyIntrinsics;
+    return lazyIntrinsics;
+}
+
 } // end anonymous namespace
 
 namespace glslang {
@@ -394,10 +958,8 @@ TBuiltInParseablesHlsl::TBuiltInParseablesHlsl()
 // Handle creation of mat*mat specially, since it doesn't fall conveniently out of
 // the generic prototype creation code below.
 //
-void TBuiltInParseablesHlsl::createMatTimesMat()
+void TBuiltInParseablesHlsl::createMatTimesMat(TString& s) const
 {
-    TString& s = commonBuiltins;
-
     for (int xRows = 1; xRows <=4; xRows++) {
         for (int xCols = 1; xCols <=4; xCols++) {
             const int yRows = xCols;
@@ -455,541 +1017,19 @@ void TBuiltInParseablesHlsl::createMatTimesMat()
 //
 void TBuiltInParseablesHlsl::initialize(int /*version*/, EProfile /*profile*/, const SpvVersion& /*spvVersion*/)
 {
-    static const EShLanguageMask EShLangAll    = EShLanguageMask(EShLangCount - 1);
-
-    // These are the actual stage masks defined in the documentation, in case they are
-    // needed for future validation.  For now, they are commented out, and set below
-    // to EShLangAll, to allow any intrinsic to be used in any shader, which is legal
-    // if it is not called.
-    //
-    // static const EShLanguageMask EShLangPSCS   = EShLanguageMask(EShLangFragmentMask | EShLangComputeMask);
-    // static const EShLanguageMask EShLangVSPSGS = EShLanguageMask(EShLangVertexMask | EShLangFragmentMask | EShLangGeometryMask);
-    // static const EShLanguageMask EShLangCS     = EShLangComputeMask;
-    // static const EShLanguageMask EShLangPS     = EShLangFragmentMask;
-    // static const EShLanguageMask EShLangHS     = EShLangTessControlMask;
-
-    // This set uses EShLangAll for everything.
-    static const EShLanguageMask EShLangPSCS   = EShLangAll;
-    static const EShLanguageMask EShLangVSPSGS = EShLangAll;
-    static const EShLanguageMask EShLangCS     = EShLangAll;
-    static const EShLanguageMask EShLangPS     = EShLangAll;
-    static const EShLanguageMask EShLangHS     = EShLangAll;
-    static const EShLanguageMask EShLangGS     = EShLangAll;
-
-    // This structure encodes the prototype information for each HLSL intrinsic.
-    // Because explicit enumeration would be cumbersome, it's procedurally generated.
-    // orderKey can be:
-    //   S = scalar, V = vector, M = matrix, - = void
-    // typekey can be:
-    //   D = double, F = float, U = uint, I = int, B = bool, S = sampler, s = shadowSampler, M = uint64_t, L = int64_t
-    // An empty order or type key repeats the first one.  E.g: SVM,, means 3 args each of SVM.
-    // '>' as first letter of order creates an output parameter
-    // '<' as first letter of order creates an input parameter
-    // '^' as first letter of order takes transpose dimensions
-    // '%' as first letter of order creates texture of given F/I/U type (texture, itexture, etc)
-    // '@' as first letter of order creates arrayed texture of given type
-    // '$' / '&' as first letter of order creates 2DMS / 2DMSArray textures
-    // '*' as first letter of order creates buffer object
-    // '!' as first letter of order creates image object
-    // '#' as first letter of order creates arrayed image object
-    // '~' as first letter of order creates an image buffer object
-    // '[' / ']' as first letter of order creates a SubpassInput/SubpassInputMS object
-
-    static const struct {
-        const char*   name;      // intrinsic name
-        const char*   retOrder;  // return type key: empty matches order of 1st argument
-        const char*   retType;   // return type key: empty matches type of 1st argument
-        const char*   argOrder;  // argument order key
-        const char*   argType;   // argument type key
-        unsigned int  stage;     // stage mask
-        bool          method;    // true if it's a method.
-    } hlslIntrinsics[] = {
-        // name                               retOrd   retType    argOrder          argType          stage mask     method
-        // ----------------------------------------------------------------------------------------------------------------
-        { "abort",                            nullptr, nullptr,   "-",              "-",             EShLangAll,    false },
-        { "abs",                              nullptr, nullptr,   "SVM",            "DFUI",          EShLangAll,    false },
-        { "acos",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "all",                              "S",    "B",        "SVM",            "BFIU",          EShLangAll,    false },
-        { "AllMemoryBarrier",                 nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
-        { "AllMemoryBarrierWithGroupSync",    nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
-        { "any",                              "S",     "B",       "SVM",            "BFIU",          EShLangAll,    false },
-        { "asdouble",                         "S",     "D",       "S,",             "UI,",           EShLangAll,    false },
-        { "asdouble",                         "V2",    "D",       "V2,",            "UI,",           EShLangAll,    false },
-        { "asfloat",                          nullptr, "F",       "SVM",            "BFIU",          EShLangAll,    false },
-        { "asin",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "asint",                            nullptr, "I",       "SVM",            "FIU",           EShLangAll,    false },
-        { "asuint",                           nullptr, "U",       "SVM",            "FIU",           EShLangAll,    false },
-        { "atan",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "atan2",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "ceil",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "CheckAccessFullyMapped",           "S",     "B" ,      "S",              "U",             EShLangPSCS,   false },
-        { "clamp",                            nullptr, nullptr,   "SVM,,",          "FUI,,",         EShLangAll,    false },
-        { "clip",                             "-",     "-",       "SVM",            "FUI",           EShLangPS,     false },
-        { "cos",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "cosh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "countbits",                        nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
-        { "cross",                            nullptr, nullptr,   "V3,",            "F,",            EShLangAll,    false },
-        { "D3DCOLORtoUBYTE4",                 "V4",    "I",       "V4",             "F",             EShLangAll,    false },
-        { "ddx",                              nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "ddx_coarse",                       nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "ddx_fine",                         nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "ddy",                              nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "ddy_coarse",                       nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "ddy_fine",                         nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "degrees",                          nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "determinant",                      "S",     "F",       "M",              "F",             EShLangAll,    false },
-        { "DeviceMemoryBarrier",              nullptr, nullptr,   "-",              "-",             EShLangPSCS,   false },
-        { "DeviceMemoryBarrierWithGroupSync", nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
-        { "distance",                         "S",     "F",       "SV,",            "F,",            EShLangAll,    false },
-        { "dot",                              "S",     nullptr,   "SV,",            "FI,",           EShLangAll,    false },
-        { "dst",                              nullptr, nullptr,   "V4,",            "F,",            EShLangAll,    false },
-        // { "errorf",                           "-",     "-",       "",             "",             EShLangAll,    false }, TODO: varargs
-        { "EvaluateAttributeAtCentroid",      nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "EvaluateAttributeAtSample",        nullptr, nullptr,   "SVM,S",          "F,U",           EShLangPS,     false },
-        { "EvaluateAttributeSnapped",         nullptr, nullptr,   "SVM,V2",         "F,I",           EShLangPS,     false },
-        { "exp",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "exp2",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "f16tof32",                         nullptr, "F",       "SV",             "U",             EShLangAll,    false },
-        { "f32tof16",                         nullptr, "U",       "SV",             "F",             EShLangAll,    false },
-        { "faceforward",                      nullptr, nullptr,   "V,,",            "F,,",           EShLangAll,    false },
-        { "firstbithigh",                     nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
-        { "firstbitlow",                      nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
-        { "floor",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "fma",                              nullptr, nullptr,   "SVM,,",          "D,,",           EShLangAll,    false },
-        { "fmod",                             nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "frac",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "frexp",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "fwidth",                           nullptr, nullptr,   "SVM",            "F",             EShLangPS,     false },
-        { "GetRenderTargetSampleCount",       "S",     "U",       "-",              "-",             EShLangAll,    false },
-        { "GetRenderTargetSamplePosition",    "V2",    "F",       "V1",             "I",             EShLangAll,    false },
-        { "GroupMemoryBarrier",               nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
-        { "GroupMemoryBarrierWithGroupSync",  nullptr, nullptr,   "-",              "-",             EShLangCS,     false },
-        { "InterlockedAdd",                   "-",     "-",       "SVM,,>",         "FUI,,",          EShLangPSCS,   false },
-        { "InterlockedAdd",                   "-",     "-",       "SVM,",           "FUI,",           EShLangPSCS,   false },
-        { "InterlockedAnd",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedAnd",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
-        { "InterlockedCompareExchange",       "-",     "-",       "SVM,,,>",        "UI,,,",         EShLangPSCS,   false },
-        { "InterlockedCompareStore",          "-",     "-",       "SVM,,",          "UI,,",          EShLangPSCS,   false },
-        { "InterlockedExchange",              "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedMax",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedMax",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
-        { "InterlockedMin",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedMin",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
-        { "InterlockedOr",                    "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedOr",                    "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
-        { "InterlockedXor",                   "-",     "-",       "SVM,,>",         "UI,,",          EShLangPSCS,   false },
-        { "InterlockedXor",                   "-",     "-",       "SVM,",           "UI,",           EShLangPSCS,   false },
-        { "isfinite",                         nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
-        { "isinf",                            nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
-        { "isnan",                            nullptr, "B" ,      "SVM",            "F",             EShLangAll,    false },
-        { "ldexp",                            nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "length",                           "S",     "F",       "SV",             "F",             EShLangAll,    false },
-        { "lerp",                             nullptr, nullptr,   "VM,,",           "F,,",           EShLangAll,    false },
-        { "lerp",                             nullptr, nullptr,   "SVM,,S",         "F,,",           EShLangAll,    false },
-        { "lit",                              "V4",    "F",       "S,,",            "F,,",           EShLangAll,    false },
-        { "log",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "log10",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "log2",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "mad",                              nullptr, nullptr,   "SVM,,",          "DFUI,,",        EShLangAll,    false },
-        { "max",                              nullptr, nullptr,   "SVM,",           "FIU,",          EShLangAll,    false },
-        { "min",                              nullptr, nullptr,   "SVM,",           "FIU,",          EShLangAll,    false },
-        { "modf",                             nullptr, nullptr,   "SVM,>",          "FIU,",          EShLangAll,    false },
-        { "msad4",                            "V4",    "U",       "S,V2,V4",        "U,,",           EShLangAll,    false },
-        { "mul",                              "S",     nullptr,   "S,S",            "FI,",           EShLangAll,    false },
-        { "mul",                              "V",     nullptr,   "S,V",            "FI,",           EShLangAll,    false },
-        { "mul",                              "M",     nullptr,   "S,M",            "FI,",           EShLangAll,    false },
-        { "mul",                              "V",     nullptr,   "V,S",            "FI,",           EShLangAll,    false },
-        { "mul",                              "S",     nullptr,   "V,V",            "FI,",           EShLangAll,    false },
-        { "mul",                              "M",     nullptr,   "M,S",            "FI,",           EShLangAll,    false },
-        // mat*mat form of mul is handled in createMatTimesMat()
-        { "noise",                            "S",     "F",       "V",              "F",             EShLangPS,     false },
-        { "normalize",                        nullptr, nullptr,   "V",              "F",             EShLangAll,    false },
-        { "pow",                              nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "printf",                           nullptr, nullptr,   "-",              "-",             EShLangAll,    false },
-        { "Process2DQuadTessFactorsAvg",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
-        { "Process2DQuadTessFactorsMax",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
-        { "Process2DQuadTessFactorsMin",      "-",     "-",       "V4,V2,>V4,>V2,", "F,,,,",         EShLangHS,     false },
-        { "ProcessIsolineTessFactors",        "-",     "-",       "S,,>,>",         "F,,,",          EShLangHS,     false },
-        { "ProcessQuadTessFactorsAvg",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
-        { "ProcessQuadTessFactorsMax",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
-        { "ProcessQuadTessFactorsMin",        "-",     "-",       "V4,S,>V4,>V2,",  "F,,,,",         EShLangHS,     false },
-        { "ProcessTriTessFactorsAvg",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
-        { "ProcessTriTessFactorsMax",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
-        { "ProcessTriTessFactorsMin",         "-",     "-",       "V3,S,>V3,>S,",   "F,,,,",         EShLangHS,     false },
-        { "radians",                          nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "rcp",                              nullptr, nullptr,   "SVM",            "FD",            EShLangAll,    false },
-        { "reflect",                          nullptr, nullptr,   "V,",             "F,",            EShLangAll,    false },
-        { "refract",                          nullptr, nullptr,   "V,V,S",          "F,,",           EShLangAll,    false },
-        { "reversebits",                      nullptr, nullptr,   "SV",             "UI",            EShLangAll,    false },
-        { "round",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "rsqrt",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "saturate",                         nullptr, nullptr ,  "SVM",            "F",             EShLangAll,    false },
-        { "sign",                             nullptr, nullptr,   "SVM",            "FI",            EShLangAll,    false },
-        { "sin",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "sincos",                           "-",     "-",       "SVM,>,>",        "F,,",           EShLangAll,    false },
-        { "sinh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "smoothstep",                       nullptr, nullptr,   "SVM,,",          "F,,",           EShLangAll,    false },
-        { "sqrt",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "step",                             nullptr, nullptr,   "SVM,",           "F,",            EShLangAll,    false },
-        { "tan",                              nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "tanh",                             nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-        { "tex1D",                            "V4",    "F",       "S,S",            "S,F",           EShLangPS,     false },
-        { "tex1D",                            "V4",    "F",       "S,S,V1,",        "S,F,,",         EShLangPS,     false },
-        { "tex1Dbias",                        "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
-        { "tex1Dgrad",                        "V4",    "F",       "S,,,",           "S,F,,",         EShLangPS,     false },
-        { "tex1Dlod",                         "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
-        { "tex1Dproj",                        "V4",    "F",       "S,V4",           "S,F",           EShLangPS,     false },
-        { "tex2D",                            "V4",    "F",       "V2,",            "S,F",           EShLangPS,     false },
-        { "tex2D",                            "V4",    "F",       "V2,,,",          "S,F,,",         EShLangPS,     false },
-        { "tex2Dbias",                        "V4",    "F",       "V2,V4",          "S,F",           EShLangPS,     false },
-        { "tex2Dgrad",                        "V4",    "F",       "V2,,,",          "S,F,,",         EShLangPS,     false },
-        { "tex2Dlod",                         "V4",    "F",       "V2,V4",          "S,F",           EShLangAll,    false },
-        { "tex2Dproj",                        "V4",    "F",       "V2,V4",          "S,F",           EShLangPS,     false },
-        { "tex3D",                            "V4",    "F",       "V3,",            "S,F",           EShLangPS,     false },
-        { "tex3D",                            "V4",    "F",       "V3,,,",          "S,F,,",         EShLangPS,     false },
-        { "tex3Dbias",                        "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
-        { "tex3Dgrad",                        "V4",    "F",       "V3,,,",          "S,F,,",         EShLangPS,     false },
-        { "tex3Dlod",                         "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
-        { "tex3Dproj",                        "V4",    "F",       "V3,V4",          "S,F",           EShLangPS,     false },
-        { "texCUBE",                          "V4",    "F",       "V4,V3",          "S,F",           EShLangPS,     false },
-        { "texCUBE",                          "V4",    "F",       "V4,V3,,",        "S,F,,",         EShLangPS,     false },
-        { "texCUBEbias",                      "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
-        { "texCUBEgrad",                      "V4",    "F",       "V4,V3,,",        "S,F,,",         EShLangPS,     false },
-        { "texCUBElod",                       "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
-        { "texCUBEproj",                      "V4",    "F",       "V4,",            "S,F",           EShLangPS,     false },
-        { "transpose",                        "^M",    nullptr,   "M",              "FUIB",          EShLangAll,    false },
-        { "trunc",                            nullptr, nullptr,   "SVM",            "F",             EShLangAll,    false },
-
-        // Texture object methods.  Return type can be overridden by shader declaration.
-        // !O = no offset, O = offset
-        { "Sample",             /*!O*/        "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangPS,    true },
-        { "Sample",             /* O*/        "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangPS,    true },
-
-        { "SampleBias",         /*!O*/        "V4",    nullptr,   "%@,S,V,S",       "FIU,S,F,F",      EShLangPS,    true },
-        { "SampleBias",         /* O*/        "V4",    nullptr,   "%@,S,V,S,V",     "FIU,S,F,F,I",    EShLangPS,    true },
-
-        // TODO: FXC accepts int/uint samplers here.  unclear what that means.
-        { "SampleCmp",          /*!O*/        "S",     "F",       "%@,S,V,S",       "FIU,s,F,",       EShLangPS,    true },
-        { "SampleCmp",          /* O*/        "S",     "F",       "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangPS,    true },
-
-        // TODO: FXC accepts int/uint samplers here.  unclear what that means.
-        { "SampleCmpLevelZero", /*!O*/        "S",     "F",       "%@,S,V,S",       "FIU,s,F,F",      EShLangPS,    true },
-        { "SampleCmpLevelZero", /* O*/        "S",     "F",       "%@,S,V,S,V",     "FIU,s,F,F,I",    EShLangPS,    true },
-
-        { "SampleGrad",         /*!O*/        "V4",    nullptr,   "%@,S,V,,",       "FIU,S,F,,",      EShLangAll,   true },
-        { "SampleGrad",         /* O*/        "V4",    nullptr,   "%@,S,V,,,",      "FIU,S,F,,,I",    EShLangAll,   true },
-
-        { "SampleLevel",        /*!O*/        "V4",    nullptr,   "%@,S,V,S",       "FIU,S,F,",       EShLangAll,   true },
-        { "SampleLevel",        /* O*/        "V4",    nullptr,   "%@,S,V,S,V",     "FIU,S,F,,I",     EShLangAll,   true },
-
-        { "Load",               /*!O*/        "V4",    nullptr,   "%@,V",           "FIU,I",          EShLangAll,   true },
-        { "Load",               /* O*/        "V4",    nullptr,   "%@,V,V",         "FIU,I,I",        EShLangAll,   true },
-        { "Load", /* +sampleidex*/            "V4",    nullptr,   "$&,V,S",         "FIU,I,I",        EShLangAll,   true },
-        { "Load", /* +samplindex, offset*/    "V4",    nullptr,   "$&,V,S,V",       "FIU,I,I,I",      EShLangAll,   true },
-
-        // RWTexture loads
-        { "Load",                             "V4",    nullptr,   "!#,V",           "FIU,I",          EShLangAll,   true },
-        // (RW)Buffer loads
-        { "Load",                             "V4",    nullptr,   "~*1,V",          "FIU,I",          EShLangAll,   true },
-
-        { "Gather",             /*!O*/        "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
-        { "Gather",             /* O*/        "V4",    nullptr,   "%@,S,V,V",       "FIU,S,F,I",      EShLangAll,   true },
-
-        { "CalculateLevelOfDetail",           "S",     "F",       "%@,S,V",         "FUI,S,F",        EShLangPS,    true },
-        { "CalculateLevelOfDetailUnclamped",  "S",     "F",       "%@,S,V",         "FUI,S,F",        EShLangPS,    true },
-
-        { "GetSamplePosition",                "V2",    "F",       "$&2,S",          "FUI,I",          EShLangVSPSGS,true },
-
-        //
-        // UINT Width
-        // UINT MipLevel, UINT Width, UINT NumberOfLevels
-        { "GetDimensions",   /* 1D */         "-",     "-",       "%!~1,>S",        "FUI,U",          EShLangAll,   true },
-        { "GetDimensions",   /* 1D */         "-",     "-",       "%!~1,>S",        "FUI,F",          EShLangAll,   true },
-        { "GetDimensions",   /* 1D */         "-",     "-",       "%1,S,>S,",       "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 1D */         "-",     "-",       "%1,S,>S,",       "FUI,U,F,",       EShLangAll,   true },
-
-        // UINT Width, UINT Elements
-        // UINT MipLevel, UINT Width, UINT Elements, UINT NumberOfLevels
-        { "GetDimensions",   /* 1DArray */    "-",     "-",       "@#1,>S,",        "FUI,U,",         EShLangAll,   true },
-        { "GetDimensions",   /* 1DArray */    "-",     "-",       "@#1,>S,",        "FUI,F,",         EShLangAll,   true },
-        { "GetDimensions",   /* 1DArray */    "-",     "-",       "@1,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
-        { "GetDimensions",   /* 1DArray */    "-",     "-",       "@1,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
-
-        // UINT Width, UINT Height
-        // UINT MipLevel, UINT Width, UINT Height, UINT NumberOfLevels
-        { "GetDimensions",   /* 2D */         "-",     "-",       "%!2,>S,",        "FUI,U,",         EShLangAll,   true },
-        { "GetDimensions",   /* 2D */         "-",     "-",       "%!2,>S,",        "FUI,F,",         EShLangAll,   true },
-        { "GetDimensions",   /* 2D */         "-",     "-",       "%2,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
-        { "GetDimensions",   /* 2D */         "-",     "-",       "%2,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
-
-        // UINT Width, UINT Height, UINT Elements
-        // UINT MipLevel, UINT Width, UINT Height, UINT Elements, UINT NumberOfLevels
-        { "GetDimensions",   /* 2DArray */    "-",     "-",       "@#2,>S,,",       "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 2DArray */    "-",     "-",       "@#2,>S,,",       "FUI,F,F,F",      EShLangAll,   true },
-        { "GetDimensions",   /* 2DArray */    "-",     "-",       "@2,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
-        { "GetDimensions",   /* 2DArray */    "-",     "-",       "@2,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
-
-        // UINT Width, UINT Height, UINT Depth
-        // UINT MipLevel, UINT Width, UINT Height, UINT Depth, UINT NumberOfLevels
-        { "GetDimensions",   /* 3D */         "-",     "-",       "%!3,>S,,",       "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 3D */         "-",     "-",       "%!3,>S,,",       "FUI,F,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 3D */         "-",     "-",       "%3,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
-        { "GetDimensions",   /* 3D */         "-",     "-",       "%3,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
-
-        // UINT Width, UINT Height
-        // UINT MipLevel, UINT Width, UINT Height, UINT NumberOfLevels
-        { "GetDimensions",   /* Cube */       "-",     "-",       "%4,>S,",         "FUI,U,",         EShLangAll,   true },
-        { "GetDimensions",   /* Cube */       "-",     "-",       "%4,>S,",         "FUI,F,",         EShLangAll,   true },
-        { "GetDimensions",   /* Cube */       "-",     "-",       "%4,S,>S,,",      "FUI,U,,,",       EShLangAll,   true },
-        { "GetDimensions",   /* Cube */       "-",     "-",       "%4,S,>S,,",      "FUI,U,F,,",      EShLangAll,   true },
-
-        // UINT Width, UINT Height, UINT Elements
-        // UINT MipLevel, UINT Width, UINT Height, UINT Elements, UINT NumberOfLevels
-        { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,>S,,",        "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,>S,,",        "FUI,F,,",        EShLangAll,   true },
-        { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,S,>S,,,",     "FUI,U,,,,",      EShLangAll,   true },
-        { "GetDimensions",   /* CubeArray */  "-",     "-",       "@4,S,>S,,,",     "FUI,U,F,,,",     EShLangAll,   true },
-
-        // UINT Width, UINT Height, UINT Samples
-        // UINT Width, UINT Height, UINT Elements, UINT Samples
-        { "GetDimensions",   /* 2DMS */       "-",     "-",       "$2,>S,,",        "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 2DMS */       "-",     "-",       "$2,>S,,",        "FUI,U,,",        EShLangAll,   true },
-        { "GetDimensions",   /* 2DMSArray */  "-",     "-",       "&2,>S,,,",       "FUI,U,,,",       EShLangAll,   true },
-        { "GetDimensions",   /* 2DMSArray */  "-",     "-",       "&2,>S,,,",       "FUI,U,,,",       EShLangAll,   true },
-
-        // SM5 texture methods
-        { "GatherRed",       /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
-        { "GatherRed",       /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
-        { "GatherRed",       /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
-        { "GatherRed",       /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
-        { "GatherRed",       /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
-
-        { "GatherGreen",     /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
-        { "GatherGreen",     /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
-        { "GatherGreen",     /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
-        { "GatherGreen",     /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
-        { "GatherGreen",     /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
-
-        { "GatherBlue",      /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
-        { "GatherBlue",      /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
-        { "GatherBlue",      /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
-        { "GatherBlue",      /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
-        { "GatherBlue",      /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
-
-        { "GatherAlpha",     /*!O*/           "V4",    nullptr,   "%@,S,V",         "FIU,S,F",        EShLangAll,   true },
-        { "GatherAlpha",     /* O*/           "V4",    nullptr,   "%@,S,V,",        "FIU,S,F,I",      EShLangAll,   true },
-        { "GatherAlpha",     /* O, status*/   "V4",    nullptr,   "%@,S,V,,>S",     "FIU,S,F,I,U",    EShLangAll,   true },
-        { "GatherAlpha",     /* O-4 */        "V4",    nullptr,   "%@,S,V,,,,",     "FIU,S,F,I,,,",   EShLangAll,   true },
-        { "GatherAlpha",     /* O-4, status */"V4",    nullptr,   "%@,S,V,,,,,S",   "FIU,S,F,I,,,,U", EShLangAll,   true },
-
-        { "GatherCmp",       /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
-        { "GatherCmp",       /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
-        { "GatherCmp",       /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
-        { "GatherCmp",       /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
-        { "GatherCmp",       /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,V,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
-
-        { "GatherCmpRed",    /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
-        { "GatherCmpRed",    /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
-        { "GatherCmpRed",    /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
-        { "GatherCmpRed",    /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
-        { "GatherCmpRed",    /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,V,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
-
-        { "GatherCmpGreen",  /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
-        { "GatherCmpGreen",  /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
-        { "GatherCmpGreen",  /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
-        { "GatherCmpGreen",  /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
-        { "GatherCmpGreen",  /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
-
-        { "GatherCmpBlue",   /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
-        { "GatherCmpBlue",   /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
-        { "GatherCmpBlue",   /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
-        { "GatherCmpBlue",   /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
-        { "GatherCmpBlue",   /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
-
-        { "GatherCmpAlpha",  /*!O*/           "V4",    nullptr,   "%@,S,V,S",       "FIU,s,F,",       EShLangAll,   true },
-        { "GatherCmpAlpha",  /* O*/           "V4",    nullptr,   "%@,S,V,S,V",     "FIU,s,F,,I",     EShLangAll,   true },
-        { "GatherCmpAlpha",  /* O, status*/   "V4",    nullptr,   "%@,S,V,S,V,>S",  "FIU,s,F,,I,U",   EShLangAll,   true },
-        { "GatherCmpAlpha",  /* O-4 */        "V4",    nullptr,   "%@,S,V,S,V,,,",  "FIU,s,F,,I,,,",  EShLangAll,   true },
-        { "GatherCmpAlpha",  /* O-4, status */"V4",    nullptr,   "%@,S,V,S,V,,,,S","FIU,s,F,,I,,,,U",EShLangAll,   true },
-
-        // geometry methods
-        { "Append",                           "-",     "-",       "-",              "-",              EShLangGS ,   true },
-        { "RestartStrip",                     "-",     "-",       "-",              "-",              EShLangGS ,   true },
-
-        // Methods for structurebuffers.  TODO: wildcard type matching.
-        { "Load",                             nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Load2",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Load3",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Load4",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Store",                            nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Store2",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Store3",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Store4",                           nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "GetDimensions",                    nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedAdd",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedAnd",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedCompareExchange",       nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedCompareStore",          nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedExchange",              nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedMax",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedMin",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedOr",                    nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "InterlockedXor",                   nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "IncrementCounter",                 nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "DecrementCounter",                 nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-        { "Consume",                          nullptr, nullptr,   "-",              "-",              EShLangAll,   true },
-
-        // SM 6.0
-
-        { "WaveIsFirstLane",                  "S",     "B",       "-",              "-",              EShLangPSCS,  false},
-        { "WaveGetLaneCount",                 "S",     "U",       "-",              "-",              EShLangPSCS,  false},
-        { "WaveGetLaneIndex",                 "S",     "U",       "-",              "-",              EShLangPSCS,  false},
-        { "WaveActiveAnyTrue",                "S",     "B",       "S",              "B",              EShLangPSCS,  false},
-        { "WaveActiveAllTrue",                "S",     "B",       "S",              "B",              EShLangPSCS,  false},
-        { "WaveActiveBallot",                 "V4",    "U",       "S",              "B",              EShLangPSCS,  false},
-        { "WaveReadLaneAt",                   nullptr, nullptr,   "SV,S",           "DFUI,U",         EShLangPSCS,  false},
-        { "WaveReadLaneFirst",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveAllEqual",               "S",     "B",       "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveAllEqualBool",           "S",     "B",       "S",              "B",              EShLangPSCS,  false},
-        { "WaveActiveCountBits",              "S",     "U",       "S",              "B",              EShLangPSCS,  false},
-
-        { "WaveActiveSum",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveProduct",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveBitAnd",                 nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveBitOr",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveBitXor",                 nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveMin",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WaveActiveMax",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WavePrefixSum",                    nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WavePrefixProduct",                nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "WavePrefixCountBits",              "S",     "U",       "S",              "B",              EShLangPSCS,  false},
-        { "QuadReadAcrossX",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "QuadReadAcrossY",                  nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "QuadReadAcrossDiagonal",           nullptr, nullptr,   "SV",             "DFUI",           EShLangPSCS,  false},
-        { "QuadReadLaneAt",                   nullptr, nullptr,   "SV,S",           "DFUI,U",         EShLangPSCS,  false},
-
-        // Methods for subpass input objects
-        { "SubpassLoad",                      "V4",    nullptr,   "[",              "FIU",            EShLangPS,    true },
-        { "SubpassLoad",                      "V4",    nullptr,   "],S",            "FIU,I",          EShLangPS,    true },
-
-        // Mark end of list, since we want to avoid a range-based for, as some compilers don't handle it yet.
-        { nullptr,                            nullptr, nullptr,   nullptr,      nullptr,  0, false },
-    };
-
-    // Create prototypes for the intrinsics.  TODO: Avoid ranged based for until all compilers can handle it.
+    // The intrinsics available to every stage are many, and a shader calls few of them,
+    // so they are not parsed up front; see findLazyFunction().
     for (int icount = 0; hlslIntrinsics[icount].name; ++icount) {
-        const auto& intrinsic = hlslIntrinsics[icount];
-
-        for (int stage = 0; stage < EShLangCount; ++stage) {                                // for each stage...
-            if ((intrinsic.stage & (1<<stage)) == 0) // skip inapplicable stages
-                continue;
-
-            // reference to either the common builtins, or stage specific builtins.
-            TString& s = (intrinsic.stage == EShLangAll) ? commonBuiltins : stageBuiltins[stage];
-
-            for (const char* argOrder = intrinsic.argOrder; !IsEndOfArg(argOrder); ++argOrder) { // for each order...
-                const bool isTexture   = IsTextureType(*argOrder);
-                const bool isArrayed   = IsArrayed(*argOrder);
-                const bool isMS        = IsTextureMS(*argOrder);
-                const bool isBuffer    = IsBuffer(*argOrder);
-                const bool isImage     = IsImage(*argOrder);
-                const bool mipInCoord  = HasMipInCoord(intrinsic.name, isMS, isBuffer, isImage);
-                const int fixedVecSize = FixedVecSize(argOrder);
-                const int coordArg     = CoordinateArgPos(intrinsic.name, isTexture);
-
-                // calculate min and max vector and matrix dimensions
-                int dim0Min = 1;
-                int dim0Max = 1;
-                int dim1Min = 1;
-                int dim1Max = 1;
-
-                FindVectorMatrixBounds(argOrder, fixedVecSize, dim0Min, dim0Max, dim1Min, dim1Max);
-
-                for (const char* argType = intrinsic.argType; !IsEndOfArg(argType); ++argType) { // for each type...
-                    for (int dim0 = dim0Min; dim0 <= dim0Max; ++dim0) {          // for each dim 0...
-                        for (int dim1 = dim1Min; dim1 <= dim1Max; ++dim1) {      // for each dim 1...
-                            const char* retOrder = intrinsic.retOrder ? intrinsic.retOrder : argOrder;
-                            const char* retType  = intrinsic.retType  ? intrinsic.retType  : argType;
-
-                            if (!IsValid(intrinsic.name, *retOrder, *retType, *argOrder, *argType, dim0, dim1))
-                                continue;
-
-                            // Reject some forms of sample methods that don't exist.
-                            if (isTexture && IsIllegalSample(intrinsic.name, argOrder, dim0))
-                                continue;
-
-                            AppendTypeName(s, retOrder, retType, dim0, dim1);  // add return type
-                            s.append(" ");                                     // space between type and name
+        const TIntrinsic& intrinsic = hlslIntrinsics[icount];
+        if (intrinsic.stage == EShLangAll)
+            continue;
 
-                            // methods have a prefix.  TODO: it would be better as an invalid identifier character,
-                            // but that requires a scanner change.
-                            if (intrinsic.method)
-                                s.append(BUILTIN_PREFIX);
-
-                            s.append(intrinsic.name);                          // intrinsic name
-                            s.append("(");                                     // open paren
-
-                            const char* prevArgOrder = nullptr;
-                            const char* prevArgType = nullptr;
-
-                            // Append argument types, if any.
-                            for (int arg = 0; ; ++arg) {
-                                const char* nthArgOrder(NthArg(argOrder, arg));
-                                const char* nthArgType(NthArg(argType, arg));
-
-                                if (nthArgOrder == nullptr || nthArgType == nullptr)
-                                    break;
-
-                                // cube textures use vec3 coordinates
-                                int argDim0 = isTexture && arg > 0 ? std::min(dim0, 3) : dim0;
-
-                                s.append(arg > 0 ? ", ": "");  // comma separator if needed
-
-                                const char* orderBegin = nthArgOrder;
-                                nthArgOrder = IoParam(s, nthArgOrder);
-
-                                // Comma means use the previous argument order and type.
-                                HandleRepeatArg(nthArgOrder, prevArgOrder, orderBegin);
-                                HandleRepeatArg(nthArgType,  prevArgType, nthArgType);
-
-                                // In case the repeated arg has its own I/O marker
-                                nthArgOrder = IoParam(s, nthArgOrder);
-
-                                // arrayed textures have one extra coordinate dimension, except for
-                                // the CalculateLevelOfDetail family.
-                                if (isArrayed && arg == coordArg && !NoArrayCoord(intrinsic.name))
-                                    argDim0++;
-
-                                // Some texture methods use an addition arg dimension to hold mip
-                                if (arg == coordArg && mipInCoord)
-                                    argDim0++;
-
-                                // For textures, the 1D case isn't a 1-vector, but a scalar.
-                                if (isTexture && argDim0 == 1 && arg > 0 && *nthArgOrder == 'V')
-                                    nthArgOrder = "S";
-
-                                AppendTypeName(s, nthArgOrder, nthArgType, argDim0, dim1); // Add arguments
-                            }
-
-                            s.append(");\n");            // close paren and trailing semicolon
-                        } // dim 1 loop
-                    } // dim 0 loop
-                } // arg type loop
-
-                // skip over special characters
-                if (isTexture && isalpha(argOrder[1]))
-                    ++argOrder;
-                if (isdigit(argOrder[1]))
-                    ++argOrder;
-            } // arg order loop
-
-            if (intrinsic.stage == EShLangAll) // common builtins are only added once.
-                break;
+        for (int stage = 0; stage < EShLangCount; ++stage) {
+            if ((intrinsic.stage & (1<<stage)) != 0)
+                AppendIntrinsic(stageBuiltins[stage], intrinsic);
         }
     }
 
-    createMatTimesMat(); // handle this case separately, for convenience
-
     // printf("Common:\n%s\n",   getCommonString().c_str());
     // printf("Frag:\n%s\n",     getStageString(EShLangFragment).c_str());
     // printf("Vertex:\n%s\n",   getStageString(EShLangVertex).c_str());
@@ -999,6 +1039,34 @@ void TBuiltInParseablesHlsl::initialize(int /*version*/, EProfile /*profile*/, c
     // printf("Compute:\n%s\n",  getStageString(EShLangCompute).c_str());
 }
 
+//
+// The intrinsics available to every stage are generated one name at a time: the
+// overloads of a name are only prototyped, parsed, and identified the first time
+// a compile looks that name up.
+//
+int TBuiltInParseablesHlsl::getLazyFunctionCount() const
+{
+    return (int)GetLazyIntrinsics().names.size();
+}
+
+int TBuiltInParseablesHlsl::findLazyFunction(const char* name, size_t length) const
+{
+    const TLazyIntrinsics& lazyIntrinsics = GetLazyIntrinsics();
+    auto found = lazyIntrinsics.byName.find(std::string_view(name, length));
+
+    return found != lazyIntrinsics.byName.end() ? found->second : -1;
+}
+
+void TBuiltInParseablesHlsl::appendLazyFunction(int index, TString& prototypes) const
+{
+    const TLazyIntrinsics& lazyIntrinsics = GetLazyIntrinsics();
+    for (int icount : lazyIntrinsics.entries[index])
+        AppendIntrinsic(prototypes, hlslIntrinsics[icount]);
+
+    if (lazyIntrinsics.names[index] == "mul")
+        createMatTimesMat(prototypes); // handle this case separately, for convenience
+}
+
 //
 // Add context-dependent built-in functions and variables that are present
 // for the given version and profile.  All the results are put into just the
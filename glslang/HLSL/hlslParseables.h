@@ -55,8 +55,12 @@ public:
 
     void identifyBuiltIns(int version, EProfile profile, const SpvVersion& spvVersion, EShLanguage language, TSymbolTable& symbolTable, const TBuiltInResource &resources);
 
+    int getLazyFunctionCount() const;
+    int findLazyFunction(const char* name, size_t length) const;
+    void appendLazyFunction(int index, TString& prototypes) const;
+
 private:
-    void createMatTimesMat();
+    void createMatTimesMat(TString& s) const;
 };
 
 } // end namespace glslang
@@ -69,6 +69,8 @@
 
 namespace glslang {
 
+struct TMemoryStats;
+
 // If we are using guard blocks, we must track each individual
 // allocation.  If we aren't using guard blocks, these
 // never get instantiated, so won't have any impact.
@@ -143,17 +145,20 @@ private:
 // repositories of free pages or used pages.
 //
 // Page stacks are linked together with a simple header at the beginning
-// of each allocation obtained from the underlying OS.  Multi-page allocations
-// are returned to the OS.  Individual page allocations are kept for future
-// re-use.
+// of each allocation obtained from the underlying OS.  Allocations too big
+// for a page get a block of their own, which is returned to the OS when
+// popped.  Pages are kept for future re-use.
 //
 // The "page size" used is not, nor must it match, the underlying OS
 // page size.  But, having it be about that size or equal to a set of
-// pages is likely most optimal.
+// pages is likely most optimal.  Each page obtained from the OS is twice
+// the size of the one before, up to maxGrowthIncrement, so a large compile
+// takes a few big pages rather than many small ones.
 //
 class TPoolAllocator {
 public:
-    TPoolAllocator(int growthIncrement = 8*1024, int allocationAlignment = 16);
+    TPoolAllocator(int growthIncrement = 8*1024, int allocationAlignment = 16,
+                   int maxGrowthIncrement = 128*1024);
 
     //
     // Don't call the destructor just to free up the memory, call pop()
@@ -184,6 +189,17 @@ public:
     GLSLANG_EXPORT_FOR_TESTS
     void* allocate(size_t numBytes);
 
+    //
+    // Memory currently held from the OS, whether in use or kept on the
+    // free list for reuse.
+    //
+    size_t getBytesReserved() const { return bytesReserved; }
+
+    //
+    // Fill in what the pool has done so far.
+    //
+    void getStats(TMemoryStats&) const;
+
     //
     // There is no deallocate.  The point of this class is that
     // deallocation can be skipped by the user of it, as the model
@@ -195,11 +211,11 @@ protected:
     friend struct tHeader;
 
     struct tHeader {
-        tHeader(tHeader* nextPage, size_t pageCount) :
+        tHeader(tHeader* nextPage, size_t size, bool large) :
 #ifdef GUARD_BLOCKS
         lastAllocation(nullptr),
 #endif
-        nextPage(nextPage), pageCount(pageCount) { }
+        nextPage(nextPage), size(size), large(large) { }
 
         ~tHeader() {
 #ifdef GUARD_BLOCKS
@@ -212,12 +228,15 @@ protected:
         TAllocation* lastAllocation;
 #endif
         tHeader* nextPage;
-        size_t pageCount;
+        size_t size;            // bytes obtained from the OS, including this header
+        bool large;             // holds a single allocation too big for a page
     };
 
     struct tAllocState {
         size_t offset;
+        size_t pageSize;
         tHeader* page;
+        size_t totalBytes;
     };
     typedef std::vector<tAllocState> tAllocStack;
 
@@ -234,7 +253,11 @@ protected:
         return TAllocation::offsetAllocation(memory);
     }
 
-    size_t pageSize;        // granularity of allocation from the OS
+    void reserve(size_t numBytes);
+
+    size_t pageSize;        // size of the first and smallest page from the OS
+    size_t maxPageSize;     // pages grow no bigger than this
+    size_t nextPageSize;    // size of the next page to get from the OS
     size_t alignment;       // all returned allocations will be aligned at
                             //      this granularity, which will be a power of 2
     size_t alignmentMask;
@@ -242,12 +265,19 @@ protected:
                             //      header (basically, size of header, rounded
                             //      up to make it aligned
     size_t currentPageOffset;  // next offset in top of inUseList to allocate from
+    size_t currentPageSize;    // end of the page currentPageOffset is in
     tHeader* freeList;      // list of popped memory
     tHeader* inUseList;     // list of all memory currently being used
     tAllocStack stack;      // stack of where to allocate from, to partition pool
 
-    int numCalls;           // just an interesting statistic
-    size_t totalBytes;      // just an interesting statistic
+    size_t bytesReserved;   // memory obtained from the OS and not yet returned
+    size_t highWaterMark;   // most bytesReserved has been
+
+    size_t numCalls;
+    size_t totalBytes;
+    size_t pagesAllocated;
+    size_t pagesReused;
+    size_t largeAllocations;
 private:
     TPoolAllocator& operator=(const TPoolAllocator&);  // don't allow assignment operator
     TPoolAllocator(const TPoolAllocator&);  // don't allow default copy constructor
@@ -262,6 +292,25 @@ GLSLANG_EXPORT_FOR_TESTS
 extern TPoolAllocator& GetThreadPoolAllocator();
 void SetThreadPoolAllocator(TPoolAllocator* poolAllocator);
 
+//
+// Make 'pool' the thread's current pool for the lifetime of the scope, and
+// put back whichever pool was current before.
+//
+class TPoolAllocatorScope {
+public:
+    explicit TPoolAllocatorScope(TPoolAllocator& pool) : previous(&GetThreadPoolAllocator())
+    {
+        SetThreadPoolAllocator(&pool);
+    }
+    ~TPoolAllocatorScope() { SetThreadPoolAllocator(previous); }
+
+private:
+    TPoolAllocatorScope(const TPoolAllocatorScope&);
+    TPoolAllocatorScope& operator=(const TPoolAllocatorScope&);
+
+    TPoolAllocator* previous;
+};
+
 //
 // This STL compatible allocator is intended to be used as the allocator
 // parameter to templatized STL containers, like vector and map.
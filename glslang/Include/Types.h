@@ -2938,6 +2938,8 @@ public:
     const TSpirvType& getSpirvType() const { assert(spirvType); return *spirvType; }
 
 protected:
+    friend class TBuiltInSnapshot; // rebuilds types field by field, like deepCopy()
+
     // Require consumer to pick between deep copy and shallow copy.
     TType(const TType& type);
     TType& operator=(const TType& type);
@@ -344,6 +344,8 @@ struct TArraySizes {
     bool operator!=(const TArraySizes& rhs) const { return sizes != rhs.sizes; }
 
 protected:
+    friend class TBuiltInSnapshot;
+
     TSmallArrayVector sizes;
 
     TArraySizes(const TArraySizes&);
@@ -43,6 +43,7 @@ typedef struct glslang_shader_s glslang_shader_t;
 typedef struct glslang_program_s glslang_program_t;
 typedef struct glslang_mapper_s glslang_mapper_t;
 typedef struct glslang_resolver_s glslang_resolver_t;
+typedef struct glslang_compile_cache_s glslang_compile_cache_t;
 
 /* Version counterpart */
 typedef struct glslang_version_s {
@@ -239,8 +240,30 @@ typedef struct glslang_spv_options_s {
     bool emit_nonsemantic_shader_debug_source;
     bool compile_only;
     bool optimize_allow_expanded_id_bound;
+    int function_threads;
 } glslang_spv_options_t;
 
+/* TCompileCacheStats counterpart */
+typedef struct glslang_compile_cache_stats_s {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long stores;
+    unsigned long long evictions;
+} glslang_compile_cache_stats_t;
+
+/* TMemoryStats counterpart */
+typedef struct glslang_memory_stats_s {
+    unsigned long long allocations;
+    unsigned long long bytes_requested;
+    unsigned long long pages_allocated;
+    unsigned long long pages_reused;
+    unsigned long long large_allocations;
+    unsigned long long bytes_reserved;
+    unsigned long long high_water_mark;
+    unsigned long long scope_depth;
+    unsigned long long scope_bytes_requested;
+} glslang_memory_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -266,6 +289,7 @@ GLSLANG_EXPORT const char* glslang_shader_get_preprocessed_code(glslang_shader_t
 GLSLANG_EXPORT void glslang_shader_set_preprocessed_code(glslang_shader_t* shader, const char* code);
 GLSLANG_EXPORT const char* glslang_shader_get_info_log(glslang_shader_t* shader);
 GLSLANG_EXPORT const char* glslang_shader_get_info_debug_log(glslang_shader_t* shader);
+GLSLANG_EXPORT void glslang_shader_get_memory_stats(const glslang_shader_t* shader, glslang_memory_stats_t* stats);
 
 GLSLANG_EXPORT glslang_program_t* glslang_program_create(void);
 GLSLANG_EXPORT void glslang_program_delete(glslang_program_t* program);
@@ -283,6 +307,7 @@ GLSLANG_EXPORT unsigned int* glslang_program_SPIRV_get_ptr(glslang_program_t* pr
 GLSLANG_EXPORT const char* glslang_program_SPIRV_get_messages(glslang_program_t* program);
 GLSLANG_EXPORT const char* glslang_program_get_info_log(glslang_program_t* program);
 GLSLANG_EXPORT const char* glslang_program_get_info_debug_log(glslang_program_t* program);
+GLSLANG_EXPORT void glslang_program_get_memory_stats(const glslang_program_t* program, glslang_memory_stats_t* stats);
 
 GLSLANG_EXPORT glslang_mapper_t* glslang_glsl_mapper_create(void);
 GLSLANG_EXPORT void glslang_glsl_mapper_delete(glslang_mapper_t* mapper);
@@ -290,6 +315,17 @@ GLSLANG_EXPORT void glslang_glsl_mapper_delete(glslang_mapper_t* mapper);
 GLSLANG_EXPORT glslang_resolver_t* glslang_glsl_resolver_create(glslang_program_t* program, glslang_stage_t stage);
 GLSLANG_EXPORT void glslang_glsl_resolver_delete(glslang_resolver_t* resolver);
 
+/* Compile cache: an in-memory LRU bounded by capacity_bytes, or an existing directory shared across processes */
+GLSLANG_EXPORT glslang_compile_cache_t* glslang_compile_cache_create_memory(size_t capacity_bytes);
+GLSLANG_EXPORT glslang_compile_cache_t* glslang_compile_cache_create_directory(const char* directory);
+GLSLANG_EXPORT void glslang_compile_cache_delete(glslang_compile_cache_t* cache);
+/* Preprocess, parse, link and generate SPIR-V for input's stage, or reuse a cached result; SPIR-V and messages are
+   returned through program's SPIRV getters. spv_options may be NULL for the glslang_program_SPIRV_generate defaults. */
+GLSLANG_EXPORT int glslang_compile_cache_compile(glslang_compile_cache_t* cache, const glslang_input_t* input,
+                                                 const glslang_spv_options_t* spv_options, glslang_program_t* program);
+GLSLANG_EXPORT void glslang_compile_cache_get_stats(const glslang_compile_cache_t* cache, glslang_compile_cache_stats_t* stats);
+GLSLANG_EXPORT void glslang_compile_cache_reset_stats(glslang_compile_cache_t* cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,10 +37,13 @@
 //
 
 #include "localintermediate.h"
+#include "ConstantLanes.h"
+#include <algorithm>
 #include <cmath>
 #include <cfloat>
 #include <cstdlib>
 #include <climits>
+#include <type_traits>
 
 namespace {
 
@@ -48,11 +51,343 @@ using namespace glslang;
 
 const double pi = 3.1415926535897932384626433832795;
 
+//
+// Kernels for TConstLanes: one loop per operation, each computing exactly what the
+// TConstUnion operator, or the scalar case in the fold functions below, computes
+// for one component.  They return false for operations they don't cover.
+//
+
+// Division special-cases zero and overflowing divisors, as the scalar fold does.
+bool DivideLanes(double* left, const double* right, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        if (right[i] != 0.0)
+            left[i] = left[i] / right[i];
+        else if (left[i] > 0.0)
+            left[i] = (double)INFINITY;
+        else if (left[i] < 0.0)
+            left[i] = -(double)INFINITY;
+        else
+            left[i] = (double)NAN;
+    }
+    return true;
+}
+
+bool DivideLanes(int* left, const int* right, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        if (right[i] == 0)
+            left[i] = 0x7FFFFFFF;
+        else if (right[i] == -1 && left[i] == (int)-0x80000000ll)
+            left[i] = (int)-0x80000000ll;
+        else
+            left[i] = left[i] / right[i];
+    }
+    return true;
+}
+
+bool DivideLanes(unsigned int* left, const unsigned int* right, int size)
+{
+    for (int i = 0; i < size; ++i)
+        left[i] = right[i] == 0u ? 0xFFFFFFFFu : left[i] / right[i];
+    return true;
+}
+
+bool DivideLanes(long long* left, const long long* right, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        if (right[i] == 0ll)
+            left[i] = LLONG_MAX;
+        else if (right[i] == -1 && left[i] == LLONG_MIN)
+            left[i] = LLONG_MIN;
+        else
+            left[i] = left[i] / right[i];
+    }
+    return true;
+}
+
+bool DivideLanes(unsigned long long* left, const unsigned long long* right, int size)
+{
+    for (int i = 0; i < size; ++i)
+        left[i] = right[i] == 0ull ? 0xFFFFFFFFFFFFFFFFull : left[i] / right[i];
+    return true;
+}
+
+template<typename T>
+bool BitwiseLanes(TOperator op, T* left, const T* right, int size)
+{
+    switch (op) {
+    case EOpAnd:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] & right[i];
+        return true;
+    case EOpInclusiveOr:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] | right[i];
+        return true;
+    case EOpExclusiveOr:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] ^ right[i];
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool BitwiseLanes(TOperator, double*, const double*, int) { return false; }
+
+// The result replaces 'left'.
+template<typename T>
+bool FoldBinaryLanes(TOperator op, T* left, const T* right, int size)
+{
+    switch (op) {
+    case EOpAdd:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] + right[i];
+        return true;
+    case EOpSub:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] - right[i];
+        return true;
+    case EOpMul:
+    case EOpVectorTimesScalar:
+    case EOpMatrixTimesScalar:
+        for (int i = 0; i < size; ++i)
+            left[i] = left[i] * right[i];
+        return true;
+    case EOpDiv:
+        return DivideLanes(left, right, size);
+    default:
+        return BitwiseLanes(op, left, right, size);
+    }
+}
+
+bool FoldUnaryLanes(TOperator op, double* values, int size)
+{
+    switch (op) {
+    case EOpNegative:
+        for (int i = 0; i < size; ++i)
+            values[i] = -values[i];
+        return true;
+    case EOpAbs:
+        for (int i = 0; i < size; ++i)
+            values[i] = fabs(values[i]);
+        return true;
+    case EOpRadians:
+        for (int i = 0; i < size; ++i)
+            values[i] = values[i] * pi / 180.0;
+        return true;
+    case EOpDegrees:
+        for (int i = 0; i < size; ++i)
+            values[i] = values[i] * 180.0 / pi;
+        return true;
+    case EOpSin:
+        for (int i = 0; i < size; ++i)
+            values[i] = sin(values[i]);
+        return true;
+    case EOpCos:
+        for (int i = 0; i < size; ++i)
+            values[i] = cos(values[i]);
+        return true;
+    case EOpTan:
+        for (int i = 0; i < size; ++i)
+            values[i] = tan(values[i]);
+        return true;
+    case EOpAsin:
+        for (int i = 0; i < size; ++i)
+            values[i] = asin(values[i]);
+        return true;
+    case EOpAcos:
+        for (int i = 0; i < size; ++i)
+            values[i] = acos(values[i]);
+        return true;
+    case EOpAtan:
+        for (int i = 0; i < size; ++i)
+            values[i] = atan(values[i]);
+        return true;
+    case EOpExp:
+        for (int i = 0; i < size; ++i)
+            values[i] = exp(values[i]);
+        return true;
+    case EOpLog:
+        for (int i = 0; i < size; ++i)
+            values[i] = log(values[i]);
+        return true;
+    case EOpExp2:
+        for (int i = 0; i < size; ++i)
+            values[i] = exp2(values[i]);
+        return true;
+    case EOpLog2:
+        for (int i = 0; i < size; ++i)
+            values[i] = log2(values[i]);
+        return true;
+    case EOpSqrt:
+        for (int i = 0; i < size; ++i)
+            values[i] = sqrt(values[i]);
+        return true;
+    case EOpInverseSqrt:
+        for (int i = 0; i < size; ++i)
+            values[i] = 1.0 / sqrt(values[i]);
+        return true;
+    case EOpFloor:
+        for (int i = 0; i < size; ++i)
+            values[i] = floor(values[i]);
+        return true;
+    case EOpTrunc:
+        for (int i = 0; i < size; ++i)
+            values[i] = values[i] > 0 ? floor(values[i]) : ceil(values[i]);
+        return true;
+    case EOpRound:
+        for (int i = 0; i < size; ++i)
+            values[i] = floor(0.5 + values[i]);
+        return true;
+    case EOpRoundEven:
+        for (int i = 0; i < size; ++i) {
+            double flr = floor(values[i]);
+            bool even = flr / 2.0 == floor(flr / 2.0);
+            values[i] = even ? ceil(values[i] - 0.5) : floor(values[i] + 0.5);
+        }
+        return true;
+    case EOpCeil:
+        for (int i = 0; i < size; ++i)
+            values[i] = ceil(values[i]);
+        return true;
+    case EOpFract:
+        for (int i = 0; i < size; ++i)
+            values[i] = values[i] - floor(values[i]);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FoldUnaryLanes(TOperator op, int* values, int size)
+{
+    switch (op) {
+    case EOpNegative:
+        // Note: avoid UBSAN error regarding negating 0x80000000
+        for (int i = 0; i < size; ++i)
+            values[i] = static_cast<unsigned int>(values[i]) == 0x80000000 ? -0x7FFFFFFF - 1 : -values[i];
+        return true;
+    case EOpAbs:
+        for (int i = 0; i < size; ++i)
+            values[i] = abs(values[i]);
+        return true;
+    case EOpBitwiseNot:
+        for (int i = 0; i < size; ++i)
+            values[i] = ~values[i];
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FoldUnaryLanes(TOperator op, long long* values, int size)
+{
+    switch (op) {
+    case EOpNegative:
+        for (int i = 0; i < size; ++i)
+            values[i] = values[i] == INT64_MIN ? INT64_MIN : -values[i];
+        return true;
+    case EOpAbs:
+        // As in the scalar fold, abs() leaves 64-bit integers alone.
+        return true;
+    case EOpBitwiseNot:
+        for (int i = 0; i < size; ++i)
+            values[i] = ~values[i];
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Unsigned negation goes through the signed type of the same size.
+template<typename T>
+bool FoldUnaryLanes(TOperator op, T* values, int size)
+{
+    typedef typename std::make_signed<T>::type TSigned;
+
+    switch (op) {
+    case EOpNegative:
+        for (int i = 0; i < size; ++i)
+            values[i] = static_cast<T>(-static_cast<TSigned>(values[i]));
+        return true;
+    case EOpAbs:
+        return true;
+    case EOpBitwiseNot:
+        for (int i = 0; i < size; ++i)
+            values[i] = ~values[i];
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename T>
+bool FoldLanes(TOperator op, const TConstUnionArray& left, const TConstUnionArray& right, int size,
+               TConstUnionArray& result)
+{
+    TConstLanes<T> leftLanes;
+    TConstLanes<T> rightLanes;
+    for (int start = 0; start < size; start += TConstLanes<T>::Width) {
+        const int count = std::min(size - start, TConstLanes<T>::Width);
+        if (! leftLanes.load(left, start, count) || ! rightLanes.load(right, start, count) ||
+            ! FoldBinaryLanes(op, leftLanes.data(), rightLanes.data(), count))
+            return false;
+        leftLanes.store(result, start);
+    }
+    return true;
+}
+
+template<typename T>
+bool FoldLanes(TOperator op, const TConstUnionArray& operand, int size, TConstUnionArray& result)
+{
+    TConstLanes<T> lanes;
+    for (int start = 0; start < size; start += TConstLanes<T>::Width) {
+        const int count = std::min(size - start, TConstLanes<T>::Width);
+        if (! lanes.load(operand, start, count) || ! FoldUnaryLanes(op, lanes.data(), count))
+            return false;
+        lanes.store(result, start);
+    }
+    return true;
+}
+
 } // end anonymous namespace
 
 
 namespace glslang {
 
+bool FoldConstantLanes(TOperator op, const TConstUnionArray& left, const TConstUnionArray& right, int size,
+                       TConstUnionArray& result)
+{
+    if (size == 0)
+        return false;
+
+    switch (left[0].getType()) {
+    case EbtDouble: return FoldLanes<double>(op, left, right, size, result);
+    case EbtInt:    return FoldLanes<int>(op, left, right, size, result);
+    case EbtUint:   return FoldLanes<unsigned int>(op, left, right, size, result);
+    case EbtInt64:  return FoldLanes<long long>(op, left, right, size, result);
+    case EbtUint64: return FoldLanes<unsigned long long>(op, left, right, size, result);
+    default:        return false;
+    }
+}
+
+bool FoldConstantLanes(TOperator op, const TConstUnionArray& operand, int size, TConstUnionArray& result)
+{
+    if (size == 0)
+        return false;
+
+    switch (operand[0].getType()) {
+    case EbtDouble: return FoldLanes<double>(op, operand, size, result);
+    case EbtInt:    return FoldLanes<int>(op, operand, size, result);
+    case EbtUint:   return FoldLanes<unsigned int>(op, operand, size, result);
+    case EbtInt64:  return FoldLanes<long long>(op, operand, size, result);
+    case EbtUint64: return FoldLanes<unsigned long long>(op, operand, size, result);
+    default:        return false;
+    }
+}
+
 //
 // The fold functions see if an operation on a constant can be done in place,
 // without generating run-time code.
@@ -118,6 +453,14 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, const TIntermTyped* right
     TConstUnionArray newConstArray(newComps);
     TType constBool(EbtBool, EvqConst);
 
+    // Componentwise operations on operands of one type are folded through typed lanes.
+    if (FoldConstantLanes(op, leftUnionArray, rightUnionArray, newComps, newConstArray)) {
+        TIntermConstantUnion *newNode = new TIntermConstantUnion(newConstArray, returnType);
+        newNode->setLoc(getLoc());
+
+        return newNode;
+    }
+
     switch(op) {
     case EOpAdd:
         for (int i = 0; i < newComps; i++)
@@ -487,8 +830,8 @@ TIntermTyped* TIntermConstantUnion::fold(TOperator op, const TType& returnType)
         break;
     }
 
-    // Turn off the componentwise loop
-    if (! componentWise)
+    // Turn off the componentwise loop, also when typed lanes already did the work
+    if (! componentWise || FoldConstantLanes(op, unionArray, objectSize, newConstArray))
         objectSize = 0;
 
     // Process component-wise operations
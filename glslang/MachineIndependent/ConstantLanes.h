@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _CONSTANT_LANES_INCLUDED_
+#define _CONSTANT_LANES_INCLUDED_
+
+//
+// Typed, structure-of-arrays folding of componentwise constant operations.
+//
+// A TConstUnionArray is an array of tagged unions, and each TConstUnion operator
+// switches on the tag of the components it is given.  When all the components of
+// an operation's operands hold the same type, as they nearly always do, folding can
+// instead copy them, a block at a time, into plain arrays of that C++ type, run one
+// loop per operation over those arrays, which compilers can vectorize, and copy the
+// results back.  The results are the same as folding one TConstUnion at a time.
+//
+
+#include "../Include/ConstantUnion.h"
+#include "../Include/intermediate.h"
+
+namespace glslang {
+
+// How a TConstUnion holds a value of type T.
+template<typename T> struct TConstLaneType;
+
+template<> struct TConstLaneType<double> {
+    static const TBasicType basicType = EbtDouble;
+    static double get(const TConstUnion& c) { return c.getDConst(); }
+    static void set(TConstUnion& c, double value) { c.setDConst(value); }
+};
+template<> struct TConstLaneType<int> {
+    static const TBasicType basicType = EbtInt;
+    static int get(const TConstUnion& c) { return c.getIConst(); }
+    static void set(TConstUnion& c, int value) { c.setIConst(value); }
+};
+template<> struct TConstLaneType<unsigned int> {
+    static const TBasicType basicType = EbtUint;
+    static unsigned int get(const TConstUnion& c) { return c.getUConst(); }
+    static void set(TConstUnion& c, unsigned int value) { c.setUConst(value); }
+};
+template<> struct TConstLaneType<long long> {
+    static const TBasicType basicType = EbtInt64;
+    static long long get(const TConstUnion& c) { return c.getI64Const(); }
+    static void set(TConstUnion& c, long long value) { c.setI64Const(value); }
+};
+template<> struct TConstLaneType<unsigned long long> {
+    static const TBasicType basicType = EbtUint64;
+    static unsigned long long get(const TConstUnion& c) { return c.getU64Const(); }
+    static void set(TConstUnion& c, unsigned long long value) { c.setU64Const(value); }
+};
+
+//
+// Up to Width components of a constant, all of type T, stored contiguously.
+//
+template<typename T>
+class TConstLanes {
+public:
+    static constexpr int Width = 64;
+
+    TConstLanes() : count(0) { }
+
+    // Copy 'count' components of 'array', from 'start'.  Returns false if any of
+    // them holds a type other than T.
+    bool load(const TConstUnionArray& array, int start, int count)
+    {
+        assert(count <= Width);
+        this->count = count;
+        for (int i = 0; i < count; ++i) {
+            const TConstUnion& component = array[start + i];
+            if (component.getType() != TConstLaneType<T>::basicType)
+                return false;
+            values[i] = TConstLaneType<T>::get(component);
+        }
+        return true;
+    }
+
+    void store(TConstUnionArray& array, int start) const
+    {
+        for (int i = 0; i < count; ++i)
+            TConstLaneType<T>::set(array[start + i], values[i]);
+    }
+
+    int size() const { return count; }
+    T* data() { return values; }
+    const T* data() const { return values; }
+
+protected:
+    T values[Width];
+    int count;
+};
+
+// Fold the componentwise binary 'op' over the first 'size' components of 'left' and
+// 'right' into 'result', which must already have 'size' components.  Returns false
+// when the operands aren't of one type the lanes handle, or 'op' isn't one they
+// fold; 'result' is then left partially written, for the caller to fold one
+// TConstUnion at a time.
+bool FoldConstantLanes(TOperator op, const TConstUnionArray& left, const TConstUnionArray& right, int size,
+                       TConstUnionArray& result);
+
+// The same, for the componentwise unary 'op'.
+bool FoldConstantLanes(TOperator op, const TConstUnionArray& operand, int size, TConstUnionArray& result);
+
+} // end namespace glslang
+
+#endif // _CONSTANT_LANES_INCLUDED_
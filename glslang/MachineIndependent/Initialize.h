@@ -69,6 +69,13 @@ public:
     virtual void identifyBuiltIns(int version, EProfile profile, const SpvVersion& spvVersion, EShLanguage language, TSymbolTable& symbolTable) = 0;
     virtual void identifyBuiltIns(int version, EProfile profile, const SpvVersion& spvVersion, EShLanguage language, TSymbolTable& symbolTable, const TBuiltInResource &resources) = 0;
 
+    // Built-in functions left out of the common string, to be generated one name at a
+    // time when first looked up (see TBuiltInFunctionSource).  Each name has an index
+    // below getLazyFunctionCount(); findLazyFunction() returns -1 for other names.
+    virtual int getLazyFunctionCount() const { return 0; }
+    virtual int findLazyFunction(const char* /*name*/, size_t /*length*/) const { return -1; }
+    virtual void appendLazyFunction(int /*index*/, TString& /*prototypes*/) const { }
+
 protected:
     TString commonBuiltins;
     TString stageBuiltins[EShLangCount];
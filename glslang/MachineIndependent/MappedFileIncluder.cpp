@@ -0,0 +1,157 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// The process-wide cache of memory-mapped files behind TShader::MappedFileIncluder.
+//
+
+#include "../Public/ShaderLang.h"
+#include "../OSDependent/osinclude.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace glslang {
+
+namespace {
+
+// The contents of a file, as mapped when it had the given stamp.  Unmapped once
+// neither the cache nor any IncludeResult refers to it.
+class TMappedFile {
+public:
+    TMappedFile(const void* data, size_t length, size_t stampSize, long long stampTime)
+        : data(data), length(length), stampSize(stampSize), stampTime(stampTime) { }
+    ~TMappedFile() { OS_UnmapFile(data, length); }
+
+    // An empty file maps to nothing.
+    const char* contents() const { return data != nullptr ? static_cast<const char*>(data) : ""; }
+    size_t size() const { return length; }
+    bool isCurrent(size_t size, long long time) const { return stampSize == size && stampTime == time; }
+
+protected:
+    TMappedFile(const TMappedFile&) = delete;
+    TMappedFile& operator=(const TMappedFile&) = delete;
+
+    const void* data;
+    size_t length;
+    size_t stampSize;
+    long long stampTime;
+};
+
+typedef std::shared_ptr<const TMappedFile> TMappedFileRef;
+
+class TMappedFileCache {
+public:
+    TMappedFileRef acquire(const std::string& path)
+    {
+        size_t stampSize;
+        long long stampTime;
+        if (! OS_GetFileStamp(path.c_str(), stampSize, stampTime))
+            return nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            auto it = files.find(path);
+            if (it != files.end() && it->second->isCurrent(stampSize, stampTime))
+                return it->second;
+        }
+
+        // Map outside the lock, so reads of other files aren't held up.
+        const void* data = nullptr;
+        size_t length = 0;
+        if (stampSize > 0) {
+            data = OS_MapFile(path.c_str(), length);
+            if (data == nullptr)
+                return nullptr;
+        }
+        TMappedFileRef file = std::make_shared<const TMappedFile>(data, length, stampSize, stampTime);
+
+        // Another thread may have mapped the same version meanwhile; keep theirs.
+        std::lock_guard<std::mutex> guard(mutex);
+        TMappedFileRef& cached = files[path];
+        if (cached == nullptr || ! cached->isCurrent(stampSize, stampTime))
+            cached = file;
+        return cached;
+    }
+
+    void purge()
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        for (auto it = files.begin(); it != files.end(); ) {
+            if (it->second.use_count() == 1)
+                it = files.erase(it);
+            else
+                ++it;
+        }
+    }
+
+protected:
+    std::mutex mutex;
+    std::unordered_map<std::string, TMappedFileRef> files;
+};
+
+TMappedFileCache& GetMappedFileCache()
+{
+    static TMappedFileCache cache;
+    return cache;
+}
+
+} // end anonymous namespace
+
+TShader::Includer::IncludeResult* TShader::MappedFileIncluder::readFile(const std::string& path)
+{
+    TMappedFileRef file = GetMappedFileCache().acquire(path);
+    if (file == nullptr)
+        return nullptr;
+
+    // The result holds its own reference, so the contents outlive a change to the file.
+    return new IncludeResult(path, file->contents(), file->size(), new TMappedFileRef(file));
+}
+
+void TShader::MappedFileIncluder::releaseInclude(IncludeResult* result)
+{
+    if (result != nullptr) {
+        delete static_cast<TMappedFileRef*>(result->userData);
+        delete result;
+    }
+}
+
+void TShader::MappedFileIncluder::purgeCache()
+{
+    GetMappedFileCache().purge();
+}
+
+} // end namespace glslang
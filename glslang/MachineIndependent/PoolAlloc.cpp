@@ -34,6 +34,9 @@
 
 #include "../Include/Common.h"
 #include "../Include/PoolAlloc.h"
+#include "../Public/ShaderLang.h"
+
+#include <algorithm>
 
 // Mostly here for target that do not support threads such as WASI.
 #ifdef DISABLE_THREAD_SUPPORT
@@ -70,12 +73,19 @@ void SetThreadPoolAllocator(TPoolAllocator* poolAllocator)
 // Implement the functionality of the TPoolAllocator class, which
 // is documented in PoolAlloc.h.
 //
-TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
+TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment, int maxGrowthIncrement) :
     pageSize(growthIncrement),
+    maxPageSize(maxGrowthIncrement),
     alignment(allocationAlignment),
     freeList(nullptr),
     inUseList(nullptr),
-    numCalls(0)
+    bytesReserved(0),
+    highWaterMark(0),
+    numCalls(0),
+    totalBytes(0),
+    pagesAllocated(0),
+    pagesReused(0),
+    largeAllocations(0)
 {
     //
     // Don't allow page sizes we know are smaller than all common
@@ -83,12 +93,16 @@ TPoolAllocator::TPoolAllocator(int growthIncrement, int allocationAlignment) :
     //
     if (pageSize < 4*1024)
         pageSize = 4*1024;
+    if (maxPageSize < pageSize)
+        maxPageSize = pageSize;
+    nextPageSize = pageSize;
 
     //
-    // A large currentPageOffset indicates a new page needs to
-    // be obtained to allocate memory.
+    // A currentPageOffset at the end of the current page indicates a new
+    // page needs to be obtained to allocate memory.
     //
-    currentPageOffset = pageSize;
+    currentPageSize = pageSize;
+    currentPageOffset = currentPageSize;
 
     //
     // Adjust alignment to be at least pointer aligned and
@@ -166,14 +180,14 @@ void TAllocation::checkGuardBlock(unsigned char*, unsigned char, const char*) co
 
 void TPoolAllocator::push()
 {
-    tAllocState state = { currentPageOffset, inUseList };
+    tAllocState state = { currentPageOffset, currentPageSize, inUseList, totalBytes };
 
     stack.push_back(state);
 
     //
     // Indicate there is no current page to allocate from.
     //
-    currentPageOffset = pageSize;
+    currentPageOffset = currentPageSize;
 }
 
 //
@@ -190,16 +204,19 @@ void TPoolAllocator::pop()
 
     tHeader* page = stack.back().page;
     currentPageOffset = stack.back().offset;
+    currentPageSize = stack.back().pageSize;
 
     while (inUseList != page) {
         tHeader* nextInUse = inUseList->nextPage;
-        size_t pageCount = inUseList->pageCount;
+        size_t size = inUseList->size;
+        bool large = inUseList->large;
 
         // This technically ends the lifetime of the header as C++ object,
         // but we will still control the memory and reuse it.
         inUseList->~tHeader(); // currently, just a debug allocation checker
 
-        if (pageCount > 1) {
+        if (large) {
+            bytesReserved -= size;
             delete [] reinterpret_cast<char*>(inUseList);
         } else {
             inUseList->nextPage = freeList;
@@ -240,7 +257,7 @@ void* TPoolAllocator::allocate(size_t numBytes)
     // Do the allocation, most likely case first, for efficiency.
     // This step could be moved to be inline sometime.
     //
-    if (currentPageOffset + allocationSize <= pageSize) {
+    if (currentPageOffset + allocationSize <= currentPageSize) {
         //
         // Safe to allocate from currentPageOffset.
         //
@@ -253,40 +270,59 @@ void* TPoolAllocator::allocate(size_t numBytes)
 
     if (allocationSize + headerSkip > pageSize) {
         //
-        // Do a multi-page allocation.  Don't mix these with the others.
-        // The OS is efficient and allocating and free-ing multiple pages.
+        // Give an allocation too big for the smallest page a block of its own.
+        // The OS is efficient and allocating and free-ing large blocks.
         //
         size_t numBytesToAlloc = allocationSize + headerSkip;
         tHeader* memory = reinterpret_cast<tHeader*>(::new char[numBytesToAlloc]);
         if (memory == nullptr)
             return nullptr;
+        ++largeAllocations;
+        reserve(numBytesToAlloc);
 
-        // Use placement-new to initialize header
-        new(memory) tHeader(inUseList, (numBytesToAlloc + pageSize - 1) / pageSize);
-        inUseList = memory;
-
-        currentPageOffset = pageSize;  // make next allocation come from a new page
+        //
+        // Keep allocating from the current page if it belongs to the current
+        // push(), by linking the block in underneath it, where pop() will
+        // still find it.
+        //
+        if (inUseList != nullptr && (stack.empty() || stack.back().page != inUseList)) {
+            new(memory) tHeader(inUseList->nextPage, numBytesToAlloc, true);
+            inUseList->nextPage = memory;
+        } else {
+            new(memory) tHeader(inUseList, numBytesToAlloc, true);
+            inUseList = memory;
+            currentPageOffset = currentPageSize;  // make next allocation come from a new page
+        }
 
-        // No guard blocks for multi-page allocations (yet)
+        // No guard blocks for large allocations (yet)
         return reinterpret_cast<void*>(reinterpret_cast<UINT_PTR>(memory) + headerSkip);
     }
 
     //
-    // Need a simple page to allocate from.
+    // Need a page to allocate from.  Every page is at least pageSize, so
+    // any page on the free list will do.
     //
     tHeader* memory;
+    size_t size;
     if (freeList) {
         memory = freeList;
+        size = freeList->size;
         freeList = freeList->nextPage;
+        ++pagesReused;
     } else {
-        memory = reinterpret_cast<tHeader*>(::new char[pageSize]);
+        size = nextPageSize;
+        memory = reinterpret_cast<tHeader*>(::new char[size]);
         if (memory == nullptr)
             return nullptr;
+        ++pagesAllocated;
+        reserve(size);
+        nextPageSize = std::min(nextPageSize * 2, maxPageSize);
     }
 
     // Use placement-new to initialize header
-    new(memory) tHeader(inUseList, 1);
+    new(memory) tHeader(inUseList, size, false);
     inUseList = memory;
+    currentPageSize = size;
 
     unsigned char* ret = reinterpret_cast<unsigned char*>(inUseList) + headerSkip;
     currentPageOffset = (headerSkip + allocationSize + alignmentMask) & ~alignmentMask;
@@ -294,6 +330,25 @@ void* TPoolAllocator::allocate(size_t numBytes)
     return initializeAllocation(inUseList, ret, numBytes);
 }
 
+void TPoolAllocator::reserve(size_t numBytes)
+{
+    bytesReserved += numBytes;
+    highWaterMark = std::max(highWaterMark, bytesReserved);
+}
+
+void TPoolAllocator::getStats(TMemoryStats& stats) const
+{
+    stats.allocations = numCalls;
+    stats.bytesRequested = totalBytes;
+    stats.pagesAllocated = pagesAllocated;
+    stats.pagesReused = pagesReused;
+    stats.largeAllocations = largeAllocations;
+    stats.bytesReserved = bytesReserved;
+    stats.highWaterMark = highWaterMark;
+    stats.scopeDepth = stack.size();
+    stats.scopeBytesRequested = totalBytes - (stack.empty() ? 0 : stack.back().totalBytes);
+}
+
 //
 // Check all allocations in a list for damage by calling check on each.
 //
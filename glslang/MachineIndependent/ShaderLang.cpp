@@ -45,11 +45,18 @@
 #include "Scan.h"
 #include "ScanContext.h"
 #include "SymbolTable.h"
+#include "SymbolTableSnapshot.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #ifdef ENABLE_HLSL
 #include "../HLSL/hlslParseHelper.h"
@@ -81,7 +88,8 @@ namespace { // anonymous namespace for file-local functions and symbols
 // Shared global; access should be protected by a global mutex/critical section.
 int NumberOfClients = 0;
 
-// global initialization lock
+// global initialization lock; guards NumberOfClients and process-wide teardown,
+// but not the construction of individual built-in symbol tables (see TBuiltInSlot)
 #ifndef DISABLE_THREAD_SUPPORT
 std::mutex init_lock;
 #endif
@@ -287,7 +295,48 @@ enum EPrecisionClass { EPcGeneral, EPcFragment, EPcCount };
 TSymbolTable* CommonSymbolTable[VersionCount][SpvVersionCount][ProfileCount][SourceCount][EPcCount] = {};
 TSymbolTable* SharedSymbolTables[VersionCount][SpvVersionCount][ProfileCount][SourceCount][EShLangCount] = {};
 
-TPoolAllocator* PerProcessGPA = nullptr;
+// Construction state for one version/spvVersion/profile/source cell of the tables above.
+//
+// Each cell is built at most once, under its own lock, and its symbols live in its
+// own pool, so threads needing different cells build them concurrently.  Once
+// 'ready' has been published, the cell's tables are immutable and readers use them
+// without taking any lock.
+struct TBuiltInSlot {
+    std::atomic<bool> ready { false };
+#ifndef DISABLE_THREAD_SUPPORT
+    std::mutex lock;
+#endif
+    TPoolAllocator* pool = nullptr;
+    TBuiltInFunctionSource* lazyFunctions = nullptr; // attached to the cell's common tables
+};
+
+TBuiltInSlot BuiltInSlots[VersionCount][SpvVersionCount][ProfileCount][SourceCount];
+
+// Directory holding built-in symbol table snapshots; empty when disabled.
+// Guarded by init_lock.
+std::string BuiltInCacheDirectory;
+
+// Snapshots supplied through AddBuiltInSymbolTableImages().  Guarded by init_lock.
+std::vector<TBuiltInSymbolTableImage> BuiltInImages;
+
+// The built-ins specific to a compile (level 2) also depend on the resource limits.
+// Rather than parsing them again for every compile, the level for each distinct
+// context is built once, frozen into its own pool, and shared copy-on-use by the
+// compiles in that context.
+struct TContextLevel {
+    TPoolAllocator* pool = nullptr;
+    TSymbolTableLevel* level = nullptr; // nullptr if the level has to be built per compile
+    long long maxSymbolId = 0;          // of the table the level was built in
+};
+
+// Keyed by ContextLevelKey().  Guarded by ContextLevelLock.
+std::unordered_map<std::string, TContextLevel> ContextLevels;
+#ifndef DISABLE_THREAD_SUPPORT
+std::mutex ContextLevelLock;
+#endif
+
+// Beyond this many contexts, further ones are built per compile.
+const size_t MaxContextLevels = 64;
 
 //
 // Parse and add to the given symbol table the content of the given shader string.
@@ -366,16 +415,11 @@ bool InitializeStageSymbolTable(TBuiltInParseables& builtInParseables, int versi
 // Initialize the full set of shareable symbol tables;
 // The common (cross-stage) and those shareable per-stage.
 //
-bool InitializeSymbolTables(TInfoSink& infoSink, TSymbolTable** commonTable, TSymbolTable** symbolTables, int version,
-                            EProfile profile, const SpvVersion& spvVersion, EShSource source)
+bool InitializeSymbolTables(TBuiltInParseables* builtInParseables, TInfoSink& infoSink, TSymbolTable** commonTable,
+                            TSymbolTable** symbolTables, int version, EProfile profile, const SpvVersion& spvVersion,
+                            EShSource source)
 {
     bool success = true;
-    std::unique_ptr<TBuiltInParseables> builtInParseables(CreateBuiltInParseables(infoSink, source));
-
-    if (builtInParseables == nullptr)
-        return false;
-
-    builtInParseables->initialize(version, profile, spvVersion);
 
     // do the common tables
     success &= InitializeSymbolTable(builtInParseables->getCommonString(), version, profile, spvVersion, EShLangVertex,
@@ -439,6 +483,130 @@ bool InitializeSymbolTables(TInfoSink& infoSink, TSymbolTable** commonTable, TSy
     return success;
 }
 
+//
+// The built-in functions a cell's parseables leave to be generated on demand.
+//
+// The overloads of each name are parsed in a scratch pool the first time any
+// compile in the process looks the name up, the same way the rest of the
+// built-ins were, and a frozen copy is kept in the source's own pool.  After
+// that, finding them again is a single acquire load.
+//
+class TLazyBuiltInFunctions : public TBuiltInFunctionSource {
+public:
+    // Takes ownership of 'parseables', which must be allocated in the current pool,
+    // and of that pool.
+    TLazyBuiltInFunctions(TBuiltInParseables* parseables, TPoolAllocator* pool, int version, EProfile profile,
+                          const SpvVersion& spvVersion, EShSource source)
+        : parseables(parseables), pool(pool), levels(parseables->getLazyFunctionCount()), version(version),
+          profile(profile), spvVersion(spvVersion), source(source)
+    {
+        for (std::atomic<TSymbolTableLevel*>& level : levels)
+            level.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~TLazyBuiltInFunctions() override
+    {
+        for (std::atomic<TSymbolTableLevel*>& level : levels)
+            delete level.load(std::memory_order_relaxed);
+        delete parseables;
+        delete pool;
+    }
+
+    const TSymbolTableLevel* findFunctions(const char* name, size_t length) override
+    {
+        const int index = parseables->findLazyFunction(name, length);
+        if (index < 0)
+            return nullptr;
+
+        TSymbolTableLevel* level = levels[index].load(std::memory_order_acquire);
+        if (level != nullptr)
+            return level;
+
+#ifndef DISABLE_THREAD_SUPPORT
+        const std::lock_guard<std::mutex> guard(lock);
+#endif
+        level = levels[index].load(std::memory_order_relaxed);
+        if (level == nullptr) {
+            level = build(index);
+            levels[index].store(level, std::memory_order_release);
+        }
+
+        return level;
+    }
+
+protected:
+    TLazyBuiltInFunctions(const TLazyBuiltInFunctions&);
+    TLazyBuiltInFunctions& operator=(const TLazyBuiltInFunctions&);
+
+    TSymbolTableLevel* build(int index)
+    {
+        TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+        TPoolAllocator* scratchPool = new TPoolAllocator;
+        SetThreadPoolAllocator(scratchPool);
+
+        TInfoSink infoSink;
+        TSymbolTable* scratchTable = new TSymbolTable;
+        TString prototypes;
+        parseables->appendLazyFunction(index, prototypes);
+
+        // Like the common built-ins, these are parsed as for the vertex stage.
+        TSymbolTableLevel* level;
+        if (InitializeSymbolTable(prototypes, version, profile, spvVersion, EShLangVertex, source, infoSink,
+                                  *scratchTable)) {
+            parseables->identifyBuiltIns(version, profile, spvVersion, EShLangVertex, *scratchTable);
+            SetThreadPoolAllocator(pool);
+            level = scratchTable->copyCurrentLevel();
+        } else {
+            // Leave an empty level, so the failure is only reported once.
+            SetThreadPoolAllocator(pool);
+            level = new TSymbolTableLevel;
+            level->readOnly();
+        }
+
+        SetThreadPoolAllocator(scratchPool);
+        delete scratchTable;
+        delete scratchPool;
+        SetThreadPoolAllocator(&previousAllocator);
+
+        return level;
+    }
+
+    TBuiltInParseables* parseables;
+    TPoolAllocator* pool;
+    std::vector<std::atomic<TSymbolTableLevel*>> levels; // by lazy function index; nullptr until built
+#ifndef DISABLE_THREAD_SUPPORT
+    std::mutex lock;
+#endif
+    int version;
+    EProfile profile;
+    SpvVersion spvVersion;
+    EShSource source;
+};
+
+// Give a cell's common tables, once built, the functions its parseables generate on demand.
+void AttachLazyBuiltInFunctions(TBuiltInSlot& slot, TSymbolTable** commonTables, int version, EProfile profile,
+                                const SpvVersion& spvVersion, EShSource source)
+{
+    TInfoSink infoSink;
+    TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+    TPoolAllocator* pool = new TPoolAllocator;
+    SetThreadPoolAllocator(pool);
+    TBuiltInParseables* parseables = CreateBuiltInParseables(infoSink, source);
+    SetThreadPoolAllocator(&previousAllocator);
+
+    if (parseables == nullptr || parseables->getLazyFunctionCount() == 0) {
+        delete parseables;
+        delete pool;
+        return;
+    }
+
+    slot.lazyFunctions = new TLazyBuiltInFunctions(parseables, pool, version, profile, spvVersion, source);
+    for (int precClass = 0; precClass < EPcCount; ++precClass) {
+        if (commonTables[precClass] != nullptr)
+            commonTables[precClass]->setFunctionSource(slot.lazyFunctions);
+    }
+}
+
 bool AddContextSpecificSymbols(const TBuiltInResource* resources, TInfoSink& infoSink, TSymbolTable& symbolTable,
                                int version, EProfile profile, const SpvVersion& spvVersion, EShLanguage language,
                                EShSource source)
@@ -457,35 +625,202 @@ bool AddContextSpecificSymbols(const TBuiltInResource* resources, TInfoSink& inf
     return true;
 }
 
+// Everything AddContextSpecificSymbols() depends on.  The resources are compared up
+// to the end of the limits, which leaves out any tail padding.
+std::string ContextLevelKey(const TBuiltInResource& resources, int version, EProfile profile,
+                            const SpvVersion& spvVersion, EShLanguage language, EShSource source)
+{
+    const int context[] = { version, static_cast<int>(profile), static_cast<int>(spvVersion.spv),
+                            spvVersion.vulkanGlsl, spvVersion.vulkan, spvVersion.openGl,
+                            spvVersion.vulkanRelaxed, language, source };
+    std::string key(reinterpret_cast<const char*>(context), sizeof(context));
+    key.append(reinterpret_cast<const char*>(&resources), offsetof(TBuiltInResource, limits) + sizeof(TLimits));
+
+    return key;
+}
+
+//
+// Find, building it the first time, the shared level holding what
+// AddContextSpecificSymbols() adds on top of 'sharedTable' in this context.
+// Returns nullptr when the compile has to add them itself.
+//
+const TContextLevel* FindContextLevel(const TBuiltInResource& resources, TSymbolTable* sharedTable, int version,
+                                      EProfile profile, const SpvVersion& spvVersion, EShLanguage language,
+                                      EShSource source)
+{
+    const std::string key = ContextLevelKey(resources, version, profile, spvVersion, language, source);
+
+#ifndef DISABLE_THREAD_SUPPORT
+    const std::lock_guard<std::mutex> lock(ContextLevelLock);
+#endif
+    auto found = ContextLevels.find(key);
+    if (found != ContextLevels.end())
+        return found->second.level != nullptr ? &found->second : nullptr;
+    if (ContextLevels.size() >= MaxContextLevels)
+        return nullptr;
+
+    // As in SetupBuiltinSymbolTable(), parse in a scratch pool and keep a copy in the entry's pool.
+    TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+    TPoolAllocator* scratchPool = new TPoolAllocator;
+    SetThreadPoolAllocator(scratchPool);
+
+    TContextLevel& contextLevel = ContextLevels[key];
+    TInfoSink infoSink;
+    TSymbolTable* scratchTable = new TSymbolTable;
+    if (sharedTable != nullptr)
+        scratchTable->adoptLevels(*sharedTable);
+    // Failures are left for the compile to report, when it adds the symbols itself.
+    if (AddContextSpecificSymbols(&resources, infoSink, *scratchTable, version, profile, spvVersion, language,
+                                  source)) {
+        contextLevel.pool = new TPoolAllocator;
+        SetThreadPoolAllocator(contextLevel.pool);
+        contextLevel.level = scratchTable->copyCurrentLevelForBacking();
+        contextLevel.maxSymbolId = scratchTable->getMaxSymbolId();
+        if (contextLevel.level == nullptr) {
+            delete contextLevel.pool;
+            contextLevel.pool = nullptr;
+        }
+    }
+
+    delete scratchTable;
+    delete scratchPool;
+    SetThreadPoolAllocator(&previousAllocator);
+
+    return contextLevel.level != nullptr ? &contextLevel : nullptr;
+}
+
 //
 // To do this on the fly, we want to leave the current state of our thread's
 // pool allocator intact, so:
 //  - Switch to a new pool for parsing the built-ins
 //  - Do the parsing, which builds the symbol table, using the new pool
-//  - Switch to the process-global pool to save a copy of the resulting symbol table
+//  - Switch to the cell's own process-lifetime pool to save a copy of the resulting symbol table
 //  - Free up the new pool used to parse the built-ins
 //  - Switch back to the original thread's pool
 //
 // This only gets done the first time any thread needs a particular symbol table
-// (lazy evaluation).
+// (lazy evaluation).  Only threads needing the same version/profile combination
+// wait for each other; once built, the check below is a single acquire load.
 //
+// Snapshot key and file for a cell, given the parseables already initialized for it.
+TBuiltInSnapshotKey MakeSnapshotKey(const TBuiltInParseables& builtInParseables, int version, EProfile profile,
+                                    const SpvVersion& spvVersion, EShSource source)
+{
+    const TString& common = builtInParseables.getCommonString();
+    unsigned long long textHash = TBuiltInSnapshot::HashBuiltInText(common.c_str(), common.size());
+    for (int stage = 0; stage < EShLangCount; ++stage) {
+        const TString& stageText = builtInParseables.getStageString((EShLanguage)stage);
+        textHash = TBuiltInSnapshot::HashBuiltInText(stageText.c_str(), stageText.size(), textHash);
+    }
+
+    return { version, profile, spvVersion, source, textHash };
+}
+
+std::string SnapshotPath(const std::string& directory, int versionIndex, int spvVersionIndex, int profileIndex,
+                         int sourceIndex)
+{
+    return directory + "/glslang-builtins-" + std::to_string(versionIndex) + "-" + std::to_string(spvVersionIndex) +
+           "-" + std::to_string(profileIndex) + "-" + std::to_string(sourceIndex) + ".bin";
+}
+
+// The built-in text only depends on whether each of these is in use, so two
+// SpvVersions agreeing here get identical built-ins.
+bool SameBuiltInSpvVersion(const SpvVersion& a, const SpvVersion& b)
+{
+    return (a.spv == 0) == (b.spv == 0) && (a.vulkan > 0) == (b.vulkan > 0) && (a.openGl > 0) == (b.openGl > 0) &&
+           a.vulkanRelaxed == b.vulkanRelaxed;
+}
+
+// Rebuild a cell's global tables from a snapshot, either mapped from 'path' or
+// given in memory, into a new pool for the cell.  On success the tables are
+// published; on failure the cell is left untouched.
+bool LoadBuiltinSnapshot(TBuiltInSlot& slot, int versionIndex, int spvVersionIndex, int profileIndex,
+                         int sourceIndex, EProfile profile, const TBuiltInSnapshotKey& key, const char* path,
+                         const unsigned char* data, size_t size)
+{
+    TSymbolTable** commonTables = CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex];
+    TSymbolTable** stageTables = SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex];
+    int stageCommonIndex[EShLangCount];
+    for (int stage = 0; stage < EShLangCount; ++stage)
+        stageCommonIndex[stage] = CommonIndex(profile, (EShLanguage)stage);
+
+    TPoolAllocator& previousAllocator = GetThreadPoolAllocator();
+    slot.pool = new TPoolAllocator;
+    SetThreadPoolAllocator(slot.pool);
+    bool loaded = path != nullptr
+        ? TBuiltInSnapshot::read(path, key, commonTables, EPcCount, stageTables, EShLangCount, stageCommonIndex)
+        : TBuiltInSnapshot::deserialize(data, size, key, commonTables, EPcCount, stageTables, EShLangCount,
+                                        stageCommonIndex);
+
+    // Freezing the levels allocates their lookup tables, which live in the cell's pool too.
+    if (loaded) {
+        for (int precClass = 0; precClass < EPcCount; ++precClass) {
+            if (commonTables[precClass])
+                commonTables[precClass]->readOnly();
+        }
+        for (int stage = 0; stage < EShLangCount; ++stage) {
+            if (stageTables[stage])
+                stageTables[stage]->readOnly();
+        }
+    }
+    SetThreadPoolAllocator(&previousAllocator);
+
+    if (! loaded) {
+        delete slot.pool;
+        slot.pool = nullptr;
+        return false;
+    }
+
+    AttachLazyBuiltInFunctions(slot, commonTables, key.version, key.profile, key.spvVersion, key.source);
+    slot.ready.store(true, std::memory_order_release);
+
+    return true;
+}
+
 bool SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& spvVersion, EShSource source)
 {
     TInfoSink infoSink;
     bool success;
 
-    // Make sure only one thread tries to do this at a time
-#ifndef DISABLE_THREAD_SUPPORT
-    const std::lock_guard<std::mutex> lock(init_lock);
-#endif
-
-    // See if it's already been done for this version/profile combination
     int versionIndex = MapVersionToIndex(version);
     int spvVersionIndex = MapSpvVersionToIndex(spvVersion);
     int profileIndex = MapProfileToIndex(profile);
     int sourceIndex = MapSourceToIndex(source);
-    if (CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][EPcGeneral]) {
+    TBuiltInSlot& slot = BuiltInSlots[versionIndex][spvVersionIndex][profileIndex][sourceIndex];
+
+    // See if it's already been done for this version/profile combination
+    if (slot.ready.load(std::memory_order_acquire))
         return true;
+
+    // Make sure only one thread tries to build this combination at a time
+#ifndef DISABLE_THREAD_SUPPORT
+    const std::lock_guard<std::mutex> lock(slot.lock);
+#endif
+    if (slot.ready.load(std::memory_order_relaxed))
+        return true;
+
+    std::string cacheDirectory;
+    std::vector<TBuiltInSymbolTableImage> images;
+    {
+#ifndef DISABLE_THREAD_SUPPORT
+        const std::lock_guard<std::mutex> cacheLock(init_lock);
+#endif
+        cacheDirectory = BuiltInCacheDirectory;
+        images = BuiltInImages;
+    }
+
+    // Embedded snapshots come from this very build, so they are taken without
+    // generating the built-in text to check them against.
+    for (const TBuiltInSymbolTableImage& image : images) {
+        const unsigned char* data = static_cast<const unsigned char*>(image.data);
+        TBuiltInSnapshotKey imageKey;
+        if (! TBuiltInSnapshot::readKey(data, image.size, imageKey) || imageKey.version != version ||
+            imageKey.profile != profile || imageKey.source != source ||
+            ! SameBuiltInSpvVersion(imageKey.spvVersion, spvVersion))
+            continue;
+        if (LoadBuiltinSnapshot(slot, versionIndex, spvVersionIndex, profileIndex, sourceIndex, profile, imageKey,
+                                nullptr, data, image.size))
+            return true;
     }
 
     // Switch to a new pool
@@ -501,16 +836,41 @@ bool SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
     for (int stage = 0; stage < EShLangCount; ++stage)
         stageTables[stage] = new TSymbolTable;
 
+    TBuiltInSnapshotKey snapshotKey;
+    std::string snapshotPath;
+    std::unique_ptr<TBuiltInParseables> builtInParseables(CreateBuiltInParseables(infoSink, source));
+    if (builtInParseables == nullptr) {
+        success = false;
+        goto cleanup;
+    }
+    builtInParseables->initialize(version, profile, spvVersion);
+
+    // Try a snapshot written by an earlier process, straight into the cell's pool;
+    // it is only used if it was taken from identical built-in text.
+    if (! cacheDirectory.empty()) {
+        snapshotKey = MakeSnapshotKey(*builtInParseables, version, profile, spvVersion, source);
+        snapshotPath = SnapshotPath(cacheDirectory, versionIndex, spvVersionIndex, profileIndex, sourceIndex);
+
+        // Stale, corrupt, or missing snapshots just mean building from source as usual.
+        if (LoadBuiltinSnapshot(slot, versionIndex, spvVersionIndex, profileIndex, sourceIndex, profile, snapshotKey,
+                                snapshotPath.c_str(), nullptr, 0)) {
+            success = true;
+            goto cleanup;
+        }
+    }
+
     // Generate the local symbol tables using the new pool
-    if (!InitializeSymbolTables(infoSink, commonTable, stageTables, version, profile, spvVersion, source)) {
+    if (!InitializeSymbolTables(builtInParseables.get(), infoSink, commonTable, stageTables, version, profile,
+                                spvVersion, source)) {
         success = false;
         goto cleanup;
     }
 
-    // Switch to the process-global pool
-    SetThreadPoolAllocator(PerProcessGPA);
+    // Switch to the cell's process-lifetime pool
+    slot.pool = new TPoolAllocator;
+    SetThreadPoolAllocator(slot.pool);
 
-    // Copy the local symbol tables from the new pool to the global tables using the process-global pool
+    // Copy the local symbol tables from the new pool to the global tables using the cell's pool
     for (int precClass = 0; precClass < EPcCount; ++precClass) {
         if (!commonTable[precClass]->isEmpty()) {
             CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex][precClass] = new TSymbolTable;
@@ -530,8 +890,22 @@ bool SetupBuiltinSymbolTable(int version, EProfile profile, const SpvVersion& sp
             SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex][stage]->readOnly();
         }
     }
+
+    AttachLazyBuiltInFunctions(slot, CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex],
+                               version, profile, spvVersion, source);
+
+    // Publish the tables; everything written above happens-before any reader's acquire load.
+    slot.ready.store(true, std::memory_order_release);
     success = true;
 
+    // Failing to save a snapshot only costs the next process a parse.
+    if (! cacheDirectory.empty()) {
+        TBuiltInSnapshot::write(snapshotPath.c_str(), snapshotKey,
+                                CommonSymbolTable[versionIndex][spvVersionIndex][profileIndex][sourceIndex], EPcCount,
+                                SharedSymbolTables[versionIndex][spvVersionIndex][profileIndex][sourceIndex],
+                                EShLangCount);
+    }
+
 cleanup:
     // Clean up the local tables before deleting the pool they used.
     for (int precClass = 0; precClass < EPcCount; ++precClass)
@@ -539,6 +913,7 @@ cleanup:
     for (int stage = 0; stage < EShLangCount; ++stage)
         delete stageTables[stage];
 
+    builtInParseables.reset();
     delete builtInPoolAllocator;
     SetThreadPoolAllocator(&previousAllocator);
 
@@ -867,6 +1242,7 @@ void RecordProcesses(TIntermediate& intermediate, EShMessages messages, const st
 //
 template <typename ProcessingContext>
 bool ProcessDeferred(
+    TPoolAllocator& pool,        // where the compile allocates; current for the duration of the call
     TCompiler* compiler, const char* const shaderStrings[], const int numStrings, const int* inputLengths,
     const char* const stringNames[], const char* customPreamble, const EShOptimizationLevel optLevel,
     const TBuiltInResource* resources,
@@ -882,10 +1258,13 @@ bool ProcessDeferred(
     ProcessingContext& processingContext, bool requireNonempty, TShader::Includer& includer,
     const std::string sourceEntryPointName = "",
     const TEnvironment* environment = nullptr, // optional way of fully setting all versions, overriding the above
-    bool compileOnly = false, TSymbolTable* builtin_symbol_table = nullptr)
+    bool compileOnly = false, TSymbolTable* builtin_symbol_table = nullptr,
+    double* builtInMilliseconds = nullptr)       // optional time spent setting up the built-ins
 {
+    TPoolAllocatorScope poolScope(pool);
+
     // This must be undone (.pop()) by the caller, after it finishes consuming the created tree.
-    GetThreadPoolAllocator().push();
+    pool.push();
 
     if (numStrings == 0)
         return true;
@@ -993,6 +1372,7 @@ bool ProcessDeferred(
             intermediate.addSourceText(strings[numPre + s], lengths[numPre + s]);
         }
     }
+    const auto builtInStart = std::chrono::steady_clock::now();
     if (!SetupBuiltinSymbolTable(version, profile, spvVersion, source)) {
         return false;
     }
@@ -1009,11 +1389,22 @@ bool ProcessDeferred(
         symbolTable->overwriteUniqueId(intermediate.getUniqueId());
 
     // Add built-in symbols that are potentially context dependent;
-    // they get popped again further down.
-    if (!AddContextSpecificSymbols(resources, compiler->infoSink, *symbolTable, version, profile, spvVersion, stage,
-                                   source)) {
+    // they get popped again further down.  Unless the ids are continued from an
+    // earlier compile, or the whole level is handed out, they come from the level
+    // shared by all compiles in this context.
+    const TContextLevel* contextLevel = nullptr;
+    if (intermediate.getUniqueId() == 0 && !(messages & EShMsgBuiltinSymbolTable) && builtin_symbol_table == nullptr)
+        contextLevel = FindContextLevel(*resources, cachedTable, version, profile, spvVersion, stage, source);
+    if (contextLevel != nullptr)
+        symbolTable->pushCopyOnUse(*contextLevel->level, contextLevel->maxSymbolId);
+    else if (!AddContextSpecificSymbols(resources, compiler->infoSink, *symbolTable, version, profile, spvVersion,
+                                        stage, source)) {
         return false;
     }
+    if (builtInMilliseconds != nullptr) {
+        *builtInMilliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - builtInStart).count();
+    }
 
     if (messages & EShMsgBuiltinSymbolTable) {
         DumpBuiltinSymbolTable(compiler->infoSink, *symbolTable);
@@ -1318,7 +1709,7 @@ struct DoFullParse {
 //
 // NOTE: Doing just preprocessing to obtain a correct preprocessed shader string
 // is not an officially supported or fully working path.
-bool PreprocessDeferred(TCompiler* compiler, const char* const shaderStrings[], const int numStrings,
+bool PreprocessDeferred(TPoolAllocator& pool, TCompiler* compiler, const char* const shaderStrings[], const int numStrings,
                         const int* inputLengths, const char* const stringNames[], const char* preamble,
                         const EShOptimizationLevel optLevel, const TBuiltInResource* resources,
                         int defaultVersion, // use 100 for ES environment, 110 for desktop
@@ -1331,7 +1722,7 @@ bool PreprocessDeferred(TCompiler* compiler, const char* const shaderStrings[],
                         std::string* outputString, TEnvironment* environment = nullptr)
 {
     DoPreprocessing parser(outputString);
-    return ProcessDeferred(compiler, shaderStrings, numStrings, inputLengths, stringNames, preamble, optLevel,
+    return ProcessDeferred(pool, compiler, shaderStrings, numStrings, inputLengths, stringNames, preamble, optLevel,
                            resources, defaultVersion, defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
                            forwardCompatible, messages, intermediate, parser, false, includer, "", environment);
 }
@@ -1347,7 +1738,7 @@ bool PreprocessDeferred(TCompiler* compiler, const char* const shaderStrings[],
 // return:  the tree and other information is filled into the intermediate argument,
 //          and true is returned by the function for success.
 //
-bool CompileDeferred(TCompiler* compiler, const char* const shaderStrings[], const int numStrings,
+bool CompileDeferred(TPoolAllocator& pool, TCompiler* compiler, const char* const shaderStrings[], const int numStrings,
                      const int* inputLengths, const char* const stringNames[], const char* preamble,
                      const EShOptimizationLevel optLevel, const TBuiltInResource* resources,
                      int defaultVersion, // use 100 for ES environment, 110 for desktop
@@ -1358,13 +1749,13 @@ bool CompileDeferred(TCompiler* compiler, const char* const shaderStrings[], con
                      TIntermediate& intermediate, // returned tree, etc.
                      TShader::Includer& includer, const std::string sourceEntryPointName = "",
                      TEnvironment* environment = nullptr, bool compileOnly = false,
-                     TSymbolTable* builtin_symbol_table = nullptr)
+                     TSymbolTable* builtin_symbol_table = nullptr, double* builtInMilliseconds = nullptr)
 {
     DoFullParse parser;
-    return ProcessDeferred(compiler, shaderStrings, numStrings, inputLengths, stringNames, preamble, optLevel,
+    return ProcessDeferred(pool, compiler, shaderStrings, numStrings, inputLengths, stringNames, preamble, optLevel,
                            resources, defaultVersion, defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
                            forwardCompatible, messages, intermediate, parser, true, includer, sourceEntryPointName,
-                           environment, compileOnly, builtin_symbol_table);
+                           environment, compileOnly, builtin_symbol_table, builtInMilliseconds);
 }
 
 } // namespace
@@ -1379,9 +1770,6 @@ int ShInitialize()
 #endif
     ++NumberOfClients;
 
-    if (PerProcessGPA == nullptr)
-        PerProcessGPA = new TPoolAllocator();
-
     return 1;
 }
 
@@ -1465,9 +1853,32 @@ int ShFinalize()
         }
     }
 
-    if (PerProcessGPA != nullptr) {
-        delete PerProcessGPA;
-        PerProcessGPA = nullptr;
+    // The shared per-context levels were built on top of those tables.
+    {
+#ifndef DISABLE_THREAD_SUPPORT
+        const std::lock_guard<std::mutex> contextLock(ContextLevelLock);
+#endif
+        for (auto& contextLevel : ContextLevels) {
+            delete contextLevel.second.level;
+            delete contextLevel.second.pool;
+        }
+        ContextLevels.clear();
+    }
+
+    // Release the pools backing the tables deleted above, and allow the cells to be rebuilt.
+    for (int version = 0; version < VersionCount; ++version) {
+        for (int spvVersion = 0; spvVersion < SpvVersionCount; ++spvVersion) {
+            for (int p = 0; p < ProfileCount; ++p) {
+                for (int source = 0; source < SourceCount; ++source) {
+                    TBuiltInSlot& slot = BuiltInSlots[version][spvVersion][p][source];
+                    delete slot.lazyFunctions;
+                    slot.lazyFunctions = nullptr;
+                    delete slot.pool;
+                    slot.pool = nullptr;
+                    slot.ready.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
     }
 
     return 1;
@@ -1508,7 +1919,7 @@ int ShCompile(const ShHandle handle, const char* const shaderStrings[], const in
     TIntermediate intermediate(compiler->getLanguage());
     TShader::ForbidIncluder includer;
     bool success =
-        CompileDeferred(compiler, shaderStrings, numStrings, inputLengths, nullptr, "", optLevel, resources,
+        CompileDeferred(*compiler->getPool(), compiler, shaderStrings, numStrings, inputLengths, nullptr, "", optLevel, resources,
                         defaultVersion, ENoProfile, false, 0, forwardCompatible, messages, intermediate, includer);
 
     //
@@ -1521,7 +1932,7 @@ int ShCompile(const ShHandle handle, const char* const shaderStrings[], const in
 
     // Throw away all the temporary memory used by the compilation process.
     // The push was done in the CompileDeferred() call above.
-    GetThreadPoolAllocator().pop();
+    compiler->getPool()->pop();
 
     return success ? 1 : 0;
 }
@@ -1749,6 +2160,22 @@ bool InitializeProcess() { return ShInitialize() != 0; }
 
 void FinalizeProcess() { ShFinalize(); }
 
+void SetBuiltInSymbolTableCacheDirectory(const char* directory)
+{
+#ifndef DISABLE_THREAD_SUPPORT
+    const std::lock_guard<std::mutex> lock(init_lock);
+#endif
+    BuiltInCacheDirectory = directory != nullptr ? directory : "";
+}
+
+void AddBuiltInSymbolTableImages(const TBuiltInSymbolTableImage* images, int count)
+{
+#ifndef DISABLE_THREAD_SUPPORT
+    const std::lock_guard<std::mutex> lock(init_lock);
+#endif
+    BuiltInImages.insert(BuiltInImages.end(), images, images + count);
+}
+
 class TDeferredCompiler : public TCompiler {
 public:
     TDeferredCompiler(EShLanguage s, TInfoSink& i) : TCompiler(s, i) {}
@@ -1757,12 +2184,56 @@ public:
 
 TIoMapper* GetGlslIoMapper() { return static_cast<TIoMapper*>(new TGlslIoMapper()); }
 
-TShader::TShader(EShLanguage s) : stage(s), lengths(nullptr), stringNames(nullptr), preamble(""), overrideVersion(0)
+TCompileArena::TCompileArena() : pool(new TPoolAllocator) { }
+
+TCompileArena::TCompileArena(int pageSize, int maxPageSize) : pool(new TPoolAllocator(pageSize, 16, maxPageSize)) { }
+
+TCompileArena::~TCompileArena() { delete pool; }
+
+// Free everything allocated in the arena, keeping the pages for reuse.
+void TCompileArena::reset()
 {
-    pool = new TPoolAllocator;
+    pool->popAll();
+    pool->push();
+}
+
+size_t TCompileArena::getBytesReserved() const { return pool->getBytesReserved(); }
+
+TMemoryStats TCompileArena::getStats() const
+{
+    TMemoryStats stats;
+    pool->getStats(stats);
+    return stats;
+}
+
+TCompileArena::Scope::Scope(TCompileArena& arena) : previous(&GetThreadPoolAllocator())
+{
+    SetThreadPoolAllocator(arena.pool);
+}
+
+TCompileArena::Scope::~Scope() { SetThreadPoolAllocator(previous); }
+
+TShader::TShader(EShLanguage s)
+    : arena(new TCompileArena), ownsArena(true), stage(s), lengths(nullptr), stringNames(nullptr), preamble(""),
+      overrideVersion(0)
+{
+    init();
+}
+
+TShader::TShader(EShLanguage s, TCompileArena& a)
+    : arena(&a), ownsArena(false), stage(s), lengths(nullptr), stringNames(nullptr), preamble(""),
+      overrideVersion(0)
+{
+    init();
+}
+
+void TShader::init()
+{
+    TCompileArena::Scope arenaScope(*arena);
+
     infoSink = new TInfoSink;
     compiler = new TDeferredCompiler(stage, *infoSink);
-    intermediate = new TIntermediate(s);
+    intermediate = new TIntermediate(stage);
 
     // clear environment (avoid constructors in them for use in a C interface)
     environment.input.languageFamily = EShSourceNone;
@@ -1778,7 +2249,8 @@ TShader::~TShader()
     delete infoSink;
     delete compiler;
     delete intermediate;
-    delete pool;
+    if (ownsArena)
+        delete arena;
 }
 
 void TShader::setStrings(const char* const* s, int n)
@@ -1892,15 +2364,21 @@ bool TShader::parse(const TBuiltInResource* builtInResources, int defaultVersion
                     bool forceDefaultVersionAndProfile, bool forwardCompatible, EShMessages messages,
                     Includer& includer)
 {
-    SetThreadPoolAllocator(pool);
+    const auto start = std::chrono::steady_clock::now();
+    TCompileArena::Scope arenaScope(*arena);
 
     if (!preamble)
         preamble = "";
 
-    return CompileDeferred(compiler, strings, numStrings, lengths, stringNames, preamble, EShOptNone, builtInResources,
-                           defaultVersion, defaultProfile, forceDefaultVersionAndProfile, overrideVersion,
-                           forwardCompatible, messages, *intermediate, includer, sourceEntryPointName, &environment,
-                           compileOnly, builtin_symbol_table);
+    parseTimes = ParseTimes();
+    bool success = CompileDeferred(arena->getPool(), compiler, strings, numStrings, lengths, stringNames, preamble, EShOptNone,
+                                   builtInResources, defaultVersion, defaultProfile, forceDefaultVersionAndProfile,
+                                   overrideVersion, forwardCompatible, messages, *intermediate, includer,
+                                   sourceEntryPointName, &environment, compileOnly, builtin_symbol_table,
+                                   &parseTimes.builtIns);
+    parseTimes.total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return success;
 }
 
 // Fill in a string with the result of preprocessing ShaderStrings
@@ -1912,12 +2390,12 @@ bool TShader::preprocess(const TBuiltInResource* builtInResources, int defaultVe
                          bool forceDefaultVersionAndProfile, bool forwardCompatible, EShMessages message,
                          std::string* output_string, Includer& includer)
 {
-    SetThreadPoolAllocator(pool);
+    TCompileArena::Scope arenaScope(*arena);
 
     if (!preamble)
         preamble = "";
 
-    return PreprocessDeferred(compiler, strings, numStrings, lengths, stringNames, preamble, EShOptNone,
+    return PreprocessDeferred(arena->getPool(), compiler, strings, numStrings, lengths, stringNames, preamble, EShOptNone,
                               builtInResources, defaultVersion, defaultProfile, forceDefaultVersionAndProfile,
                               overrideVersion, forwardCompatible, message, includer, *intermediate, output_string,
                               &environment);
@@ -1927,9 +2405,18 @@ const char* TShader::getInfoLog() { return infoSink->info.c_str(); }
 
 const char* TShader::getInfoDebugLog() { return infoSink->debug.c_str(); }
 
-TProgram::TProgram() : reflection(nullptr), linked(false)
+TProgram::TProgram() : arena(new TCompileArena), ownsArena(true), reflection(nullptr), linked(false)
+{
+    init();
+}
+
+TProgram::TProgram(TCompileArena& a) : arena(&a), ownsArena(false), reflection(nullptr), linked(false)
+{
+    init();
+}
+
+void TProgram::init()
 {
-    pool = new TPoolAllocator;
     infoSink = new TInfoSink;
     for (int s = 0; s < EShLangCount; ++s) {
         intermediate[s] = nullptr;
@@ -1946,7 +2433,8 @@ TProgram::~TProgram()
         if (newedIntermediate[s])
             delete intermediate[s];
 
-    delete pool;
+    if (ownsArena)
+        delete arena;
 }
 
 //
@@ -1963,7 +2451,7 @@ bool TProgram::link(EShMessages messages)
 
     bool error = false;
 
-    SetThreadPoolAllocator(pool);
+    TCompileArena::Scope arenaScope(*arena);
 
     for (int s = 0; s < EShLangCount; ++s) {
         if (!linkStage((EShLanguage)s, messages))
@@ -2158,7 +2646,7 @@ bool TProgram::buildReflection(int opts)
     if (!linked || reflection != nullptr)
         return false;
 
-    SetThreadPoolAllocator(pool);
+    TCompileArena::Scope arenaScope(*arena);
 
     int firstStage = EShLangVertex, lastStage = EShLangFragment;
 
@@ -2230,7 +2718,7 @@ bool TProgram::mapIO(TIoMapResolver* pResolver, TIoMapper* pIoMapper)
     if (!linked)
         return false;
 
-    SetThreadPoolAllocator(pool);
+    TCompileArena::Scope arenaScope(*arena);
 
     TIoMapper* ioMapper = nullptr;
     TIoMapper defaultIOMapper;
@@ -269,6 +269,15 @@ void TAnonMember::dump(TInfoSink& TInfoSink, bool) const
 
 void TSymbolTableLevel::dump(TInfoSink& infoSink, bool complete) const
 {
+    if (backing != nullptr) {
+        // Show this compile's copy of a symbol where there is one.
+        for (tLevel::const_iterator it = backing->level.begin(); it != backing->level.end(); ++it) {
+            tLevel::const_iterator copy = level.find(it->first);
+            (copy != level.end() ? copy : it)->second->dump(infoSink, complete);
+        }
+        return;
+    }
+
     tLevel::const_iterator it;
     for (it = level.begin(); it != level.end(); ++it)
         (*it).second->dump(infoSink, complete);
@@ -314,6 +323,8 @@ TSymbolTableLevel::~TSymbolTableLevel()
 //
 void TSymbolTableLevel::relateToOperator(const char* name, TOperator op)
 {
+    copyFunctionsFromBacking(name);
+
     tLevel::const_iterator candidate = level.lower_bound(name);
     while (candidate != level.end()) {
         const TString& candidateName = (*candidate).first;
@@ -331,6 +342,8 @@ void TSymbolTableLevel::relateToOperator(const char* name, TOperator op)
 // Should only be used for a version/profile that actually needs the extension(s).
 void TSymbolTableLevel::setFunctionExtensions(const char* name, int num, const char* const extensions[])
 {
+    copyFunctionsFromBacking(name);
+
     tLevel::const_iterator candidate = level.lower_bound(name);
     while (candidate != level.end()) {
         const TString& candidateName = (*candidate).first;
@@ -349,18 +362,169 @@ void TSymbolTableLevel::setFunctionExtensions(const char* name, int num, const c
 // Should only be used for a version/profile that actually needs the extension(s).
 void TSymbolTableLevel::setSingleFunctionExtensions(const char* name, int num, const char* const extensions[])
 {
+    if (backing != nullptr)
+        find(name);
+
     if (auto candidate = level.find(name); candidate != level.end()) {
         candidate->second->setExtensions(num, extensions);
     }
 }
 
 //
-// Make all symbols in this table level read only.
+// Make all symbols in this table level read only, and freeze the level for
+// faster lookups.
 //
 void TSymbolTableLevel::readOnly()
 {
     for (tLevel::iterator it = level.begin(); it != level.end(); ++it)
         (*it).second->makeReadOnly();
+
+    // Levels adopted by several tables are made read only more than once.
+    if (! frozen)
+        freeze();
+}
+
+namespace {
+
+// FNV-1a, like std::hash<TString>, but over any prefix of a name.
+size_t HashName(const char* name, size_t length)
+{
+    unsigned hash = 2166136261U;
+    for (size_t c = 0; c < length; ++c) {
+        hash ^= (unsigned)name[c];
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+// Open-addressed tables are kept at most half full.
+size_t FrozenTableSize(size_t count)
+{
+    size_t size = 8;
+    while (size < 2 * count)
+        size *= 2;
+
+    return size;
+}
+
+} // end anonymous namespace
+
+//
+// Build the lookup tables of a level that won't change anymore.
+//
+void TSymbolTableLevel::freeze()
+{
+    // Overloads share their base name as a prefix, so they are adjacent in the map.
+    TVector<TFrozenBaseName> baseNames;
+    for (tLevel::const_iterator it = level.begin(); it != level.end(); ++it) {
+        const TString& name = it->first;
+        const size_t parenAt = name.find_first_of('(');
+        if (parenAt == name.npos)
+            continue;
+        if (baseNames.empty() || baseNames.back().length != parenAt ||
+            baseNames.back().name->compare(0, parenAt, name, 0, parenAt) != 0) {
+            baseNames.push_back({ HashName(name.c_str(), parenAt), &name, (unsigned int)parenAt,
+                                  (unsigned int)frozenOverloads.size(), 0 });
+        }
+        frozenOverloads.push_back(it->second->getAsFunction());
+        ++baseNames.back().count;
+    }
+
+    frozenBaseNames.assign(FrozenTableSize(baseNames.size()), TFrozenBaseName{ 0, nullptr, 0, 0, 0 });
+    const size_t baseMask = frozenBaseNames.size() - 1;
+    for (const TFrozenBaseName& baseName : baseNames) {
+        size_t slot = baseName.hash & baseMask;
+        while (frozenBaseNames[slot].name != nullptr)
+            slot = (slot + 1) & baseMask;
+        frozenBaseNames[slot] = baseName;
+    }
+
+    frozenNames.assign(FrozenTableSize(level.size()), TFrozenName{ 0, nullptr, nullptr });
+    const size_t nameMask = frozenNames.size() - 1;
+    for (tLevel::const_iterator it = level.begin(); it != level.end(); ++it) {
+        const size_t hash = HashName(it->first.c_str(), it->first.size());
+        size_t slot = hash & nameMask;
+        while (frozenNames[slot].name != nullptr)
+            slot = (slot + 1) & nameMask;
+        frozenNames[slot] = { hash, &it->first, it->second };
+    }
+
+    frozen = true;
+}
+
+TSymbol* TSymbolTableLevel::findFrozen(const TString& name) const
+{
+    const size_t hash = HashName(name.c_str(), name.size());
+    const size_t mask = frozenNames.size() - 1;
+    for (size_t slot = hash & mask; frozenNames[slot].name != nullptr; slot = (slot + 1) & mask) {
+        if (frozenNames[slot].hash == hash && *frozenNames[slot].name == name)
+            return frozenNames[slot].symbol;
+    }
+
+    return nullptr;
+}
+
+// Find the overloads of the function whose base name is the first 'length' characters of 'name'.
+const TSymbolTableLevel::TFrozenBaseName* TSymbolTableLevel::findFrozenBaseName(const char* name,
+                                                                                size_t length) const
+{
+    const size_t hash = HashName(name, length);
+    const size_t mask = frozenBaseNames.size() - 1;
+    for (size_t slot = hash & mask; frozenBaseNames[slot].name != nullptr; slot = (slot + 1) & mask) {
+        const TFrozenBaseName& baseName = frozenBaseNames[slot];
+        if (baseName.hash == hash && baseName.length == length && baseName.name->compare(0, length, name, length) == 0)
+            return &baseName;
+    }
+
+    return nullptr;
+}
+
+//
+// Give a backed level its own copy of a backing symbol; the copy keeps the
+// symbol's unique id, so it is the same symbol as far as the compile can tell.
+//
+TSymbol* TSymbolTableLevel::copyFromBacking(const TString& name)
+{
+    TSymbol* shared = backing->findFrozen(name);
+    if (shared == nullptr)
+        return nullptr;
+
+    TSymbol* copy = shared->clone();
+    level.insert(tLevelPair(name, copy));
+
+    return copy;
+}
+
+// Bring in all the overloads of a function before changing them in place.
+void TSymbolTableLevel::copyFunctionsFromBacking(const char* name)
+{
+    if (backing == nullptr)
+        return;
+
+    TVector<const TFunction*> overloads;
+    findFunctionNameList(TString(name) + '(', overloads);
+}
+
+//
+// Whether this level can back others: each symbol must be reproduced by
+// cloning it alone, under the name it is found by.
+//
+bool TSymbolTableLevel::canBack() const
+{
+    if (! retargetedSymbols.empty())
+        return false;
+
+    for (tLevel::const_iterator it = level.begin(); it != level.end(); ++it) {
+        const TSymbol* symbol = it->second;
+        if (symbol->getAsAnonMember() != nullptr || it->first != symbol->getMangledName())
+            return false;
+        // Clones don't carry specialization-constant subtrees.
+        if (symbol->getAsVariable() != nullptr && symbol->getAsVariable()->getConstSubtree() != nullptr)
+            return false;
+    }
+
+    return true;
 }
 
 //
@@ -448,6 +612,8 @@ TAnonMember* TAnonMember::clone() const
 
 TSymbolTableLevel* TSymbolTableLevel::clone() const
 {
+    assert(backing == nullptr);
+
     TSymbolTableLevel *symTableLevel = new TSymbolTableLevel();
     symTableLevel->anonId = anonId;
     symTableLevel->thisLevel = thisLevel;
@@ -127,6 +127,8 @@ public:
 	const TSourceLoc& getLoc() const{return loc;}
 
 protected:
+    friend class TBuiltInSnapshot; // serializes built-in symbols, see SymbolTableSnapshot.h
+
     explicit TSymbol(const TSymbol&);
     TSymbol& operator=(const TSymbol&);
 
@@ -204,6 +206,8 @@ public:
     virtual void dump(TInfoSink& infoSink, bool complete = false) const;
 
 protected:
+    friend class TBuiltInSnapshot;
+
     explicit TVariable(const TVariable&);
     TVariable& operator=(const TVariable&);
 
@@ -338,6 +342,8 @@ public:
     TLinkType getLinkType() const { return linkType; }
 
 protected:
+    friend class TBuiltInSnapshot;
+
     explicit TFunction(const TFunction&);
     TFunction& operator=(const TFunction&);
 
@@ -409,13 +415,31 @@ protected:
     int anonId;
 };
 
+class TSymbolTableLevel;
+
+//
+// Supplies built-in functions that are only materialized the first time they are
+// looked up, rather than parsed with the rest of the built-ins.  The levels handed
+// out are frozen, and live as long as the source.
+//
+class TBuiltInFunctionSource {
+public:
+    virtual ~TBuiltInFunctionSource() { }
+
+    // The level holding all overloads of the function whose name is the first
+    // 'length' characters of 'name', or nullptr if this source has no such function.
+    virtual const TSymbolTableLevel* findFunctions(const char* name, size_t length) = 0;
+};
+
 class TSymbolTableLevel {
 public:
     POOL_ALLOCATOR_NEW_DELETE(GetThreadPoolAllocator())
-    TSymbolTableLevel() : defaultPrecision(nullptr), anonId(0), thisLevel(false) { }
+    TSymbolTableLevel() : defaultPrecision(nullptr), anonId(0), thisLevel(false), frozen(false), backing(nullptr),
+        functionSource(nullptr) { }
     ~TSymbolTableLevel();
 
     bool insert(const TString& name, TSymbol* symbol) {
+        assert(! frozen);
         return level.insert(tLevelPair(name, symbol)).second;
     }
 
@@ -424,6 +448,7 @@ public:
         //
         // returning true means symbol was added to the table with no semantic errors
         //
+        assert(! frozen);
         const TString& name = symbol.getName();
         if (forcedKeyName.length()) {
             return level.insert(tLevelPair(forcedKeyName, &symbol)).second;
@@ -470,6 +495,7 @@ public:
 
     bool insertAnonymousMembers(TSymbol& symbol, int firstMember)
     {
+        assert(! frozen);
         const TTypeList& types = *symbol.getAsVariable()->getType().getStruct();
         for (unsigned int m = firstMember; m < types.size(); ++m) {
             TAnonMember* member = new TAnonMember(&types[m].type->getFieldName(), m, *symbol.getAsVariable(), symbol.getAsVariable()->getAnonId());
@@ -481,6 +507,7 @@ public:
     }
 
     void retargetSymbol(const TString& from, const TString& to) {
+        assert(! frozen);
         tLevel::const_iterator fromIt = level.find(from);
         tLevel::const_iterator toIt = level.find(to);
         if (fromIt == level.end() || toIt == level.end())
@@ -490,18 +517,46 @@ public:
         retargetedSymbols.push_back({from, to});
     }
 
-    TSymbol* find(const TString& name) const
+    TSymbol* find(const TString& name)
     {
+        if (frozen) {
+            TSymbol* symbol = findFrozen(name);
+            if (symbol == nullptr) {
+                const TSymbolTableLevel* functions = findSourceFunctions(name.c_str(), name.find_first_of('('));
+                if (functions != nullptr)
+                    symbol = functions->findFrozen(name);
+            }
+            return symbol;
+        }
+
         tLevel::const_iterator it = level.find(name);
-        if (it == level.end())
-            return nullptr;
-        else
+        if (it != level.end())
             return (*it).second;
+        if (backing != nullptr)
+            return copyFromBacking(name);
+
+        return nullptr;
     }
 
     void findFunctionNameList(const TString& name, TVector<const TFunction*>& list)
     {
         size_t parenAt = name.find_first_of('(');
+        if (backing != nullptr) {
+            const TFrozenBaseName* baseName = backing->findFrozenBaseName(name.c_str(), parenAt);
+            if (baseName == nullptr)
+                return;
+            for (unsigned int o = baseName->first; o < baseName->first + baseName->count; ++o)
+                list.push_back(find(backing->frozenOverloads[o]->getMangledName())->getAsFunction());
+            return;
+        }
+        if (frozen) {
+            findFrozenFunctionNameList(name.c_str(), parenAt, list);
+            const TSymbolTableLevel* functions = findSourceFunctions(name.c_str(), parenAt);
+            if (functions != nullptr)
+                functions->findFrozenFunctionNameList(name.c_str(), parenAt, list);
+            return;
+        }
+
         TString base(name, 0, parenAt + 1);
 
         tLevel::const_iterator begin = level.lower_bound(base);
@@ -514,6 +569,20 @@ public:
     // See if there is already a function in the table having the given non-function-style name.
     bool hasFunctionName(const TString& name) const
     {
+        // Everything in a backed level is a copy of a backing symbol.
+        if (backing != nullptr)
+            return backing->hasFunctionName(name);
+
+        // A variable of the same name sorts before the functions, and hides them here.
+        if (frozen) {
+            if (findFrozen(name) != nullptr)
+                return false;
+            if (findFrozenBaseName(name.c_str(), name.size()) != nullptr)
+                return true;
+            const TSymbolTableLevel* functions = findSourceFunctions(name.c_str(), name.size());
+            return functions != nullptr && functions->hasFunctionName(name);
+        }
+
         tLevel::const_iterator candidate = level.lower_bound(name);
         if (candidate != level.end()) {
             const TString& candidateName = (*candidate).first;
@@ -530,6 +599,23 @@ public:
     // Return true if name is found, and set variable to true if the name was a variable.
     bool findFunctionVariableName(const TString& name, bool& variable) const
     {
+        if (backing != nullptr)
+            return backing->findFunctionVariableName(name, variable);
+
+        if (frozen) {
+            if (findFrozen(name) != nullptr) {
+                variable = true;
+                return true;
+            }
+            if (findFrozenBaseName(name.c_str(), name.size()) == nullptr) {
+                const TSymbolTableLevel* functions = findSourceFunctions(name.c_str(), name.size());
+                if (functions == nullptr || ! functions->hasFunctionName(name))
+                    return false;
+            }
+            variable = false;
+            return true;
+        }
+
         tLevel::const_iterator candidate = level.lower_bound(name);
         if (candidate != level.end()) {
             const TString& candidateName = (*candidate).first;
@@ -587,6 +673,25 @@ public:
     void dump(TInfoSink& infoSink, bool complete = false) const;
     TSymbolTableLevel* clone() const;
     void readOnly();
+    bool isFrozen() const { return frozen; }
+
+    // A per-compile level can be backed by a frozen level shared across compiles;
+    // its symbols are then copied in the first time they are looked up, so a
+    // compile only pays for the ones it uses, and can edit those freely.
+    void setBacking(const TSymbolTableLevel& shared)
+    {
+        assert(shared.frozen && level.empty());
+        backing = &shared;
+    }
+    bool canBack() const;
+
+    // A frozen level can also take functions, not in the level itself, from a source
+    // that materializes them on demand; see TBuiltInFunctionSource.
+    void setFunctionSource(TBuiltInFunctionSource* source)
+    {
+        assert(frozen);
+        functionSource = source;
+    }
 
     void setThisLevel() { thisLevel = true; }
     bool isThisLevel() const { return thisLevel; }
@@ -595,12 +700,49 @@ public:
 
 	tLevel& get_level(){ return level; }
 protected:
+    friend class TBuiltInSnapshot;
+
     explicit TSymbolTableLevel(TSymbolTableLevel&);
     TSymbolTableLevel& operator=(TSymbolTableLevel&);
 
     typedef const tLevel::value_type tLevelPair;
     typedef std::pair<tLevel::iterator, bool> tInsertResult;
 
+    // Once read-only, a level is also frozen into open-addressed tables, so lookups
+    // don't walk the map comparing strings.  Keys point at the names in 'level', which
+    // is kept as is for iteration, cloning, and snapshots.
+    struct TFrozenName {
+        size_t hash;
+        const TString* name;  // nullptr for an empty slot
+        TSymbol* symbol;
+    };
+    // All the overloads of one function name, which are adjacent in the map.
+    struct TFrozenBaseName {
+        size_t hash;
+        const TString* name;  // the first overload's mangled name; nullptr for an empty slot
+        unsigned int length;  // of the base name, before the '('
+        unsigned int first;   // into frozenOverloads
+        unsigned int count;
+    };
+    void freeze();
+    TSymbol* findFrozen(const TString& name) const;
+    const TFrozenBaseName* findFrozenBaseName(const char* name, size_t length) const;
+    void findFrozenFunctionNameList(const char* name, size_t length, TVector<const TFunction*>& list) const
+    {
+        const TFrozenBaseName* baseName = findFrozenBaseName(name, length);
+        if (baseName != nullptr)
+            list.insert(list.end(), frozenOverloads.begin() + baseName->first,
+                        frozenOverloads.begin() + baseName->first + baseName->count);
+    }
+    const TSymbolTableLevel* findSourceFunctions(const char* name, size_t length) const
+    {
+        if (functionSource == nullptr || length == TString::npos)
+            return nullptr;
+        return functionSource->findFunctions(name, length);
+    }
+    TSymbol* copyFromBacking(const TString& name);
+    void copyFunctionsFromBacking(const char* name);
+
     tLevel level;  // named mappings
     TPrecisionQualifier *defaultPrecision;
     // pair<FromName, ToName>
@@ -608,6 +750,12 @@ protected:
     int anonId;
     bool thisLevel;  // True if this level of the symbol table is a structure scope containing member function
                      // that are supposed to see anonymous access to member variables.
+    bool frozen;
+    TVector<TFrozenName> frozenNames;          // power-of-two sized, by full (mangled) name
+    TVector<TFrozenBaseName> frozenBaseNames;  // power-of-two sized, by function base name
+    TVector<const TFunction*> frozenOverloads; // in map order
+    const TSymbolTableLevel* backing;          // not owned
+    TBuiltInFunctionSource* functionSource;    // not owned
 };
 
 class TSymbolTable {
@@ -925,6 +1073,37 @@ public:
 
     void setPreviousDefaultPrecisions(TPrecisionQualifier *p) { table[currentLevel()]->setPreviousDefaultPrecisions(p); }
 
+    // Make a frozen copy, in the current pool, of the current level for other
+    // tables to push with pushCopyOnUse(); nullptr if it can't back them.
+    TSymbolTableLevel* copyCurrentLevelForBacking() const
+    {
+        if (! table.back()->canBack())
+            return nullptr;
+
+        return copyCurrentLevel();
+    }
+
+    // Make a frozen copy, in the current pool, of the current level.
+    TSymbolTableLevel* copyCurrentLevel() const
+    {
+        TSymbolTableLevel* copy = table.back()->clone();
+        copy->readOnly();
+
+        return copy;
+    }
+
+    // Have the current, frozen, level take functions on demand from 'source'.
+    void setFunctionSource(TBuiltInFunctionSource* source) { table.back()->setFunctionSource(source); }
+
+    // Push a level whose symbols are copied on use from 'shared', which was built
+    // on top of this table's current levels, leaving 'maxSymbolId' as the last id.
+    void pushCopyOnUse(const TSymbolTableLevel& shared, long long maxSymbolId)
+    {
+        push();
+        table.back()->setBacking(shared);
+        overwriteUniqueId(maxSymbolId);
+    }
+
     void readOnly()
     {
         for (unsigned int level = 0; level < table.size(); ++level)
@@ -946,6 +1125,8 @@ public:
     }
 
 protected:
+    friend class TBuiltInSnapshot;
+
     TSymbolTable(TSymbolTable&);
     TSymbolTable& operator=(TSymbolTableLevel&);
 
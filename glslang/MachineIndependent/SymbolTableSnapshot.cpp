@@ -0,0 +1,941 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// Serialization of built-in symbol table levels; see SymbolTableSnapshot.h.
+//
+// Reading mirrors TSymbolTableLevel::clone() and the TSymbol copy constructors:
+// a table rebuilt from a snapshot is the same as one produced by copyTable()
+// from the tables that were serialized.
+//
+
+#include "SymbolTableSnapshot.h"
+#include "SymbolTable.h"
+#include "../OSDependent/osinclude.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+namespace glslang {
+
+namespace {
+
+const unsigned int SnapshotMagic = 0x594d5347; // "GSMY"
+
+// Bump whenever the encoding below, or the way identifyBuiltIns() decorates the
+// parsed built-ins, changes.
+const unsigned int SnapshotFormatVersion = 1;
+
+// The qualifier and sampler are stored bit-for-bit, so their layout is part of the format.
+static_assert(std::is_trivially_copyable<TQualifier>::value, "TQualifier is serialized bitwise");
+static_assert(std::is_trivially_copyable<TSampler>::value, "TSampler is serialized bitwise");
+
+// Record tags within a level.
+enum TSnapshotRecord {
+    ESrEnd,
+    ESrVariable,
+    ESrFunction,
+    ESrAnonContainer,
+};
+
+} // end anonymous namespace
+
+class TSnapshotWriter {
+public:
+    explicit TSnapshotWriter(std::vector<unsigned char>& out) : out(out) { }
+
+    void u8(unsigned int v) { out.push_back(static_cast<unsigned char>(v)); }
+    void u32(unsigned int v)
+    {
+        for (int b = 0; b < 4; ++b)
+            out.push_back(static_cast<unsigned char>(v >> (8 * b)));
+    }
+    void u64(unsigned long long v)
+    {
+        for (int b = 0; b < 8; ++b)
+            out.push_back(static_cast<unsigned char>(v >> (8 * b)));
+    }
+    void i32(int v) { u32(static_cast<unsigned int>(v)); }
+    void bytes(const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        out.insert(out.end(), p, p + size);
+    }
+    void string(const char* s, size_t length)
+    {
+        u32(static_cast<unsigned int>(length));
+        bytes(s, length);
+    }
+    void string(const TString& s) { string(s.c_str(), s.size()); }
+    void optionalString(const TString* s)
+    {
+        u8(s != nullptr);
+        if (s != nullptr)
+            string(*s);
+    }
+
+    size_t size() const { return out.size(); }
+    unsigned char* at(size_t offset) { return out.data() + offset; }
+
+private:
+    std::vector<unsigned char>& out;
+};
+
+class TSnapshotReader {
+public:
+    TSnapshotReader(const unsigned char* data, size_t size) : data(data), size(size), offset(0), failed(false) { }
+
+    bool ok() const { return ! failed; }
+    bool atEnd() const { return offset == size; }
+    size_t position() const { return offset; }
+    void fail() { failed = true; }
+
+    unsigned int u8()
+    {
+        if (! have(1))
+            return 0;
+        return data[offset++];
+    }
+    unsigned int u32()
+    {
+        if (! have(4))
+            return 0;
+        unsigned int v = 0;
+        for (int b = 0; b < 4; ++b)
+            v |= static_cast<unsigned int>(data[offset++]) << (8 * b);
+        return v;
+    }
+    unsigned long long u64()
+    {
+        if (! have(8))
+            return 0;
+        unsigned long long v = 0;
+        for (int b = 0; b < 8; ++b)
+            v |= static_cast<unsigned long long>(data[offset++]) << (8 * b);
+        return v;
+    }
+    int i32() { return static_cast<int>(u32()); }
+    bool flag() { return u8() != 0; }
+    void bytes(void* dest, size_t count)
+    {
+        if (! have(count))
+            return;
+        memcpy(dest, data + offset, count);
+        offset += count;
+    }
+    // Pool-allocated string
+    TString* string()
+    {
+        unsigned int length = u32();
+        if (! have(length))
+            return nullptr;
+        TString* s = NewPoolTString("");
+        s->assign(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+        return s;
+    }
+    TString* optionalString() { return flag() ? string() : nullptr; }
+
+    // Extension names are referenced by 'const char*' from the symbols; share one
+    // pool copy of each name across the whole snapshot.
+    const char* extension()
+    {
+        unsigned int length = u32();
+        if (! have(length))
+            return nullptr;
+        std::string name(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+        auto it = extensions.find(name);
+        if (it != extensions.end())
+            return it->second;
+        const char* pooled = NewPoolTString(name.c_str())->c_str();
+        extensions[name] = pooled;
+        return pooled;
+    }
+
+private:
+    bool have(size_t count)
+    {
+        if (failed || size - offset < count) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    const unsigned char* data;
+    size_t size;
+    size_t offset;
+    bool failed;
+    std::unordered_map<std::string, const char*> extensions;
+};
+
+namespace {
+
+void WriteKey(TSnapshotWriter& writer, const TBuiltInSnapshotKey& key, int commonCount, int stageCount)
+{
+    writer.u32(SnapshotMagic);
+    writer.u32(SnapshotFormatVersion);
+    writer.u32(static_cast<unsigned int>(sizeof(TQualifier)));
+    writer.u32(static_cast<unsigned int>(sizeof(TSampler)));
+    writer.i32(key.version);
+    writer.i32(key.profile);
+    writer.u32(key.spvVersion.spv);
+    writer.i32(key.spvVersion.vulkanGlsl);
+    writer.i32(key.spvVersion.vulkan);
+    writer.i32(key.spvVersion.openGl);
+    writer.u8(key.spvVersion.vulkanRelaxed);
+    writer.i32(key.source);
+    writer.u64(key.textHash);
+    writer.i32(commonCount);
+    writer.i32(stageCount);
+}
+
+bool MatchKey(TSnapshotReader& reader, const TBuiltInSnapshotKey& key, int commonCount, int stageCount)
+{
+    bool match = reader.u32() == SnapshotMagic;
+    match = reader.u32() == SnapshotFormatVersion && match;
+    match = reader.u32() == sizeof(TQualifier) && match;
+    match = reader.u32() == sizeof(TSampler) && match;
+    match = reader.i32() == key.version && match;
+    match = reader.i32() == (int)key.profile && match;
+    match = reader.u32() == key.spvVersion.spv && match;
+    match = reader.i32() == key.spvVersion.vulkanGlsl && match;
+    match = reader.i32() == key.spvVersion.vulkan && match;
+    match = reader.i32() == key.spvVersion.openGl && match;
+    match = reader.flag() == key.spvVersion.vulkanRelaxed && match;
+    match = reader.i32() == key.source && match;
+    match = reader.u64() == key.textHash && match;
+    match = reader.i32() == commonCount && match;
+    match = reader.i32() == stageCount && match;
+
+    return match && reader.ok();
+}
+
+void WriteExtensions(TSnapshotWriter& writer, int count, const char* const* extensions)
+{
+    writer.u32(count);
+    for (int e = 0; e < count; ++e)
+        writer.string(extensions[e], strlen(extensions[e]));
+}
+
+// Returns the number of extensions read into 'extensions'.
+int ReadExtensions(TSnapshotReader& reader, TVector<const char*>& extensions)
+{
+    unsigned int count = reader.u32();
+    extensions.clear();
+    for (unsigned int e = 0; e < count && reader.ok(); ++e)
+        extensions.push_back(reader.extension());
+
+    return reader.ok() ? static_cast<int>(extensions.size()) : 0;
+}
+
+void WriteLoc(TSnapshotWriter& writer, const TSourceLoc& loc)
+{
+    writer.optionalString(loc.name);
+    writer.i32(loc.string);
+    writer.i32(loc.line);
+    writer.i32(loc.column);
+}
+
+void ReadLoc(TSnapshotReader& reader, TSourceLoc& loc)
+{
+    loc.name = reader.optionalString();
+    loc.string = reader.i32();
+    loc.line = reader.i32();
+    loc.column = reader.i32();
+}
+
+bool WriteConstUnion(TSnapshotWriter& writer, const TConstUnion& value)
+{
+    writer.u8(value.getType());
+    switch (value.getType()) {
+    case EbtInt8:   writer.u64(static_cast<unsigned long long>(value.getI8Const()));  break;
+    case EbtUint8:  writer.u64(value.getU8Const());                                   break;
+    case EbtInt16:  writer.u64(static_cast<unsigned long long>(value.getI16Const())); break;
+    case EbtUint16: writer.u64(value.getU16Const());                                  break;
+    case EbtInt:    writer.u64(static_cast<unsigned long long>(value.getIConst()));   break;
+    case EbtUint:   writer.u64(value.getUConst());                                    break;
+    case EbtInt64:  writer.u64(static_cast<unsigned long long>(value.getI64Const())); break;
+    case EbtUint64: writer.u64(value.getU64Const());                                  break;
+    case EbtBool:   writer.u64(value.getBConst());                                    break;
+    case EbtDouble:
+    {
+        double d = value.getDConst();
+        unsigned long long bits;
+        memcpy(&bits, &d, sizeof(bits));
+        writer.u64(bits);
+        break;
+    }
+    case EbtString: writer.optionalString(value.getSConst()); break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+void ReadConstUnion(TSnapshotReader& reader, TConstUnion& value)
+{
+    TBasicType type = static_cast<TBasicType>(reader.u8());
+    if (type == EbtString) {
+        value.setSConst(reader.optionalString());
+        return;
+    }
+
+    unsigned long long bits = reader.u64();
+    switch (type) {
+    case EbtInt8:   value.setI8Const(static_cast<signed char>(bits));     break;
+    case EbtUint8:  value.setU8Const(static_cast<unsigned char>(bits));   break;
+    case EbtInt16:  value.setI16Const(static_cast<signed short>(bits));   break;
+    case EbtUint16: value.setU16Const(static_cast<unsigned short>(bits)); break;
+    case EbtInt:    value.setIConst(static_cast<int>(bits));              break;
+    case EbtUint:   value.setUConst(static_cast<unsigned int>(bits));     break;
+    case EbtInt64:  value.setI64Const(static_cast<long long>(bits));      break;
+    case EbtUint64: value.setU64Const(bits);                              break;
+    case EbtBool:   value.setBConst(bits != 0);                           break;
+    case EbtDouble:
+    {
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        value.setDConst(d);
+        break;
+    }
+    default:
+        reader.fail();
+        break;
+    }
+}
+
+} // end anonymous namespace
+
+//
+// Types
+//
+
+bool TBuiltInSnapshot::writeArraySizes(TSnapshotWriter& writer, const TArraySizes& arraySizes)
+{
+    writer.u32(arraySizes.getNumDims());
+    for (int d = 0; d < arraySizes.getNumDims(); ++d) {
+        // specialization-constant sizes refer into an AST, which is not snapshotted
+        if (arraySizes.getDimNode(d) != nullptr)
+            return false;
+        writer.u32(arraySizes.getDimSize(d));
+    }
+    writer.i32(arraySizes.implicitArraySize);
+    writer.u8(arraySizes.implicitlySized);
+    writer.u8(arraySizes.variablyIndexed);
+
+    return true;
+}
+
+TArraySizes* TBuiltInSnapshot::readArraySizes(TSnapshotReader& reader)
+{
+    TArraySizes* arraySizes = new TArraySizes;
+    unsigned int numDims = reader.u32();
+    for (unsigned int d = 0; d < numDims && reader.ok(); ++d)
+        arraySizes->addInnerSize(static_cast<int>(reader.u32()));
+    arraySizes->implicitArraySize = reader.i32();
+    arraySizes->implicitlySized = reader.flag();
+    arraySizes->variablyIndexed = reader.flag();
+
+    return arraySizes;
+}
+
+bool TBuiltInSnapshot::writeType(TSnapshotWriter& writer, const TType& type, TVector<const TTypeList*>& structures)
+{
+    // SPIR-V intrinsic types and decorations, and references, are never built-in
+    if (type.spirvType != nullptr || type.qualifier.spirvDecorate != nullptr || type.basicType == EbtReference)
+        return false;
+
+    writer.u8(type.basicType);
+    writer.u8(type.vectorSize);
+    writer.u8(type.matrixCols);
+    writer.u8(type.matrixRows);
+    writer.u8(type.coopmatKHRuse);
+    writer.u8((type.vector1            ? 1 << 0 : 0) |
+              (type.coopmatNV          ? 1 << 1 : 0) |
+              (type.coopmatKHR         ? 1 << 2 : 0) |
+              (type.coopmatKHRUseValid ? 1 << 3 : 0) |
+              (type.coopvecNV          ? 1 << 4 : 0) |
+              (type.tileAttachmentQCOM ? 1 << 5 : 0));
+
+    TQualifier qualifier = type.qualifier;
+    const char* semanticName = qualifier.semanticName;
+    qualifier.semanticName = nullptr;
+    writer.bytes(&qualifier, sizeof(qualifier));
+    writer.u8(semanticName != nullptr);
+    if (semanticName != nullptr)
+        writer.string(semanticName, strlen(semanticName));
+    writer.bytes(&type.sampler, sizeof(type.sampler));
+
+    writer.u8(type.arraySizes != nullptr);
+    if (type.arraySizes != nullptr && ! writeArraySizes(writer, *type.arraySizes))
+        return false;
+
+    writer.u8(type.typeParameters != nullptr);
+    if (type.typeParameters != nullptr) {
+        if (type.typeParameters->spirvType != nullptr)
+            return false;
+        writer.u8(type.typeParameters->basicType);
+        writer.u8(type.typeParameters->arraySizes != nullptr);
+        if (type.typeParameters->arraySizes != nullptr &&
+            ! writeArraySizes(writer, *type.typeParameters->arraySizes))
+            return false;
+    }
+
+    writer.u8(type.isStruct() && type.structure != nullptr);
+    if (type.isStruct() && type.structure != nullptr) {
+        // Preserve sharing of structures within one symbol's type graph, as deepCopy() does.
+        unsigned int index = 0;
+        while (index < structures.size() && structures[index] != type.structure)
+            ++index;
+        writer.u32(index);
+        if (index == structures.size()) {
+            structures.push_back(type.structure);
+            writer.u32(static_cast<unsigned int>(type.structure->size()));
+            for (const TTypeLoc& member : *type.structure) {
+                WriteLoc(writer, member.loc);
+                if (! writeType(writer, *member.type, structures))
+                    return false;
+            }
+        }
+    }
+
+    writer.optionalString(type.fieldName);
+    writer.optionalString(type.typeName);
+
+    return true;
+}
+
+bool TBuiltInSnapshot::readType(TSnapshotReader& reader, TType& type, TVector<TTypeList*>& structures)
+{
+    type.basicType = static_cast<TBasicType>(reader.u8());
+    type.vectorSize = reader.u8();
+    type.matrixCols = reader.u8();
+    type.matrixRows = reader.u8();
+    type.coopmatKHRuse = reader.u8();
+    unsigned int flags = reader.u8();
+    type.vector1 = (flags & (1 << 0)) != 0;
+    type.coopmatNV = (flags & (1 << 1)) != 0;
+    type.coopmatKHR = (flags & (1 << 2)) != 0;
+    type.coopmatKHRUseValid = (flags & (1 << 3)) != 0;
+    type.coopvecNV = (flags & (1 << 4)) != 0;
+    type.tileAttachmentQCOM = (flags & (1 << 5)) != 0;
+
+    reader.bytes(&type.qualifier, sizeof(type.qualifier));
+    type.qualifier.spirvDecorate = nullptr;
+    type.qualifier.semanticName = nullptr;
+    if (reader.flag()) {
+        TString* semanticName = reader.string();
+        if (semanticName != nullptr)
+            type.qualifier.semanticName = semanticName->c_str();
+    }
+    reader.bytes(&type.sampler, sizeof(type.sampler));
+
+    type.arraySizes = reader.flag() ? readArraySizes(reader) : nullptr;
+
+    type.typeParameters = nullptr;
+    if (reader.flag()) {
+        type.typeParameters = new TTypeParameters;
+        type.typeParameters->basicType = static_cast<TBasicType>(reader.u8());
+        type.typeParameters->arraySizes = reader.flag() ? readArraySizes(reader) : nullptr;
+    }
+
+    type.spirvType = nullptr;
+    type.structure = nullptr;
+    if (reader.flag()) {
+        unsigned int index = reader.u32();
+        if (index < structures.size())
+            type.structure = structures[index];
+        else if (index == structures.size()) {
+            type.structure = new TTypeList;
+            structures.push_back(type.structure);
+            unsigned int memberCount = reader.u32();
+            for (unsigned int m = 0; m < memberCount && reader.ok(); ++m) {
+                TTypeLoc member;
+                ReadLoc(reader, member.loc);
+                member.type = new TType;
+                readType(reader, *member.type, structures);
+                type.structure->push_back(member);
+            }
+        } else
+            reader.fail();
+    }
+
+    type.fieldName = reader.optionalString();
+    type.typeName = reader.optionalString();
+
+    return reader.ok();
+}
+
+//
+// Symbols
+//
+
+bool TBuiltInSnapshot::writeSymbol(TSnapshotWriter& writer, const TSymbol& symbol)
+{
+    if (symbol.name == nullptr)
+        return false;
+
+    writer.string(*symbol.name);
+    writer.u64(symbol.uniqueId);
+    WriteExtensions(writer, symbol.getNumExtensions(), symbol.getNumExtensions() > 0 ? symbol.getExtensions() : nullptr);
+    WriteLoc(writer, symbol.loc);
+
+    TVector<const TTypeList*> structures;
+
+    if (const TVariable* variable = symbol.getAsVariable()) {
+        // specialization-constant subtrees are not carried by cloned tables either
+        writer.string(*symbol.mangledName);
+        if (! writeType(writer, variable->type, structures))
+            return false;
+        writer.u8(variable->userType);
+        writer.i32(variable->anonId);
+
+        writer.u32(variable->constArray.size());
+        for (int c = 0; c < variable->constArray.size(); ++c) {
+            if (! WriteConstUnion(writer, variable->constArray[c]))
+                return false;
+        }
+
+        writer.u8(variable->hasMemberExtensions());
+        if (variable->hasMemberExtensions()) {
+            int memberCount = static_cast<int>(variable->type.getStruct()->size());
+            writer.u32(memberCount);
+            for (int m = 0; m < memberCount; ++m) {
+                int count = variable->getNumMemberExtensions(m);
+                WriteExtensions(writer, count, count > 0 ? variable->getMemberExtensions(m) : nullptr);
+            }
+        }
+
+        return true;
+    }
+
+    const TFunction* function = symbol.getAsFunction();
+    if (function == nullptr)
+        return false;
+
+    writer.string(function->mangledName);
+    if (! writeType(writer, function->returnType, structures))
+        return false;
+    writer.u32(function->declaredBuiltIn);
+    writer.u32(function->op);
+    writer.u8((function->defined             ? 1 << 0 : 0) |
+              (function->prototyped          ? 1 << 1 : 0) |
+              (function->implicitThis        ? 1 << 2 : 0) |
+              (function->illegalImplicitThis ? 1 << 3 : 0));
+    writer.i32(function->defaultParamCount);
+    writer.string(function->spirvInst.set);
+    writer.i32(function->spirvInst.id);
+    writer.u32(function->linkType);
+
+    writer.u32(static_cast<unsigned int>(function->parameters.size()));
+    for (const TParameter& param : function->parameters) {
+        if (param.defaultValue != nullptr)
+            return false;
+        writer.optionalString(param.name);
+        structures.clear();
+        if (! writeType(writer, *param.type, structures))
+            return false;
+    }
+
+    return true;
+}
+
+TSymbol* TBuiltInSnapshot::readSymbol(TSnapshotReader& reader, int kind)
+{
+    TString* name = reader.string();
+    long long uniqueId = static_cast<long long>(reader.u64());
+    TVector<const char*> extensions;
+    int numExtensions = ReadExtensions(reader, extensions);
+    TSourceLoc loc;
+    ReadLoc(reader, loc);
+    if (! reader.ok())
+        return nullptr;
+
+    TVector<TTypeList*> structures;
+    TSymbol* symbol;
+
+    if (kind == ESrVariable || kind == ESrAnonContainer) {
+        TString* mangledName = reader.string();
+        TType type;
+        if (! readType(reader, type, structures))
+            return nullptr;
+        bool userType = reader.flag();
+        TVariable* variable = new TVariable(kind == ESrAnonContainer ? NewPoolTString("") : name, mangledName, type,
+                                            userType);
+        variable->anonId = reader.i32();
+
+        unsigned int constCount = reader.u32();
+        if (constCount > 0 && reader.ok()) {
+            TConstUnionArray constArray(static_cast<int>(constCount));
+            for (unsigned int c = 0; c < constCount && reader.ok(); ++c)
+                ReadConstUnion(reader, constArray[c]);
+            variable->constArray = constArray;
+        }
+
+        if (reader.flag()) {
+            unsigned int memberCount = reader.u32();
+            if (! type.isStruct() || type.getStruct() == nullptr || memberCount != type.getStruct()->size()) {
+                reader.fail();
+                return nullptr;
+            }
+            TVector<const char*> memberExtensions;
+            for (unsigned int m = 0; m < memberCount && reader.ok(); ++m) {
+                int count = ReadExtensions(reader, memberExtensions);
+                if (count > 0)
+                    variable->setMemberExtensions(m, count, memberExtensions.data());
+            }
+        }
+        symbol = variable;
+    } else {
+        TString* mangledName = reader.string();
+        TType returnType;
+        if (mangledName == nullptr || ! readType(reader, returnType, structures))
+            return nullptr;
+        TFunction* function = new TFunction(name, returnType);
+        function->mangledName = *mangledName;
+        function->declaredBuiltIn = static_cast<TBuiltInVariable>(reader.u32());
+        function->op = static_cast<TOperator>(reader.u32());
+        unsigned int flags = reader.u8();
+        function->defined = (flags & (1 << 0)) != 0;
+        function->prototyped = (flags & (1 << 1)) != 0;
+        function->implicitThis = (flags & (1 << 2)) != 0;
+        function->illegalImplicitThis = (flags & (1 << 3)) != 0;
+        function->defaultParamCount = reader.i32();
+        TString* spirvSet = reader.string();
+        if (spirvSet != nullptr)
+            function->spirvInst.set = *spirvSet;
+        function->spirvInst.id = reader.i32();
+        function->linkType = static_cast<TLinkType>(reader.u32());
+
+        unsigned int paramCount = reader.u32();
+        for (unsigned int p = 0; p < paramCount && reader.ok(); ++p) {
+            TParameter param = { reader.optionalString(), new TType, nullptr };
+            structures.clear();
+            readType(reader, *param.type, structures);
+            function->parameters.push_back(param);
+        }
+        symbol = function;
+    }
+
+    symbol->uniqueId = uniqueId;
+    symbol->loc = loc;
+    if (numExtensions > 0)
+        symbol->setExtensions(numExtensions, extensions.data());
+
+    return reader.ok() ? symbol : nullptr;
+}
+
+//
+// Levels and tables
+//
+
+bool TBuiltInSnapshot::writeLevel(TSnapshotWriter& writer, const TSymbolTableLevel& level)
+{
+    writer.i32(level.anonId);
+    writer.u8(level.thisLevel);
+    writer.u32(static_cast<unsigned int>(level.retargetedSymbols.size()));
+    for (const auto& retarget : level.retargetedSymbols) {
+        writer.string(retarget.first);
+        writer.string(retarget.second);
+    }
+
+    // Same walk as TSymbolTableLevel::clone(): each anonymous container once,
+    // retargeted names only through the retarget list.
+    std::vector<bool> containerWritten(level.anonId, false);
+    for (const auto& entry : level.level) {
+        const TAnonMember* anon = entry.second->getAsAnonMember();
+        if (anon) {
+            int anonId = anon->getAnonId();
+            if (anonId < 0 || anonId >= level.anonId)
+                return false;
+            if (! containerWritten[anonId]) {
+                writer.u8(ESrAnonContainer);
+                if (! writeSymbol(writer, anon->getAnonContainer()))
+                    return false;
+                containerWritten[anonId] = true;
+            }
+        } else {
+            bool retargeted = false;
+            for (const auto& retarget : level.retargetedSymbols)
+                retargeted = retargeted || retarget.first == entry.first;
+            if (retargeted)
+                continue;
+            writer.u8(entry.second->getAsFunction() ? ESrFunction : ESrVariable);
+            if (! writeSymbol(writer, *entry.second))
+                return false;
+        }
+    }
+    writer.u8(ESrEnd);
+
+    return true;
+}
+
+bool TBuiltInSnapshot::readLevel(TSnapshotReader& reader, TSymbolTableLevel& level)
+{
+    int anonId = reader.i32();
+    level.thisLevel = reader.flag();
+    unsigned int retargetCount = reader.u32();
+    for (unsigned int r = 0; r < retargetCount && reader.ok(); ++r) {
+        TString* from = reader.string();
+        TString* to = reader.string();
+        if (from != nullptr && to != nullptr)
+            level.retargetedSymbols.push_back({ *from, *to });
+    }
+
+    for (int kind = reader.u8(); kind != ESrEnd && reader.ok(); kind = reader.u8()) {
+        if (kind != ESrVariable && kind != ESrFunction && kind != ESrAnonContainer) {
+            reader.fail();
+            break;
+        }
+        TSymbol* symbol = readSymbol(reader, kind);
+        if (symbol == nullptr) {
+            reader.fail();
+            break;
+        }
+        // insert() numbers anonymous containers from the level's counter; give each
+        // one back the id it had when the snapshot was taken
+        if (kind == ESrAnonContainer)
+            level.anonId = symbol->getAsVariable()->getAnonId();
+        level.insert(*symbol, false);
+    }
+    level.anonId = anonId;
+
+    for (const auto& retarget : level.retargetedSymbols) {
+        TSymbol* symbol = level.find(retarget.second);
+        if (symbol != nullptr)
+            level.insert(retarget.first, symbol);
+    }
+
+    return reader.ok();
+}
+
+bool TBuiltInSnapshot::writeTable(TSnapshotWriter& writer, const TSymbolTable& table)
+{
+    writer.u64(static_cast<unsigned long long>(table.uniqueId));
+    writer.u8(table.noBuiltInRedeclarations);
+    writer.u8(table.separateNameSpaces);
+    writer.u32(static_cast<unsigned int>(table.table.size() - table.adoptedLevels));
+    for (size_t level = table.adoptedLevels; level < table.table.size(); ++level) {
+        if (! writeLevel(writer, *table.table[level]))
+            return false;
+    }
+
+    return true;
+}
+
+bool TBuiltInSnapshot::readTable(TSnapshotReader& reader, TSymbolTable& table)
+{
+    table.uniqueId = static_cast<long long>(reader.u64());
+    table.noBuiltInRedeclarations = reader.flag();
+    table.separateNameSpaces = reader.flag();
+    unsigned int levelCount = reader.u32();
+    for (unsigned int level = 0; level < levelCount && reader.ok(); ++level) {
+        table.table.push_back(new TSymbolTableLevel);
+        readLevel(reader, *table.table.back());
+    }
+
+    return reader.ok();
+}
+
+//
+// Whole snapshots
+//
+
+bool TBuiltInSnapshot::serialize(std::vector<unsigned char>& out, const TBuiltInSnapshotKey& key,
+                                 const TSymbolTable* const* commonTables, int commonCount,
+                                 const TSymbolTable* const* stageTables, int stageCount)
+{
+    out.clear();
+    TSnapshotWriter writer(out);
+    WriteKey(writer, key, commonCount, stageCount);
+
+    // The payload is checksummed so that a truncated or corrupted file is rejected.
+    size_t checksumOffset = writer.size();
+    writer.u64(0);
+    size_t payloadOffset = writer.size();
+
+    for (int t = 0; t < commonCount + stageCount; ++t) {
+        const TSymbolTable* table = t < commonCount ? commonTables[t] : stageTables[t - commonCount];
+        writer.u8(table != nullptr);
+        if (table != nullptr && ! writeTable(writer, *table)) {
+            out.clear();
+            return false;
+        }
+    }
+
+    unsigned long long checksum = HashBuiltInText(reinterpret_cast<const char*>(writer.at(payloadOffset)),
+                                                  writer.size() - payloadOffset);
+    for (int b = 0; b < 8; ++b)
+        *writer.at(checksumOffset + b) = static_cast<unsigned char>(checksum >> (8 * b));
+
+    return true;
+}
+
+bool TBuiltInSnapshot::deserialize(const unsigned char* data, size_t size, const TBuiltInSnapshotKey& key,
+                                   TSymbolTable** commonTables, int commonCount,
+                                   TSymbolTable** stageTables, int stageCount, const int* stageCommonIndex)
+{
+    for (int t = 0; t < commonCount; ++t)
+        commonTables[t] = nullptr;
+    for (int t = 0; t < stageCount; ++t)
+        stageTables[t] = nullptr;
+
+    TSnapshotReader reader(data, size);
+    if (! MatchKey(reader, key, commonCount, stageCount))
+        return false;
+
+    unsigned long long checksum = reader.u64();
+    const size_t payloadOffset = reader.position();
+    if (! reader.ok() ||
+        HashBuiltInText(reinterpret_cast<const char*>(data + payloadOffset), size - payloadOffset) != checksum)
+        return false;
+
+    for (int t = 0; t < commonCount + stageCount && reader.ok(); ++t) {
+        if (! reader.flag())
+            continue;
+        TSymbolTable* table = new TSymbolTable;
+        if (t < commonCount)
+            commonTables[t] = table;
+        else {
+            stageTables[t - commonCount] = table;
+            TSymbolTable* common = commonTables[stageCommonIndex[t - commonCount]];
+            if (common == nullptr) {
+                reader.fail();
+                break;
+            }
+            table->adoptLevels(*common);
+        }
+        readTable(reader, *table);
+    }
+
+    if (reader.ok() && reader.atEnd())
+        return true;
+
+    // Stage tables first, they adopted levels owned by the common tables.
+    for (int t = 0; t < stageCount; ++t) {
+        delete stageTables[t];
+        stageTables[t] = nullptr;
+    }
+    for (int t = 0; t < commonCount; ++t) {
+        delete commonTables[t];
+        commonTables[t] = nullptr;
+    }
+
+    return false;
+}
+
+bool TBuiltInSnapshot::readKey(const unsigned char* data, size_t size, TBuiltInSnapshotKey& key)
+{
+    TSnapshotReader reader(data, size);
+    bool known = reader.u32() == SnapshotMagic;
+    known = reader.u32() == SnapshotFormatVersion && known;
+    known = reader.u32() == sizeof(TQualifier) && known;
+    known = reader.u32() == sizeof(TSampler) && known;
+    key.version = reader.i32();
+    key.profile = static_cast<EProfile>(reader.i32());
+    key.spvVersion.spv = reader.u32();
+    key.spvVersion.vulkanGlsl = reader.i32();
+    key.spvVersion.vulkan = reader.i32();
+    key.spvVersion.openGl = reader.i32();
+    key.spvVersion.vulkanRelaxed = reader.flag();
+    key.source = static_cast<EShSource>(reader.i32());
+    key.textHash = reader.u64();
+
+    return known && reader.ok();
+}
+
+bool TBuiltInSnapshot::write(const char* path, const TBuiltInSnapshotKey& key,
+                             const TSymbolTable* const* commonTables, int commonCount,
+                             const TSymbolTable* const* stageTables, int stageCount)
+{
+    std::vector<unsigned char> data;
+    if (! serialize(data, key, commonTables, commonCount, stageTables, stageCount))
+        return false;
+
+    std::string temporary = std::string(path) + "." +
+                            std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+                            std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = fclose(file) == 0 && written;
+
+    // rename() does not replace an existing file everywhere; if another process
+    // got there first, its snapshot is just as good.
+    if (! written || rename(temporary.c_str(), path) != 0) {
+        remove(temporary.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool TBuiltInSnapshot::read(const char* path, const TBuiltInSnapshotKey& key,
+                            TSymbolTable** commonTables, int commonCount,
+                            TSymbolTable** stageTables, int stageCount, const int* stageCommonIndex)
+{
+    size_t size = 0;
+    const void* data = OS_MapFile(path, size);
+    if (data == nullptr)
+        return false;
+
+    bool success = deserialize(static_cast<const unsigned char*>(data), size, key, commonTables, commonCount,
+                               stageTables, stageCount, stageCommonIndex);
+    OS_UnmapFile(data, size);
+
+    return success;
+}
+
+unsigned long long TBuiltInSnapshot::HashBuiltInText(const char* text, size_t length, unsigned long long hash)
+{
+    for (size_t c = 0; c < length; ++c) {
+        hash ^= static_cast<unsigned char>(text[c]);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+} // end namespace glslang
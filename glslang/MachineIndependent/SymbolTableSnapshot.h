@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef _SYMBOL_TABLE_SNAPSHOT_INCLUDED_
+#define _SYMBOL_TABLE_SNAPSHOT_INCLUDED_
+
+//
+// Binary snapshots of the process-wide built-in symbol tables.
+//
+// Building the built-in tables means generating the built-in declarations as
+// text and running them through the full parser, which dominates start-up time
+// of short-lived processes.  A snapshot stores the resulting levels (functions,
+// variables, types, constant values and extension gating) so a later process
+// can rebuild the same tables without parsing.
+//
+// A snapshot only describes the levels owned by each table; stage tables are
+// expected to have already adopted their common table's levels when read.
+//
+// The format is tied to the glslang build that wrote it: the header records a
+// format version, the layout of the types copied bit-for-bit, and a hash of the
+// built-in declarations text, and a snapshot whose header does not match is
+// rejected, so the caller can fall back to parsing.
+//
+
+#include <cstddef>
+#include <vector>
+
+#include "../Include/Types.h"
+#include "../Public/ShaderLang.h"
+#include "Versions.h"
+
+namespace glslang {
+
+class TSymbolTable;
+class TSymbolTableLevel;
+class TSymbol;
+class TType;
+class TSnapshotWriter;
+class TSnapshotReader;
+
+// Identifies which built-ins a snapshot holds.  Reading succeeds only if the
+// snapshot was written with an identical key.
+struct TBuiltInSnapshotKey {
+    int version;
+    EProfile profile;
+    SpvVersion spvVersion;
+    EShSource source;
+    unsigned long long textHash; // hash of the built-in declarations text, see HashBuiltInText()
+};
+
+class TBuiltInSnapshot {
+public:
+    // Serialize the levels owned by the given tables.  nullptr entries are
+    // allowed and recorded as absent.  Returns false if a table holds something
+    // the format cannot represent (e.g. specialization-constant array sizes).
+    static bool serialize(std::vector<unsigned char>& out, const TBuiltInSnapshotKey& key,
+                          const TSymbolTable* const* commonTables, int commonCount,
+                          const TSymbolTable* const* stageTables, int stageCount);
+
+    // Rebuild tables from a serialized snapshot, allocating from the current
+    // thread's pool.  Present tables are created with 'new'; each stage table
+    // first adopts the levels of commonTables[stageCommonIndex[stage]].  On
+    // failure, nothing is left allocated and all entries are nullptr.
+    static bool deserialize(const unsigned char* data, size_t size, const TBuiltInSnapshotKey& key,
+                            TSymbolTable** commonTables, int commonCount,
+                            TSymbolTable** stageTables, int stageCount, const int* stageCommonIndex);
+
+    // Read just the key a serialized snapshot was written with, e.g. to pick one
+    // of several embedded snapshots.  Returns false if 'data' is not a snapshot
+    // this build can read.
+    static bool readKey(const unsigned char* data, size_t size, TBuiltInSnapshotKey& key);
+
+    // File wrappers around the above.  Writing goes through a temporary file
+    // that is renamed into place, so concurrent readers and writers of the same
+    // path never see a partial snapshot.
+    static bool write(const char* path, const TBuiltInSnapshotKey& key,
+                      const TSymbolTable* const* commonTables, int commonCount,
+                      const TSymbolTable* const* stageTables, int stageCount);
+    static bool read(const char* path, const TBuiltInSnapshotKey& key,
+                     TSymbolTable** commonTables, int commonCount,
+                     TSymbolTable** stageTables, int stageCount, const int* stageCommonIndex);
+
+    // 64-bit FNV-1a hash, used to fingerprint the built-in declarations text.
+    static unsigned long long HashBuiltInText(const char* text, size_t length,
+                                              unsigned long long hash = 0xcbf29ce484222325ULL);
+
+private:
+    static bool writeTable(TSnapshotWriter&, const TSymbolTable&);
+    static bool writeLevel(TSnapshotWriter&, const TSymbolTableLevel&);
+    static bool writeSymbol(TSnapshotWriter&, const TSymbol&);
+    static bool writeType(TSnapshotWriter&, const TType&, TVector<const TTypeList*>& structures);
+    static bool writeArraySizes(TSnapshotWriter&, const TArraySizes&);
+    static bool readTable(TSnapshotReader&, TSymbolTable&);
+    static bool readLevel(TSnapshotReader&, TSymbolTableLevel&);
+    static TSymbol* readSymbol(TSnapshotReader&, int kind);
+    static bool readType(TSnapshotReader&, TType&, TVector<TTypeList*>& structures);
+    static TArraySizes* readArraySizes(TSnapshotReader&);
+};
+
+} // end namespace glslang
+
+#endif // _SYMBOL_TABLE_SNAPSHOT_INCLUDED_
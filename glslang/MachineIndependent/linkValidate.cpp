@@ -52,6 +52,11 @@
 #include "SymbolTable.h"
 #include "LiveTraverser.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace glslang {
 
 //
@@ -150,6 +155,55 @@ static bool isSameSymbol(TIntermSymbol* symbol1, TIntermSymbol* symbol2) {
     return false;
 }
 
+//
+// Linker objects indexed by what isSameSymbol() matches them on, so each object of
+// a unit is only checked against the few objects it could be, rather than all of them.
+//
+class TLinkerObjectIndex {
+public:
+    // Index the first 'count' objects of 'linkerObjects'.
+    TLinkerObjectIndex(const TIntermSequence& linkerObjects, std::size_t count)
+    {
+        for (std::size_t linkObj = 0; linkObj < count; ++linkObj) {
+            const TIntermSymbol* symbol = linkerObjects[linkObj]->getAsSymbolNode();
+            byName[symbol->getName()].push_back(linkObj);
+            if (symbol->getBasicType() == EbtBlock)
+                byBlockName[symbol->getType().getTypeName()].push_back(linkObj);
+            if (symbol->getQualifier().isPushConstant())
+                pushConstants.push_back(linkObj);
+        }
+    }
+
+    // The indices, in order, of the objects that can be the same symbol as
+    // 'unitSymbol', plus the push_constant blocks if those have to be checked too.
+    void find(const TIntermSymbol& unitSymbol, bool withPushConstants, std::vector<std::size_t>& candidates) const
+    {
+        candidates.clear();
+        append(byName, unitSymbol.getName(), candidates);
+        if (unitSymbol.getBasicType() == EbtBlock)
+            append(byBlockName, unitSymbol.getType().getTypeName(), candidates);
+        if (withPushConstants && unitSymbol.getQualifier().isPushConstant())
+            candidates.insert(candidates.end(), pushConstants.begin(), pushConstants.end());
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+protected:
+    typedef std::unordered_map<TString, std::vector<std::size_t>> TIndexMap;
+
+    static void append(const TIndexMap& map, const TString& name, std::vector<std::size_t>& candidates)
+    {
+        auto found = map.find(name);
+        if (found != map.end())
+            candidates.insert(candidates.end(), found->second.begin(), found->second.end());
+    }
+
+    TIndexMap byName;
+    TIndexMap byBlockName;
+    std::vector<std::size_t> pushConstants;
+};
+
 //
 // merge implicit array sizes for uniform/buffer objects
 //
@@ -167,9 +221,11 @@ void TIntermediate::mergeImplicitArraySizes(TInfoSink&, TIntermediate& unit) {
                                       node->getAsSymbolNode()->getQualifier().storage != EvqBuffer; });
     unitLinkerObjects.resize(end - unitLinkerObjects.begin());
 
-    std::size_t initialNumLinkerObjects = linkerObjects.size();
+    const TLinkerObjectIndex index(linkerObjects, linkerObjects.size());
+    std::vector<std::size_t> candidates;
     for (unsigned int unitLinkObj = 0; unitLinkObj < unitLinkerObjects.size(); ++unitLinkObj) {
-        for (std::size_t linkObj = 0; linkObj < initialNumLinkerObjects; ++linkObj) {
+        index.find(*unitLinkerObjects[unitLinkObj]->getAsSymbolNode(), false, candidates);
+        for (std::size_t linkObj : candidates) {
             TIntermSymbol* symbol = linkerObjects[linkObj]->getAsSymbolNode();
             TIntermSymbol* unitSymbol = unitLinkerObjects[unitLinkObj]->getAsSymbolNode();
             assert(symbol && unitSymbol);
@@ -828,17 +884,25 @@ void TIntermediate::remapIds(const TIdMaps& idMaps, long long idShift, TIntermed
 //
 void TIntermediate::mergeBodies(TInfoSink& infoSink, TIntermSequence& globals, const TIntermSequence& unitGlobals)
 {
-    // TODO: link-time performance: Processing in alphabetical order will be faster
+    // Count the unit's bodies by signature, so each global is looked up once
+    std::unordered_map<TString, int> unitBodies;
+    for (unsigned int unitChild = 0; unitChild < unitGlobals.size() - 1; ++unitChild) {
+        TIntermAggregate* unitBody = unitGlobals[unitChild]->getAsAggregate();
+        if (unitBody && unitBody->getOp() == EOpFunction)
+            ++unitBodies[unitBody->getName()];
+    }
 
     // Error check the global objects, not including the linker objects
-    for (unsigned int child = 0; child < globals.size() - 1; ++child) {
-        for (unsigned int unitChild = 0; unitChild < unitGlobals.size() - 1; ++unitChild) {
-            TIntermAggregate* body = globals[child]->getAsAggregate();
-            TIntermAggregate* unitBody = unitGlobals[unitChild]->getAsAggregate();
-            if (body && unitBody && body->getOp() == EOpFunction && unitBody->getOp() == EOpFunction && body->getName() == unitBody->getName()) {
-                error(infoSink, "Multiple function bodies in multiple compilation units for the same signature in the same stage:");
-                infoSink.info << "    " << globals[child]->getAsAggregate()->getName() << "\n";
-            }
+    for (unsigned int child = 0; child < globals.size() - 1 && ! unitBodies.empty(); ++child) {
+        TIntermAggregate* body = globals[child]->getAsAggregate();
+        if (body == nullptr || body->getOp() != EOpFunction)
+            continue;
+        auto unitBody = unitBodies.find(body->getName());
+        if (unitBody == unitBodies.end())
+            continue;
+        for (int count = 0; count < unitBody->second; ++count) {
+            error(infoSink, "Multiple function bodies in multiple compilation units for the same signature in the same stage:");
+            infoSink.info << "    " << body->getName() << "\n";
         }
     }
 
@@ -1030,9 +1094,12 @@ void TIntermediate::mergeLinkerObjects(TInfoSink& infoSink, TIntermSequence& lin
 {
     // Error check and merge the linker objects (duplicates should not be created)
     std::size_t initialNumLinkerObjects = linkerObjects.size();
+    const TLinkerObjectIndex index(linkerObjects, initialNumLinkerObjects);
+    std::vector<std::size_t> candidates;
     for (unsigned int unitLinkObj = 0; unitLinkObj < unitLinkerObjects.size(); ++unitLinkObj) {
         bool merge = true;
-        for (std::size_t linkObj = 0; linkObj < initialNumLinkerObjects; ++linkObj) {
+        index.find(*unitLinkerObjects[unitLinkObj]->getAsSymbolNode(), getStage() == unitStage, candidates);
+        for (std::size_t linkObj : candidates) {
             TIntermSymbol* symbol = linkerObjects[linkObj]->getAsSymbolNode();
             TIntermSymbol* unitSymbol = unitLinkerObjects[unitLinkObj]->getAsSymbolNode();
             assert(symbol && unitSymbol);
@@ -1705,85 +1772,130 @@ void TIntermediate::finalCheck(TInfoSink& infoSink, bool keepUncalled)
     }
 }
 
+//
+// Random access to the call graph.  Function names are interned to dense ids,
+// and the calls are bucketed by caller id, keeping graph order within a bucket,
+// so the calls made by a callee are found without rescanning the whole graph.
+//
+class TCallGraphIndex {
+public:
+    explicit TCallGraphIndex(std::list<TCall>& graph)
+    {
+        calls.reserve(graph.size());
+        callers.reserve(graph.size());
+        callees.reserve(graph.size());
+        for (TCall& call : graph) {
+            calls.push_back(&call);
+            callers.push_back(intern(call.caller));
+            callees.push_back(intern(call.callee));
+        }
+
+        // Counting sort of the calls by caller, stable so graph order is kept.
+        firstCall.assign(ids.size() + 1, 0);
+        for (int caller : callers)
+            ++firstCall[caller + 1];
+        for (size_t f = 0; f < ids.size(); ++f)
+            firstCall[f + 1] += firstCall[f];
+        callsByCaller.resize(calls.size());
+        std::vector<int> next(firstCall.begin(), firstCall.end() - 1);
+        for (int c = 0; c < (int)calls.size(); ++c)
+            callsByCaller[next[callers[c]]++] = c;
+    }
+
+    int size() const { return (int)calls.size(); }
+    int functionCount() const { return (int)ids.size(); }
+    TCall& call(int c) const { return *calls[c]; }
+    int caller(int c) const { return callers[c]; }
+    int callee(int c) const { return callees[c]; }
+
+    // Id of the function 'name', or -1 if it is in no call.
+    int find(const TString& name) const
+    {
+        auto it = ids.find(name);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+    // Calls made by function 'f', as [begin, end) into the call indexes.
+    const int* callsFromBegin(int f) const { return callsByCaller.data() + firstCall[f]; }
+    const int* callsFromEnd(int f) const { return callsByCaller.data() + firstCall[f + 1]; }
+
+protected:
+    int intern(const TString& name) { return ids.emplace(name, (int)ids.size()).first->second; }
+
+    std::unordered_map<TString, int> ids;
+    std::vector<TCall*> calls;
+    std::vector<int> callers;
+    std::vector<int> callees;
+    std::vector<int> firstCall;
+    std::vector<int> callsByCaller;
+};
+
 //
 // See if the call graph contains any static recursion, which is disallowed
 // by the specification.
 //
 void TIntermediate::checkCallGraphCycles(TInfoSink& infoSink)
 {
+    TCallGraphIndex graph(callGraph);
+
     // Clear fields we'll use for this.
-    for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
-        call->visited = false;
-        call->currentPath = false;
-        call->errorGiven = false;
+    for (int c = 0; c < graph.size(); ++c) {
+        graph.call(c).visited = false;
+        graph.call(c).currentPath = false;
+        graph.call(c).errorGiven = false;
     }
 
     //
-    // Loop, looking for a new connected subgraph.  One subgraph is handled per loop iteration.
+    // Depth-first traversal of the calls, rooted at each call not yet visited, in
+    // graph order.  A call to a function whose own call is still on the current path
+    // is a back edge, thereby detecting recursion.  Each stack entry remembers how
+    // many of its callee's calls it has examined, so every call is pushed once and
+    // every edge examined once.
     //
+    std::vector<std::pair<int, const int*>> stack;
+    for (int root = 0; root < graph.size(); ++root) {
+        if (graph.call(root).visited)
+            continue;
 
-    TCall* newRoot;
-    do {
-        // See if we have unvisited parts of the graph.
-        newRoot = nullptr;
-        for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
-            if (! call->visited) {
-                newRoot = &(*call);
-                break;
-            }
-        }
-
-        // If not, we are done.
-        if (! newRoot)
-            break;
-
-        // Otherwise, we found a new subgraph, process it:
-        // See what all can be reached by this new root, and if any of
-        // that is recursive.  This is done by depth-first traversals, seeing
-        // if a new call is found that was already in the currentPath (a back edge),
-        // thereby detecting recursion.
-        std::list<TCall*> stack;
-        newRoot->currentPath = true; // currentPath will be true iff it is on the stack
-        stack.push_back(newRoot);
+        graph.call(root).currentPath = true; // currentPath will be true iff it is on the stack
+        stack.emplace_back(root, graph.callsFromBegin(graph.callee(root)));
         while (! stack.empty()) {
             // get a caller
-            TCall* call = stack.back();
+            const int call = stack.back().first;
+            const int* child = stack.back().second;
+            const int* end = graph.callsFromEnd(graph.callee(call));
 
             // Add to the stack just one callee.
-            // This algorithm always terminates, because only !visited and !currentPath causes a push
-            // and all pushes change currentPath to true, and all pops change visited to true.
-            TGraph::iterator child = callGraph.begin();
-            for (; child != callGraph.end(); ++child) {
+            for (; child != end; ++child) {
+                TCall& callee = graph.call(*child);
 
                 // If we already visited this node, its whole subgraph has already been processed, so skip it.
-                if (child->visited)
+                if (callee.visited)
                     continue;
 
-                if (call->callee == child->caller) {
-                    if (child->currentPath) {
-                        // Then, we found a back edge
-                        if (! child->errorGiven) {
-                            error(infoSink, "Recursion detected:");
-                            infoSink.info << "    " << call->callee << " calling " << child->callee << "\n";
-                            child->errorGiven = true;
-                            recursive = true;
-                        }
-                    } else {
-                        child->currentPath = true;
-                        stack.push_back(&(*child));
-                        break;
+                if (callee.currentPath) {
+                    // Then, we found a back edge
+                    if (! callee.errorGiven) {
+                        error(infoSink, "Recursion detected:");
+                        infoSink.info << "    " << graph.call(call).callee << " calling " << callee.callee << "\n";
+                        callee.errorGiven = true;
+                        recursive = true;
                     }
-                }
+                } else
+                    break;
             }
-            if (child == callGraph.end()) {
+            if (child == end) {
                 // no more callees, we bottomed out, never look at this node again
-                stack.back()->currentPath = false;
-                stack.back()->visited = true;
+                graph.call(call).currentPath = false;
+                graph.call(call).visited = true;
                 stack.pop_back();
+            } else {
+                stack.back().second = child + 1;
+                graph.call(*child).currentPath = true;
+                stack.emplace_back(*child, graph.callsFromBegin(graph.callee(*child)));
             }
         }  // end while, meaning nothing left to process in this subtree
-
-    } while (newRoot);  // redundant loop check; should always exit via the 'break' above
+    }
 }
 
 //
@@ -1793,11 +1905,11 @@ void TIntermediate::checkCallGraphCycles(TInfoSink& infoSink)
 //
 void TIntermediate::checkCallGraphBodies(TInfoSink& infoSink, bool keepUncalled)
 {
+    TCallGraphIndex graph(callGraph);
+
     // Clear fields we'll use for this.
-    for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
-        call->visited = false;
-        call->calleeBodyPosition = -1;
-    }
+    for (int c = 0; c < graph.size(); ++c)
+        graph.call(c).visited = false;
 
     // The top level of the AST includes function definitions (bodies).
     // Compare these to function calls in the call graph.
@@ -1805,42 +1917,42 @@ void TIntermediate::checkCallGraphBodies(TInfoSink& infoSink, bool keepUncalled)
     // how to map the call-graph node to the location in the AST.
     TIntermSequence &functionSequence = getTreeRoot()->getAsAggregate()->getSequence();
     std::vector<bool> reachable(functionSequence.size(), true); // so that non-functions are reachable
+    std::vector<int> bodyPosition(graph.functionCount(), -1);
     for (int f = 0; f < (int)functionSequence.size(); ++f) {
         glslang::TIntermAggregate* node = functionSequence[f]->getAsAggregate();
         if (node && (node->getOp() == glslang::EOpFunction)) {
             if (node->getName().compare(getEntryPointMangledName().c_str()) != 0)
                 reachable[f] = false; // so that function bodies are unreachable, until proven otherwise
-            for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
-                if (call->callee == node->getName())
-                    call->calleeBodyPosition = f;
-            }
+            const int function = graph.find(node->getName());
+            if (function >= 0)
+                bodyPosition[function] = f;
         }
     }
+    for (int c = 0; c < graph.size(); ++c)
+        graph.call(c).calleeBodyPosition = bodyPosition[graph.callee(c)];
 
     // Start call-graph traversal by visiting the entry point nodes.
-    for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
-        if (call->caller.compare(getEntryPointMangledName().c_str()) == 0)
-            call->visited = true;
+    std::vector<int> worklist;
+    const int entryPoint = graph.find(getEntryPointMangledName().c_str());
+    if (entryPoint >= 0) {
+        for (const int* call = graph.callsFromBegin(entryPoint); call != graph.callsFromEnd(entryPoint); ++call) {
+            graph.call(*call).visited = true;
+            worklist.push_back(*call);
+        }
     }
 
     // Propagate 'visited' through the call-graph to every part of the graph it
     // can reach (seeded with the entry-point setting above).
-    bool changed;
-    do {
-        changed = false;
-        for (auto call1 = callGraph.begin(); call1 != callGraph.end(); ++call1) {
-            if (call1->visited) {
-                for (TGraph::iterator call2 = callGraph.begin(); call2 != callGraph.end(); ++call2) {
-                    if (! call2->visited) {
-                        if (call1->callee == call2->caller) {
-                            changed = true;
-                            call2->visited = true;
-                        }
-                    }
-                }
+    while (! worklist.empty()) {
+        const int callee = graph.callee(worklist.back());
+        worklist.pop_back();
+        for (const int* call = graph.callsFromBegin(callee); call != graph.callsFromEnd(callee); ++call) {
+            if (! graph.call(*call).visited) {
+                graph.call(*call).visited = true;
+                worklist.push_back(*call);
             }
         }
-    } while (changed);
+    }
 
     // Any call-graph node set to visited but without a callee body is an error.
     for (TGraph::iterator call = callGraph.begin(); call != callGraph.end(); ++call) {
@@ -97,7 +97,7 @@ private:
 
 // Used for call-graph algorithms for detecting recursion, missing bodies, and dead bodies.
 // A "call" is a pair: <caller, callee>.
-// There can be duplicates. General assumption is the list is small.
+// There can be duplicates. Link-time checks index the list; see TCallGraphIndex.
 struct TCall {
     TCall(const TString& pCaller, const TString& pCallee)
         : caller(pCaller), callee(pCallee), visited(false), currentPath(false), errorGiven(false) { }
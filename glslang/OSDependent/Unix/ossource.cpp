@@ -39,6 +39,11 @@
 
 #include <cstdio>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #if !defined(__Fuchsia__)
 #include <sys/resource.h>
 #endif
@@ -59,4 +64,67 @@ void OS_DumpMemoryCounters()
 #endif
 }
 
+const void* OS_MapFile(const char* path, size_t& size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    size = static_cast<size_t>(status.st_size);
+    return data;
+}
+
+void* OS_MapFileForWrite(const char* path, size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return nullptr;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return data == MAP_FAILED ? nullptr : data;
+}
+
+void OS_UnmapFile(const void* data, size_t size)
+{
+    if (data != nullptr)
+        munmap(const_cast<void*>(data), size);
+}
+
+bool OS_GetFileStamp(const char* path, size_t& size, long long& modified)
+{
+    struct stat status;
+    if (stat(path, &status) != 0 || ! S_ISREG(status.st_mode))
+        return false;
+
+    size = static_cast<size_t>(status.st_size);
+#if defined(__APPLE__)
+    modified = static_cast<long long>(status.st_mtimespec.tv_sec) * 1000000000ll + status.st_mtimespec.tv_nsec;
+#else
+    modified = static_cast<long long>(status.st_mtim.tv_sec) * 1000000000ll + status.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
 } // end namespace glslang
@@ -43,6 +43,9 @@
 
 #include "../../../SPIRV/GlslangToSpv.h"
 #include "../../../glslang/Public/ShaderLang.h"
+#ifdef GLSLANG_PREBUILT_BUILTINS
+#include "../../../glslang/Public/PrebuiltBuiltIns.h"
+#endif
 
 #ifndef __EMSCRIPTEN__
 #define EMSCRIPTEN_KEEPALIVE
@@ -223,6 +226,9 @@ void* convert_glsl_to_spirv(const char* glsl,
     }
 
     if (!initialized) {
+#ifdef GLSLANG_PREBUILT_BUILTINS
+        glslang::AddPrebuiltBuiltInSymbolTables();
+#endif
         glslang::InitializeProcess();
         initialized = true;
     }
@@ -64,4 +64,76 @@ void OS_DumpMemoryCounters()
 #endif
 }
 
+const void* OS_MapFile(const char* path, size_t& size)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (! GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+        return nullptr;
+
+    // the view keeps the mapping alive
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr)
+        return nullptr;
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return data;
+}
+
+void* OS_MapFileForWrite(const char* path, size_t size)
+{
+    if (size == 0)
+        return nullptr;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    // creating the mapping at 'size' also extends the file to that length
+    const unsigned long long length = size;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(length >> 32),
+                                        static_cast<DWORD>(length & 0xFFFFFFFF), nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+        return nullptr;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    CloseHandle(mapping);
+
+    return data;
+}
+
+void OS_UnmapFile(const void* data, size_t /*size*/)
+{
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+}
+
+bool OS_GetFileStamp(const char* path, size_t& size, long long& modified)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (! GetFileAttributesExA(path, GetFileExInfoStandard, &attributes) ||
+        (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        return false;
+
+    size = static_cast<size_t>((static_cast<unsigned long long>(attributes.nFileSizeHigh) << 32) |
+                               attributes.nFileSizeLow);
+    modified = static_cast<long long>((static_cast<unsigned long long>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                                      attributes.ftLastWriteTime.dwLowDateTime);
+    return true;
+}
+
 } // namespace glslang
@@ -35,11 +35,27 @@
 #ifndef __OSINCLUDE_H
 #define __OSINCLUDE_H
 
+#include <cstddef>
+
 #include "../Include/visibility.h"
 namespace glslang {
 
 GLSLANG_EXPORT void OS_DumpMemoryCounters();
 
+// Map a whole file read-only into memory.  Returns nullptr, leaving 'size'
+// untouched, if the file cannot be opened or is empty.  Release with OS_UnmapFile().
+GLSLANG_EXPORT const void* OS_MapFile(const char* path, size_t& size);
+GLSLANG_EXPORT void OS_UnmapFile(const void* data, size_t size);
+
+// Create (or truncate) 'path' to exactly 'size' bytes and map it writable.  Stores
+// go to the file; release with OS_UnmapFile().  Returns nullptr on failure or if
+// 'size' is zero.
+GLSLANG_EXPORT void* OS_MapFileForWrite(const char* path, size_t size);
+
+// Size and last-modification time, in an OS-specific unit, of the regular file
+// at 'path'.  Returns false if there is no such file.
+GLSLANG_EXPORT bool OS_GetFileStamp(const char* path, size_t& size, long long& modified);
+
 } // end namespace glslang
 
 #endif // __OSINCLUDE_H
@@ -0,0 +1,263 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//
+// glslang-gen-builtins: build-time generator for the glslang-prebuilt-builtins
+// library.
+//
+// Builds the built-in symbol tables for each requested configuration, the same
+// way a first compile would, and writes them out as C++ arrays holding their
+// snapshots together with AddPrebuiltBuiltInSymbolTables() to register them.
+//
+// Usage: glslang-gen-builtins <output.cpp> <work-dir> <spec>...
+//
+// where each <spec> is <source>:<version>:<profile>:<client>, with
+//     source   glsl | hlsl
+//     profile  none | core | compatibility | es
+//     client   none | opengl | vulkan | vulkan-relaxed
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace {
+
+struct TBuiltInSpec {
+    std::string text;
+    glslang::EShSource source;
+    int version;
+    EProfile profile;
+    glslang::EShClient client;
+    bool relaxed;
+};
+
+bool ParseSpec(const std::string& text, TBuiltInSpec& spec)
+{
+    std::vector<std::string> fields;
+    std::istringstream stream(text);
+    for (std::string field; std::getline(stream, field, ':'); )
+        fields.push_back(field);
+    if (fields.size() != 4)
+        return false;
+
+    spec.text = text;
+    if (fields[0] == "glsl")
+        spec.source = glslang::EShSourceGlsl;
+    else if (fields[0] == "hlsl")
+        spec.source = glslang::EShSourceHlsl;
+    else
+        return false;
+
+    spec.version = atoi(fields[1].c_str());
+    if (spec.version <= 0)
+        return false;
+
+    if (fields[2] == "none")
+        spec.profile = ENoProfile;
+    else if (fields[2] == "core")
+        spec.profile = ECoreProfile;
+    else if (fields[2] == "compatibility")
+        spec.profile = ECompatibilityProfile;
+    else if (fields[2] == "es")
+        spec.profile = EEsProfile;
+    else
+        return false;
+
+    spec.relaxed = false;
+    if (fields[3] == "none")
+        spec.client = glslang::EShClientNone;
+    else if (fields[3] == "opengl")
+        spec.client = glslang::EShClientOpenGL;
+    else if (fields[3] == "vulkan")
+        spec.client = glslang::EShClientVulkan;
+    else if (fields[3] == "vulkan-relaxed") {
+        spec.client = glslang::EShClientVulkan;
+        spec.relaxed = true;
+    } else
+        return false;
+
+    return true;
+}
+
+// Compiling any shader for the configuration builds (and, with a cache
+// directory set, saves) its built-in tables; the shader itself is irrelevant.
+void BuildBuiltIns(const TBuiltInSpec& spec)
+{
+    const EShLanguage stage = EShLangVertex;
+    const char* text = "void main() { }\n";
+
+    glslang::TShader shader(stage);
+    shader.setStrings(&text, 1);
+    shader.setEntryPoint("main");
+
+    int messages = EShMsgDefault;
+    if (spec.source == glslang::EShSourceHlsl)
+        messages |= EShMsgReadHlsl;
+    if (spec.client != glslang::EShClientNone) {
+        shader.setEnvInput(spec.source, stage, spec.client, 100);
+        if (spec.client == glslang::EShClientVulkan) {
+            shader.setEnvClient(spec.client, glslang::EShTargetVulkan_1_0);
+            messages |= EShMsgSpvRules | EShMsgVulkanRules;
+        } else {
+            shader.setEnvClient(spec.client, glslang::EShTargetOpenGL_450);
+            messages |= EShMsgSpvRules;
+        }
+        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+        if (spec.relaxed)
+            shader.setEnvInputVulkanRulesRelaxed();
+    } else if (spec.source == glslang::EShSourceHlsl)
+        shader.setEnvInput(spec.source, stage, glslang::EShClientNone, 100);
+
+    shader.parse(GetDefaultResources(), spec.version, spec.profile, true, false, (EShMessages)messages);
+}
+
+// Little-endian 32-bit words keep the initializer list short; on a big-endian
+// target the bytes come out permuted, the snapshot header no longer matches,
+// and glslang simply parses the built-ins instead.
+void WriteImage(std::ostream& out, const std::string& name, const std::vector<unsigned char>& bytes)
+{
+    out << "const unsigned int " << name << "[] = {";
+    char word[16];
+    for (size_t b = 0; b < bytes.size(); b += 4) {
+        unsigned int value = 0;
+        for (size_t i = 0; i < 4 && b + i < bytes.size(); ++i)
+            value |= static_cast<unsigned int>(bytes[b + i]) << (8 * i);
+        snprintf(word, sizeof(word), "0x%08x,", value);
+        out << ((b / 4) % 8 == 0 ? "\n    " : " ") << word;
+    }
+    out << "\n};\n\n";
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.cpp> <work-dir> <source>:<version>:<profile>:<client>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<TBuiltInSpec> specs;
+    for (int a = 3; a < argc; ++a) {
+        TBuiltInSpec spec;
+        if (! ParseSpec(argv[a], spec)) {
+            fprintf(stderr, "%s: invalid built-in configuration '%s'\n", argv[0], argv[a]);
+            return EXIT_FAILURE;
+        }
+        specs.push_back(spec);
+    }
+
+    // Start from an empty work directory so only this run's snapshots are embedded.
+    const std::filesystem::path workDir(argv[2]);
+    std::error_code error;
+    std::filesystem::remove_all(workDir, error);
+    if (! std::filesystem::create_directories(workDir, error)) {
+        fprintf(stderr, "%s: cannot create '%s'\n", argv[0], argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    glslang::SetBuiltInSymbolTableCacheDirectory(workDir.string().c_str());
+    glslang::InitializeProcess();
+    for (const TBuiltInSpec& spec : specs)
+        BuildBuiltIns(spec);
+    glslang::FinalizeProcess();
+
+    // Several configurations can share one set of tables.
+    std::set<std::filesystem::path> snapshots;
+    for (const auto& entry : std::filesystem::directory_iterator(workDir))
+        snapshots.insert(entry.path());
+
+    std::ostringstream out;
+    out << "// Generated by glslang-gen-builtins; do not edit.\n"
+           "//\n"
+           "// Configurations:\n";
+    for (const TBuiltInSpec& spec : specs)
+        out << "//     " << spec.text << "\n";
+    out << "\n"
+           "#include \"glslang/Public/PrebuiltBuiltIns.h\"\n"
+           "#include \"glslang/Public/ShaderLang.h\"\n"
+           "\n"
+           "namespace {\n"
+           "\n";
+
+    std::vector<size_t> sizes;
+    for (const std::filesystem::path& snapshot : snapshots) {
+        std::ifstream in(snapshot, std::ios::binary);
+        std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (! in.good() && ! in.eof()) {
+            fprintf(stderr, "%s: cannot read '%s'\n", argv[0], snapshot.string().c_str());
+            return EXIT_FAILURE;
+        }
+        out << "// " << snapshot.filename().string() << "\n";
+        WriteImage(out, "Image" + std::to_string(sizes.size()), bytes);
+        sizes.push_back(bytes.size());
+    }
+    if (sizes.empty()) {
+        fprintf(stderr, "%s: no built-in tables were produced\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    out << "} // end anonymous namespace\n"
+           "\n"
+           "void glslang::AddPrebuiltBuiltInSymbolTables()\n"
+           "{\n"
+           "    static const glslang::TBuiltInSymbolTableImage images[] = {\n";
+    for (size_t i = 0; i < sizes.size(); ++i)
+        out << "        { Image" << i << ", " << sizes[i] << " },\n";
+    out << "    };\n"
+           "\n"
+           "    glslang::AddBuiltInSymbolTableImages(images, " << sizes.size() << ");\n"
+           "}\n";
+
+    std::ofstream file(argv[1], std::ios::binary);
+    file << out.str();
+    if (! file.good()) {
+        fprintf(stderr, "%s: cannot write '%s'\n", argv[0], argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
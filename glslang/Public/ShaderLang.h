@@ -426,6 +426,28 @@ GLSLANG_EXPORT bool InitializeProcess();
 // Call once per process to tear down everything
 GLSLANG_EXPORT void FinalizeProcess();
 
+// Persist the built-in symbol tables in 'directory' across processes.
+//
+// When set, the first compile needing a given version/profile loads its
+// built-in symbol tables from a snapshot in this directory instead of parsing
+// the built-in declarations, and writes a snapshot after parsing them when none
+// (or only a stale one) was found.  Snapshots are specific to the glslang build
+// that wrote them.  nullptr or "" disables this, which is the default.
+GLSLANG_EXPORT void SetBuiltInSymbolTableCacheDirectory(const char* directory);
+
+// A built-in symbol table snapshot held in memory, such as the ones the
+// glslang-prebuilt-builtins library embeds at build time.
+struct TBuiltInSymbolTableImage {
+    const void* data;
+    size_t size;
+};
+
+// Offer snapshots to use instead of parsing the built-in declarations.  The
+// data is not copied and must outlive the process's use of glslang.  Images
+// that do not match the compile, or were written by a different glslang build,
+// are ignored.
+GLSLANG_EXPORT void AddBuiltInSymbolTableImages(const TBuiltInSymbolTableImage* images, int count);
+
 // Resource type for IO resolver
 enum TResourceType {
     EResSampler,
@@ -446,6 +468,69 @@ enum TBlockStorageClass
     EbsCount,
 };
 
+// What a compile arena has done.  The counts cover the arena's whole life,
+// across reset(); the byte counts of reserved memory are as of the call.
+struct TMemoryStats {
+    size_t allocations = 0;         // requests for memory
+    size_t bytesRequested = 0;      // total asked for by those requests
+    size_t pagesAllocated = 0;      // pages obtained from the OS
+    size_t pagesReused = 0;         // pages served again after being freed
+    size_t largeAllocations = 0;    // requests too big for a page, given a block of their own
+    size_t bytesReserved = 0;       // memory held from the OS, in use or kept for reuse
+    size_t highWaterMark = 0;       // most memory held at once
+    size_t scopeDepth = 0;          // nesting of the allocator's push()es
+    size_t scopeBytesRequested = 0; // bytes requested since the innermost push(); for
+                                    //     a shader, what its last parse allocated
+};
+
+// The memory a compile allocates its trees, types and strings from.
+//
+// A TShader or TProgram made without one owns a private arena.  Handing one in
+// instead lets the caller
+//  - recycle it: after the shaders and programs using it are destructed, reset()
+//    makes its memory available to the next compile without giving it back to
+//    the OS
+//  - measure it: getBytesReserved() is what all compiles in it are holding, and
+//    getStats() breaks down how it got there
+//  - tune it: pages start at 'pageSize' bytes and double with each one taken
+//    from the OS, up to 'maxPageSize'
+//  - move the compile: parse(), link() and the other entry points make their
+//    arena current only for the duration of the call, so a shader can be parsed
+//    on one thread and linked or translated on another.  Work done directly on
+//    the resulting trees, outside those entry points, should hold a Scope.
+//
+// An arena is used by one thread at a time.
+class TCompileArena {
+public:
+    GLSLANG_EXPORT TCompileArena();
+    GLSLANG_EXPORT TCompileArena(int pageSize, int maxPageSize);
+    GLSLANG_EXPORT ~TCompileArena();
+
+    GLSLANG_EXPORT void reset();
+    GLSLANG_EXPORT size_t getBytesReserved() const;
+    GLSLANG_EXPORT TMemoryStats getStats() const;
+    TPoolAllocator& getPool() const { return *pool; }
+
+    // Makes the arena the calling thread's current one until destructed.
+    class Scope {
+    public:
+        GLSLANG_EXPORT explicit Scope(TCompileArena&);
+        GLSLANG_EXPORT ~Scope();
+
+    private:
+        Scope(Scope&);
+        Scope& operator=(Scope&);
+
+        TPoolAllocator* previous;
+    };
+
+private:
+    TCompileArena(TCompileArena&);
+    TCompileArena& operator=(TCompileArena&);
+
+    TPoolAllocator* pool;
+};
+
 class TSymbolTable;
 // Make one TShader per shader that you will link into a program. Then
 //  - provide the shader through setStrings() or setStringsWithLengths()
@@ -467,6 +552,8 @@ class TSymbolTable;
 class TShader {
 public:
     GLSLANG_EXPORT explicit TShader(EShLanguage);
+    // Allocate from 'arena', which must outlive the shader, instead of a private one.
+    GLSLANG_EXPORT TShader(EShLanguage, TCompileArena& arena);
     GLSLANG_EXPORT virtual ~TShader();
     GLSLANG_EXPORT void setStrings(const char* const* s, int n);
     GLSLANG_EXPORT void setStringsWithLengths(
@@ -584,6 +671,18 @@ public:
 	void setBuiltinSymbolTable(TSymbolTable* table){ builtin_symbol_table = table;}
 	TSymbolTable* getBuiltinSymbolTable(){ return builtin_symbol_table; }
 
+    // Wall-clock time of the last parse(), in milliseconds: setting up the
+    // built-in symbol tables for it, and in all.
+    struct ParseTimes {
+        double builtIns = 0;
+        double total = 0;
+    };
+    const ParseTimes& getParseTimes() const { return parseTimes; }
+
+    // Memory use of the shader's arena, which is shared with whatever else
+    // was given the same arena.
+    TMemoryStats getMemoryStats() const { return arena->getStats(); }
+
     // Interface to #include handlers.
     //
     // To support #include, a client of Glslang does the following:
@@ -667,6 +766,24 @@ public:
         virtual void releaseInclude(IncludeResult*) override { }
     };
 
+    // Base for Includers reading the file system.  readFile() maps a file into
+    // memory and shares the mapping, across includers, compiles and threads,
+    // through a process-wide cache keyed by path.  Each read checks the file's
+    // size and modification time, and maps it again if either changed; results
+    // already handed out keep the old contents until they are released.
+    // Note the contents are not null terminated, and that, as with any mapped
+    // file, truncating a file while a compile reads it is not supported.
+    class MappedFileIncluder : public Includer {
+    public:
+        // Returns nullptr if 'path' is not a readable regular file.  The result's
+        // name is 'path'.
+        GLSLANG_EXPORT IncludeResult* readFile(const std::string& path);
+        GLSLANG_EXPORT virtual void releaseInclude(IncludeResult*) override;
+
+        // Unmap the cached files no IncludeResult still refers to.
+        GLSLANG_EXPORT static void purgeCache();
+    };
+
     GLSLANG_EXPORT bool parse(
         const TBuiltInResource*, int defaultVersion, EProfile defaultProfile,
         bool forceDefaultVersionAndProfile, bool forwardCompatible,
@@ -703,9 +820,13 @@ public:
     GLSLANG_EXPORT const char* getInfoDebugLog();
     EShLanguage getStage() const { return stage; }
     TIntermediate* getIntermediate() const { return intermediate; }
+    TCompileArena& getArena() const { return *arena; }
 
 protected:
-    TPoolAllocator* pool;
+    void init();
+
+    TCompileArena* arena;
+    bool ownsArena;
     EShLanguage stage;
     TCompiler* compiler;
     TIntermediate* intermediate;
@@ -737,6 +858,8 @@ protected:
     bool compileOnly = false;
 	TSymbolTable* builtin_symbol_table = nullptr;
 
+    ParseTimes parseTimes;
+
     friend class TProgram;
 
 private:
@@ -884,6 +1007,8 @@ GLSLANG_EXPORT TIoMapper* GetGlslIoMapper();
 class TProgram {
 public:
     GLSLANG_EXPORT TProgram();
+    // Allocate from 'arena', which must outlive the program, instead of a private one.
+    GLSLANG_EXPORT explicit TProgram(TCompileArena& arena);
     GLSLANG_EXPORT virtual ~TProgram();
     void addShader(TShader* shader) { stages[shader->stage].push_back(shader); }
     std::list<TShader*>& getShaders(EShLanguage stage) { return stages[stage]; }
@@ -893,6 +1018,7 @@ public:
     GLSLANG_EXPORT const char* getInfoDebugLog();
 
     TIntermediate* getIntermediate(EShLanguage stage) const { return intermediate[stage]; }
+    TCompileArena& getArena() const { return *arena; }
 
     // Reflection Interface
 
@@ -996,7 +1122,10 @@ protected:
     GLSLANG_EXPORT bool linkStage(EShLanguage, EShMessages);
     GLSLANG_EXPORT bool crossStageCheck(EShMessages);
 
-    TPoolAllocator* pool;
+    void init();
+
+    TCompileArena* arena;
+    bool ownsArena;
     std::list<TShader*> stages[EShLangCount];
     TIntermediate* intermediate[EShLangCount];
     bool newedIntermediate[EShLangCount];      // track which intermediate were "new" versus reusing a singleton unit in a stage
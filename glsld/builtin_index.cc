@@ -0,0 +1,49 @@
+#include "builtin_index.hpp"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+std::shared_ptr<const BuiltinIndex> BuiltinIndex::acquire(Key const& key, Builder const& build)
+{
+    static std::mutex lock;
+    static std::map<Key, std::weak_ptr<const BuiltinIndex>> indexes;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto& slot = indexes[key];
+    if (auto index = slot.lock())
+        return index;
+
+    std::vector<glslang::TSymbol*> symbols;
+    std::shared_ptr<glslang::TShader> owner;
+    build(symbols, owner);
+    auto index = std::make_shared<const BuiltinIndex>(symbols, std::move(owner));
+    slot = index;
+    return index;
+}
+
+BuiltinIndex::BuiltinIndex(std::vector<glslang::TSymbol*> const& symbols, std::shared_ptr<glslang::TShader> owner)
+    : owner_(std::move(owner))
+{
+    symbols_.reserve(symbols.size());
+    for (auto* sym : symbols) {
+        symbols_.emplace_back(sym->getName().c_str(), sym);
+    }
+    std::stable_sort(symbols_.begin(), symbols_.end(),
+                     [](auto const& a, auto const& b) { return a.first < b.first; });
+}
+
+std::vector<glslang::TSymbol*> BuiltinIndex::lookup_by_prefix(std::string const& prefix, bool fullname) const
+{
+    std::vector<glslang::TSymbol*> results;
+    if (prefix.empty())
+        fullname = false;
+    auto pos = std::lower_bound(symbols_.begin(), symbols_.end(), prefix,
+                                [](auto const& entry, std::string const& name) { return entry.first < name; });
+    for (; pos != symbols_.end(); ++pos) {
+        if (fullname ? pos->first != prefix : pos->first.compare(0, prefix.size(), prefix) != 0)
+            break;
+        results.push_back(pos->second);
+    }
+
+    return results;
+}
@@ -0,0 +1,35 @@
+#ifndef __GLSLD_BUILTIN_INDEX_HPP__
+#define __GLSLD_BUILTIN_INDEX_HPP__
+#include "../glslang/MachineIndependent/SymbolTable.h"
+#include "../glslang/Public/ShaderLang.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Builtin symbols of one (version, profile, stage), sorted by name for prefix lookups.
+// Indexes are shared by every document with the same key and freed with the last of them.
+class BuiltinIndex {
+public:
+    typedef std::tuple<int, EProfile, EShLanguage> Key;
+    typedef std::function<void(std::vector<glslang::TSymbol*>& symbols, std::shared_ptr<glslang::TShader>& owner)>
+        Builder;
+
+    // returns the index for key, calling build to collect the symbols if no document holds it
+    static std::shared_ptr<const BuiltinIndex> acquire(Key const& key, Builder const& build);
+
+    BuiltinIndex(std::vector<glslang::TSymbol*> const& symbols, std::shared_ptr<glslang::TShader> owner);
+    BuiltinIndex(const BuiltinIndex&) = delete;
+    BuiltinIndex& operator=(const BuiltinIndex&) = delete;
+
+    std::vector<glslang::TSymbol*> lookup_by_prefix(std::string const& prefix, bool fullname = false) const;
+    size_t size() const { return symbols_.size(); }
+
+private:
+    std::vector<std::pair<std::string, glslang::TSymbol*>> symbols_;
+    // the symbols of the context-specific level live in the pool of the shader that collected them
+    std::shared_ptr<glslang::TShader> owner_;
+};
+#endif
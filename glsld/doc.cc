@@ -4,10 +4,14 @@
 #include "glslang/Include/intermediate.h"
 #include "glslang/MachineIndependent/SymbolTable.h"
 #include "glsld/parser.hpp"
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <tuple>
 #include <utility>
@@ -176,6 +180,47 @@ void Doc::set_text(std::string const& text)
     resource_->text_ = text;
 }
 
+// Byte offset of an LSP position, whose character counts UTF-16 code units.
+static size_t position_offset(std::string const& text, int line, int character)
+{
+    size_t pos = 0;
+    for (; line > 0 && pos < text.size(); --line) {
+        pos = text.find('\n', pos);
+        if (pos == std::string::npos)
+            return text.size();
+        ++pos;
+    }
+
+    while (character > 0 && pos < text.size() && text[pos] != '\n') {
+        unsigned char c = text[pos];
+        int bytes = c < 0x80 ? 1 : c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4;
+        character -= bytes == 4 ? 2 : 1;
+        pos = std::min(text.size(), pos + bytes);
+    }
+    return pos;
+}
+
+void Doc::update(const int version, std::vector<TextChange> const& changes)
+{
+    if (!resource_ || resource_->version >= version)
+        return;
+    resource_->version = version;
+
+    std::string text = resource_->text_;
+    for (auto const& change : changes) {
+        if (change.full) {
+            text = change.text;
+            continue;
+        }
+        size_t start = position_offset(text, change.start_line, change.start_character);
+        size_t end = position_offset(text, change.end_line, change.end_character);
+        if (end < start)
+            std::swap(start, end);
+        text.replace(start, end - start, change.text);
+    }
+    set_text(text);
+}
+
 Doc::Doc(const Doc& rhs)
 {
     release_();
@@ -346,18 +391,61 @@ public:
     }
 };
 
+// Field of the struct selected by an EOpIndexDirectStruct node.
+static glslang::TTypeLoc const& struct_field(glslang::TIntermBinary* binary)
+{
+    auto const& left_type = binary->getLeft()->getType();
+    const auto* members = left_type.isReference() ? left_type.getReferentType()->getStruct() : left_type.getStruct();
+    const auto index = binary->getRight()->getAsConstantUnion()->getConstArray()[0].getIConst();
+    return (*members)[index];
+}
+
+// Computes the columns node may cover in lookup_nodes_at; false for nodes it never reports.
+static bool node_span(TIntermNode* node, Doc::NodeSpan& span)
+{
+    auto const& loc = node->getLoc();
+    span = {loc.line, loc.column, loc.column, node};
+    if (auto* sym = node->getAsSymbolNode()) {
+        span.last = loc.column + (int)sym->getName().length();
+        return true;
+    }
+
+    if (auto* binary = node->getAsBinaryNode()) {
+        if (binary->getOp() != glslang::EOpIndexDirectStruct)
+            return false;
+        const auto rloc = binary->getRight()->getLoc();
+        span.first = rloc.column;
+        span.last = rloc.column + (int)struct_field(binary).type->getFieldName().size();
+        if (auto* left_sym = binary->getLeft()->getAsSymbolNode()) {
+            const auto lloc = left_sym->getLoc();
+            span.first = std::min(span.first, lloc.column);
+            span.last = std::max(span.last, lloc.column + (int)left_sym->getName().size());
+        }
+        return true;
+    }
+
+    if (auto* unary = node->getAsUnaryNode()) {
+        if (unary->getOp() != glslang::EOpDeclare || !unary->getType().isStruct())
+            return false;
+        span.last = loc.column + (int)unary->getType().getTypeName().size();
+        return true;
+    }
+
+    return false;
+}
+
 class DocInfoExtractor : public glslang::TIntermTraverser {
 public:
-    std::map<int, std::vector<TIntermNode*>> nodes_by_line;
+    std::vector<Doc::NodeSpan> node_spans;
     std::vector<glslang::TIntermSymbol*> uses;
     std::vector<glslang::TIntermSymbol*> globals;
     std::vector<Doc::FunctionDefDesc> funcs;
     std::vector<glslang::TIntermSymbol*> userdef_types;
     bool visitBinary(glslang::TVisit, glslang::TIntermBinary* node) override
     {
-        if (node->getOp() == glslang::EOpIndexDirectStruct || node->getOp() == glslang::EOpIndexDirect ||
-            node->getOp() == glslang::EOpIndexIndirect) {
-            nodes_by_line[node->getLoc().line].push_back(node);
+        Doc::NodeSpan span;
+        if (node_span(node, span)) {
+            node_spans.push_back(span);
         }
         return true;
     }
@@ -412,8 +500,13 @@ public:
 
             function_def.end = body->getAsAggregate()->getEndLoc();
             funcs.emplace_back(std::move(function_def));
-            for (auto [line, node] : extractor.nodes_by_line) {
-                nodes_by_line[line] = node;
+            for (auto& [line, nodes] : extractor.nodes_by_line) {
+                for (auto* node : nodes) {
+                    Doc::NodeSpan span;
+                    if (node_span(node, span)) {
+                        node_spans.push_back(span);
+                    }
+                }
             }
             return false;
         }
@@ -448,20 +541,9 @@ public:
     }
 };
 
-bool Doc::parse(std::vector<std::string> const& include_dirs)
+bool Doc::parse_source_(glslang::TShader& shader, glslang::TSymbolTable* builtin_symbol_table,
+                        std::string const& source, std::vector<std::string> const& include_dirs, bool debug_log)
 {
-    if (!resource_)
-        return false;
-
-    auto* resource = new Doc::__Resource;
-    resource->shader = std::make_unique<glslang::TShader>(language());
-    resource->nodes_by_line.clear();
-    resource->globals.clear();
-    resource->func_defs.clear();
-    resource->userdef_types.clear();
-    resource->builtins.clear();
-
-    auto& shader = *resource->shader;
     shader.setDebugInfo(true);
 
     std::string preambles;
@@ -470,9 +552,8 @@ bool Doc::parse(std::vector<std::string> const& include_dirs)
     const std::string pound_extension = "#extension GL_GOOGLE_include_directive : enable\n";
     preambles += pound_extension;
 
-    auto& shader_strings = resource_->text_;
-    const char* shader_source = shader_strings.data();
-    const int shader_lengths = (int)shader_strings.size();
+    const char* shader_source = source.data();
+    const int shader_lengths = (int)source.size();
     const char* string_names = resource_->uri.data();
     shader.setStringsWithLengthsAndNames(&shader_source, &shader_lengths, &string_names, 1);
     shader.setPreamble(preambles.c_str());
@@ -504,25 +585,116 @@ bool Doc::parse(std::vector<std::string> const& include_dirs)
     shader.setInvertY(false);
     shader.setNanMinMaxClamp(false);
 
-    BuiltinSymbolTable builtin_symbol_table;
-    shader.setBuiltinSymbolTable(&builtin_symbol_table);
+    shader.setBuiltinSymbolTable(builtin_symbol_table);
 
     DirStackFileIncluder includer;
     for (auto& d : include_dirs) {
         includer.pushExternalLocalDirectory(d);
     }
 
-    const EShMessages rules = static_cast<EShMessages>(EShMsgCascadingErrors | EShMsgSpvRules | EShMsgVulkanRules | EShMsgBuiltinSymbolTable);
+    EShMessages rules = static_cast<EShMessages>(EShMsgCascadingErrors | EShMsgSpvRules | EShMsgVulkanRules);
+    if (debug_log)
+        rules = static_cast<EShMessages>(rules | EShMsgBuiltinSymbolTable);
 
     auto default_version_ = 110;
     auto default_profile_ = ENoProfile;
     auto force_version_profile_ = false;
 
+    return shader.parse(&kDefaultTBuiltInResource, default_version_, default_profile_, force_version_profile_, false,
+                        rules, includer);
+}
+
+// Builtins do not depend on the document beyond its version, profile and stage, so they are collected
+// once per key by parsing an empty shader and shared by every document with that key.
+std::shared_ptr<const BuiltinIndex> Doc::acquire_builtins_(glslang::TIntermediate const& intermediate)
+{
+    const int version = intermediate.getVersion();
+    const EProfile profile = intermediate.getProfile();
+    auto build = [&](std::vector<glslang::TSymbol*>& symbols, std::shared_ptr<glslang::TShader>& owner) {
+        std::string source = "#version " + std::to_string(version);
+        if (profile == EEsProfile && version > 100)
+            source += " es";
+        else if (profile == ECoreProfile && version >= 150)
+            source += " core";
+        else if (profile == ECompatibilityProfile)
+            source += " compatibility";
+        source += "\nvoid main() {}\n";
+
+        owner = std::make_shared<glslang::TShader>(language());
+        glslang::TCompileArena::Scope arena_scope(owner->getArena());
+        BuiltinSymbolTable builtin_symbol_table;
+        // the builtin levels are adopted before the source is parsed, so errors do not matter here
+        parse_source_(*owner, &builtin_symbol_table, source, {}, false);
+        builtin_symbol_table.get_all_symbols(symbols);
+    };
+
+    return BuiltinIndex::acquire(std::make_tuple(version, profile, language()), build);
+}
+
+template <typename Lock> static Lock lock_if(std::shared_mutex* mutex)
+{
+    return mutex ? Lock(*mutex) : Lock();
+}
+
+// Builds the lookup tables of resource from its node spans, function defs and globals.
+void Doc::index_(Doc::__Resource& resource)
+{
+    std::stable_sort(resource.node_spans.begin(), resource.node_spans.end(), [](auto const& a, auto const& b) {
+        return a.line < b.line || (a.line == b.line && a.first < b.first);
+    });
+
+    resource.funcs_by_line.clear();
+    for (size_t i = 0; i < resource.func_defs.size(); ++i) {
+        auto& func = resource.func_defs[i];
+        if (func.defs_by_id.empty()) {
+            for (auto* def : func.local_defs) {
+                func.defs_by_name.emplace(def->getName().c_str(), def);
+                func.defs_by_id.emplace(def->getId(), def);
+            }
+            for (auto* arg : func.args) {
+                func.defs_by_name.emplace(arg->getName().c_str(), arg);
+                func.defs_by_id.emplace(arg->getId(), arg);
+            }
+        }
+        if (func.start.name && *func.start.name == resource.uri.c_str())
+            resource.funcs_by_line.emplace_back(func.start.line, i);
+    }
+    std::stable_sort(resource.funcs_by_line.begin(), resource.funcs_by_line.end(),
+                     [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    resource.globals_by_name.clear();
+    resource.globals_by_id.clear();
+    for (auto* global : resource.globals) {
+        resource.globals_by_name.emplace(global->getName().c_str(), global);
+        resource.globals_by_id.emplace(global->getId(), global);
+    }
+}
+
+bool Doc::parse(std::vector<std::string> const& include_dirs, std::shared_mutex* lock)
+{
+    if (!resource_)
+        return false;
+
+    std::string text;
+    {
+        auto guard = lock_if<std::shared_lock<std::shared_mutex>>(lock);
+        text = resource_->text_;
+    }
+
     bool success = false;
+    if (reparse_function_(include_dirs, text, lock, success))
+        return success;
 
-    success = shader.parse(&kDefaultTBuiltInResource, default_version_, default_profile_, force_version_profile_, false,
-                           rules, includer);
+    auto* resource = new Doc::__Resource;
+    resource->shader = std::make_shared<glslang::TShader>(language());
+    resource->globals.clear();
+    resource->func_defs.clear();
+    resource->userdef_types.clear();
+
+    auto& shader = *resource->shader;
+    success = parse_source_(shader, nullptr, text, include_dirs, true);
     if (!success) {
+        auto guard = lock_if<std::unique_lock<std::shared_mutex>>(lock);
 		resource_->info_log = shader.getInfoLog();
         delete resource;
         return false;
@@ -530,6 +702,8 @@ bool Doc::parse(std::vector<std::string> const& include_dirs)
 
 	std::cerr << shader.getInfoDebugLog() << std::endl;
 
+    // the extractor allocates its traversal state from the current pool
+    glslang::TCompileArena::Scope arena_scope(shader.getArena());
     auto* interm = shader.getIntermediate();
 
     DocInfoExtractor visitor;
@@ -550,14 +724,20 @@ bool Doc::parse(std::vector<std::string> const& include_dirs)
     }
 
     std::cerr << "DocInfoExtractor found " << visitor.funcs.size() << " function def" << std::endl;
+    for (auto& func : visitor.funcs) {
+        func.owner = resource->shader;
+    }
     resource->globals.swap(visitor.globals);
     resource->func_defs.swap(visitor.funcs);
-    resource->nodes_by_line.swap(visitor.nodes_by_line);
+    resource->node_spans.swap(visitor.node_spans);
     resource->userdef_types.swap(visitor.userdef_types);
-    builtin_symbol_table.get_all_symbols(resource->builtins);
+    resource->builtins = acquire_builtins_(*interm);
 
+    auto guard = lock_if<std::unique_lock<std::shared_mutex>>(lock);
     resource->uri = resource_->uri;
+    index_(*resource);
     resource->version = resource_->version;
+    resource->parsed_text_ = std::move(text);
     resource->text_ = std::move(resource_->text_);
     resource->lines_ = std::move(resource_->lines_);
     resource->language = resource_->language;
@@ -568,6 +748,243 @@ bool Doc::parse(std::vector<std::string> const& include_dirs)
     return true;
 }
 
+// Byte offset of each line start in text, plus a final entry at text.size().
+static std::vector<size_t> line_offsets(std::string const& text)
+{
+    std::vector<size_t> offsets = {0};
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\n')
+            offsets.push_back(i + 1);
+    }
+    offsets.push_back(text.size());
+    return offsets;
+}
+
+// Byte range of the '{' ... '}' body of func in text, or false if it cannot be found.
+static bool find_body_range(std::string const& text, std::vector<size_t> const& offsets,
+                            Doc::FunctionDefDesc const& func, size_t& open, size_t& close)
+{
+    auto offset_of = [&](glslang::TSourceLoc const& loc, size_t& offset) {
+        if (loc.line < 1 || loc.line >= (int)offsets.size() || loc.column < 1)
+            return false;
+        offset = offsets[loc.line - 1] + loc.column - 1;
+        return offset < offsets[loc.line];
+    };
+
+    size_t pos;
+    if (!offset_of(func.start, pos) || !offset_of(func.end, close) || text[close] != '}')
+        return false;
+
+    while (pos < close) {
+        if (text.compare(pos, 2, "//") == 0) {
+            pos = text.find('\n', pos);
+        } else if (text.compare(pos, 2, "/*") == 0) {
+            pos = text.find("*/", pos + 2);
+            if (pos != std::string::npos)
+                pos += 2;
+        } else if (text[pos] == '{') {
+            open = pos;
+            return true;
+        } else {
+            ++pos;
+        }
+        if (pos == std::string::npos)
+            return false;
+    }
+    return false;
+}
+
+// Moves every location under a reused function definition by a number of lines.
+class LocShifter : public glslang::TIntermTraverser {
+public:
+    explicit LocShifter(int delta) : delta_(delta) {}
+
+    void visitSymbol(glslang::TIntermSymbol* node) override { shift_(node); }
+    void visitConstantUnion(glslang::TIntermConstantUnion* node) override { shift_(node); }
+    bool visitBinary(glslang::TVisit, glslang::TIntermBinary* node) override { return shift_(node); }
+    bool visitUnary(glslang::TVisit, glslang::TIntermUnary* node) override { return shift_(node); }
+    bool visitSelection(glslang::TVisit, glslang::TIntermSelection* node) override { return shift_(node); }
+    bool visitLoop(glslang::TVisit, glslang::TIntermLoop* node) override { return shift_(node); }
+    bool visitBranch(glslang::TVisit, glslang::TIntermBranch* node) override { return shift_(node); }
+    bool visitSwitch(glslang::TVisit, glslang::TIntermSwitch* node) override { return shift_(node); }
+    bool visitAggregate(glslang::TVisit, glslang::TIntermAggregate* node) override
+    {
+        if (!shift_(node))
+            return false;
+        auto end = node->getEndLoc();
+        end.line += delta_;
+        node->setEndLoc(end);
+        return true;
+    }
+
+private:
+    int delta_;
+    std::set<TIntermNode*> visited_;
+
+    bool shift_(TIntermNode* node)
+    {
+        if (!visited_.insert(node).second)
+            return false;
+        auto loc = node->getLoc();
+        loc.line += delta_;
+        node->setLoc(loc);
+        return true;
+    }
+};
+
+// Reparses only the function whose body contains every line changed since the last successful
+// parse. The other function bodies in the document are blanked out, keeping their prototypes and
+// every line and column in place, and their FunctionDefDescs are reused from the previous parse.
+// Returns false, without touching the document, when the edit cannot be handled this way.
+bool Doc::reparse_function_(std::vector<std::string> const& include_dirs, std::string const& text,
+                            std::shared_mutex* lock, bool& success)
+{
+    // reused functions keep the shader that parsed them alive; bound how many are kept
+    const size_t max_retained_shaders = 8;
+
+    if (!resource_ || resource_->ref != 1 || !resource_->shader)
+        return false;
+
+    std::string const& old_text = resource_->parsed_text_;
+    std::string const& new_text = text;
+    if (old_text == new_text) {
+        success = true;
+        return true;
+    }
+
+    auto old_offsets = line_offsets(old_text);
+    auto new_offsets = line_offsets(new_text);
+    const int old_lines = (int)old_offsets.size() - 1;
+    const int new_lines = (int)new_offsets.size() - 1;
+    auto same_line = [&](int old_line, int new_line) {
+        size_t old_len = old_offsets[old_line + 1] - old_offsets[old_line];
+        size_t new_len = new_offsets[new_line + 1] - new_offsets[new_line];
+        return old_len == new_len &&
+               old_text.compare(old_offsets[old_line], old_len, new_text, new_offsets[new_line], new_len) == 0;
+    };
+
+    // the changed lines are [prefix, old_lines - suffix) before and [prefix, new_lines - suffix) after the edit
+    int prefix = 0;
+    while (prefix < old_lines && prefix < new_lines && same_line(prefix, prefix))
+        ++prefix;
+    int suffix = 0;
+    while (suffix < old_lines - prefix && suffix < new_lines - prefix &&
+           same_line(old_lines - 1 - suffix, new_lines - 1 - suffix))
+        ++suffix;
+    const int delta = new_lines - old_lines;
+    const long byte_delta = (long)new_text.size() - (long)old_text.size();
+
+    // a new preprocessor directive could change the meaning of the rest of the document
+    if (new_text.find('#', new_offsets[prefix]) < new_offsets[new_lines - suffix] ||
+        old_text.find('#', old_offsets[prefix]) < old_offsets[old_lines - suffix])
+        return false;
+
+    struct Body {
+        size_t open, close;
+        int open_line, close_line;
+    };
+    std::vector<Body> bodies(resource_->func_defs.size());
+    std::set<glslang::TShader*> owners;
+    int changed = -1;
+    for (size_t i = 0; i < resource_->func_defs.size(); ++i) {
+        auto const& func = resource_->func_defs[i];
+        if (!func.start.name || *func.start.name != resource_->uri.c_str())
+            continue;
+        auto& body = bodies[i];
+        if (!find_body_range(old_text, old_offsets, func, body.open, body.close))
+            return false;
+        body.open_line = (int)(std::upper_bound(old_offsets.begin(), old_offsets.end(), body.open) - old_offsets.begin()) - 1;
+        body.close_line = func.end.line - 1;
+
+        if (body.open_line < prefix && old_lines - suffix <= body.close_line) {
+            changed = (int)i;
+        } else if (body.close_line >= prefix && body.open_line < old_lines - suffix) {
+            return false;
+        } else {
+            owners.insert(func.owner.get());
+        }
+    }
+    if (changed < 0 || owners.size() >= max_retained_shaders)
+        return false;
+
+    std::string source = new_text;
+    for (size_t i = 0; i < resource_->func_defs.size(); ++i) {
+        auto const& body = bodies[i];
+        if ((int)i == changed || body.close == 0)
+            continue;
+        size_t open = body.open, close = body.close;
+        if (body.open_line >= old_lines - suffix) {
+            open += byte_delta;
+            close += byte_delta;
+        }
+        if (source.find('#', open) < close)
+            continue;
+        source[open] = ';';
+        for (size_t pos = open + 1; pos <= close; ++pos) {
+            if (source[pos] != '\n')
+                source[pos] = ' ';
+        }
+    }
+
+    auto shader = std::make_shared<glslang::TShader>(language());
+    success = parse_source_(*shader, nullptr, source, include_dirs, false);
+    if (!success) {
+        auto guard = lock_if<std::unique_lock<std::shared_mutex>>(lock);
+        resource_->info_log = shader->getInfoLog();
+        return true;
+    }
+
+    glslang::TCompileArena::Scope arena_scope(shader->getArena());
+    DocInfoExtractor visitor;
+    shader->getIntermediate()->getTreeRoot()->traverse(&visitor);
+    for (auto& func : visitor.funcs) {
+        func.owner = shader;
+    }
+
+    auto guard = lock_if<std::unique_lock<std::shared_mutex>>(lock);
+    auto& old_funcs = resource_->func_defs;
+    std::vector<std::pair<int, int>> reused_lines;
+    for (size_t i = 0; i < old_funcs.size(); ++i) {
+        if ((int)i == changed || bodies[i].close == 0)
+            continue;
+        auto func = old_funcs[i];
+        reused_lines.emplace_back(func.start.line, func.end.line);
+        if (bodies[i].open_line >= old_lines - suffix && delta != 0) {
+            LocShifter shifter(delta);
+            func.def->traverse(&shifter);
+            func.start.line += delta;
+            func.end.line += delta;
+        }
+        visitor.funcs.push_back(std::move(func));
+    }
+    std::stable_sort(visitor.funcs.begin(), visitor.funcs.end(),
+                     [](auto const& a, auto const& b) { return a.start.line < b.start.line; });
+
+    for (auto span : resource_->node_spans) {
+        for (auto [first, last] : reused_lines) {
+            if (first <= span.line && span.line <= last) {
+                if (span.line > prefix)
+                    span.line += delta;
+                visitor.node_spans.push_back(span);
+                break;
+            }
+        }
+    }
+
+    resource_->shader = shader;
+    resource_->globals.swap(visitor.globals);
+    resource_->func_defs.swap(visitor.funcs);
+    resource_->node_spans.swap(visitor.node_spans);
+    resource_->userdef_types.swap(visitor.userdef_types);
+    index_(*resource_);
+    resource_->parsed_text_ = text;
+    resource_->info_log.clear();
+
+    std::cerr << "reparsed function " << resource_->func_defs.size() << " function defs, " << delta
+              << " lines moved" << std::endl;
+    return true;
+}
+
 void Doc::tokenize_()
 {
     // tokenize
@@ -610,11 +1027,7 @@ static Doc::LookupResult lookup_binop(glslang::TIntermBinary* binary, const int
     auto* right = binary->getRight();
     const auto rloc = right->getLoc();
     const auto lloc = left->getLoc();
-
-    bool isref = left->getType().isReference();
-    const auto* members = isref ? left->getType().getReferentType()->getStruct() : left->getType().getStruct();
-    const auto index = right->getAsConstantUnion()->getConstArray()[0].getIConst();
-    const auto field = (*members)[index];
+    const auto field = struct_field(binary);
 
     if (rloc.column <= col && col <= rloc.column + field.type->getFieldName().size()) {
         return {Doc::LookupResult::Kind::FIELD, .field = field};
@@ -634,12 +1047,15 @@ std::vector<Doc::LookupResult> Doc::lookup_nodes_at(const int line, const int co
     if (!resource_)
         return {};
     std::vector<LookupResult> result;
-    if (resource_->nodes_by_line.count(line) <= 0) {
-        return result;
-    }
+    auto const& spans = resource_->node_spans;
+    auto pos = std::lower_bound(spans.begin(), spans.end(), line,
+                                [](NodeSpan const& span, int line) { return span.line < line; });
+    for (; pos != spans.end() && pos->line == line && pos->first <= col; ++pos) {
+        if (col > pos->last) {
+            continue;
+        }
 
-    auto& nodes = resource_->nodes_by_line[line];
-    for (auto* node : nodes) {
+        auto* node = pos->node;
         if (auto sym = node->getAsSymbolNode()) {
             auto loc = sym->getLoc();
             auto endcol = loc.column + sym->getName().length();
@@ -677,17 +1093,22 @@ std::vector<Doc::LookupResult> Doc::lookup_nodes_at(const int line, const int co
 glslang::TSourceLoc Doc::locate_symbol_def(Doc::FunctionDefDesc* func, glslang::TIntermSymbol* target)
 {
     if (func) {
-        for (auto sym : func->local_defs) {
-            if (sym->getId() == target->getId()) {
-                return sym->getLoc();
-            }
+        auto def = func->defs_by_id.find(target->getId());
+        if (def != func->defs_by_id.end()) {
+            return def->second->getLoc();
         }
     }
 
-    for (auto global : resource_->globals) {
-        if (target->getId() == global->getId()) {
-            return global->getLoc();
-        }
+    auto global = resource_->globals_by_id.find(target->getId());
+    if (global != resource_->globals_by_id.end()) {
+        return global->second->getLoc();
+    }
+
+    // a function reused by an incremental reparse refers to the globals of an older parse,
+    // whose ids differ from the current ones
+    auto named = resource_->globals_by_name.find(target->getName().c_str());
+    if (named != resource_->globals_by_name.end()) {
+        return named->second->getLoc();
     }
 
     return {.name = nullptr, .line = 0, .column = 0};
@@ -738,58 +1159,34 @@ std::vector<glslang::TIntermSymbol*> Doc::lookup_symbols_by_prefix(Doc::Function
 
 std::vector<glslang::TSymbol*> Doc::lookup_builtin_symbols_by_prefix(std::string const& prefix, bool fullname)
 {
-    if (!resource_)
+    if (!resource_ || !resource_->builtins)
         return {};
-    auto match_fn = [&prefix, fullname](std::string const& name) {
-        if (prefix.empty())
-            return true;
-
-        return fullname ? prefix == name : prefix == name.substr(0, prefix.size());
-    };
-
-    std::vector<glslang::TSymbol*> results;
-    for (auto* sym : resource_->builtins) {
-        if (match_fn(sym->getName().c_str())) {
-            results.push_back(sym);
-        }
-    }
 
-    return results;
+    return resource_->builtins->lookup_by_prefix(prefix, fullname);
 }
 
 glslang::TIntermSymbol* Doc::lookup_symbol_by_name(Doc::FunctionDefDesc* func, std::string const& name)
 {
     if (func) {
-        for (auto* def : func->local_defs) {
-            if (name == def->getName().c_str()) {
-                return def;
-            }
-        }
-
-        for (auto* def : func->args) {
-            if (name == def->getName().c_str()) {
-                return def;
-            }
-        }
-    }
-
-    for (auto& sym : resource_->globals) {
-        if (name == sym->getName().c_str()) {
-            return sym;
+        auto def = func->defs_by_name.find(name);
+        if (def != func->defs_by_name.end()) {
+            return def->second;
         }
     }
 
-    return nullptr;
+    auto global = resource_->globals_by_name.find(name);
+    return global != resource_->globals_by_name.end() ? global->second : nullptr;
 }
 
 Doc::FunctionDefDesc* Doc::lookup_func_by_line(int line)
 {
     if (!resource_)
         return nullptr;
-    for (auto& func : resource_->func_defs) {
-        if (func.start.line <= line && func.end.line >= line) {
-            return &func;
-        }
-    }
-    return nullptr;
+    auto const& funcs = resource_->funcs_by_line;
+    auto pos = std::upper_bound(funcs.begin(), funcs.end(), line,
+                                [](int line, std::pair<int, size_t> const& func) { return line < func.first; });
+    if (pos == funcs.begin())
+        return nullptr;
+    auto& func = resource_->func_defs[std::prev(pos)->second];
+    return func.end.line >= line ? &func : nullptr;
 }
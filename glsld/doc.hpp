@@ -2,11 +2,14 @@
 #define __GLSLD_DOC_HPP__
 #include "../glslang/MachineIndependent/localintermediate.h"
 #include "../glslang/Public/ShaderLang.h"
+#include "builtin_index.hpp"
 #include "parser.hpp"
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 class Doc {
@@ -17,6 +20,26 @@ public:
         std::vector<glslang::TIntermSymbol*> local_defs;
         std::vector<glslang::TIntermSymbol*> local_uses;
         glslang::TSourceLoc start, end;
+        // keeps the AST of def alive when the function is reused by an incremental reparse
+        std::shared_ptr<glslang::TShader> owner;
+        // local definitions and arguments; by name the first local definition wins over arguments
+        std::unordered_map<std::string, glslang::TIntermSymbol*> defs_by_name;
+        std::unordered_map<long long, glslang::TIntermSymbol*> defs_by_id;
+    };
+
+    // a node lookup_nodes_at can report, with the columns it may cover on its line
+    struct NodeSpan {
+        int line;
+        int first, last;
+        TIntermNode* node;
+    };
+
+    // one LSP TextDocumentContentChangeEvent; positions are 0-based, characters in UTF-16 code units
+    struct TextChange {
+        bool full;
+        int start_line, start_character;
+        int end_line, end_character;
+        std::string text;
     };
 
     Doc();
@@ -27,7 +50,9 @@ public:
     Doc& operator=(Doc&& doc);
     virtual ~Doc();
 
-    bool parse(std::vector<std::string> const& include_dirs);
+    // lock, if given, is held shared by readers of this document; parse only takes it exclusively
+    // to publish its result, so readers keep seeing the last good parse while it runs
+    bool parse(std::vector<std::string> const& include_dirs, std::shared_mutex* lock = nullptr);
     void update(const int version, std::string const& text)
     {
         if (resource_->version >= version)
@@ -36,6 +61,7 @@ public:
         set_text(text);
         // tokenize_();
     }
+    void update(const int version, std::vector<TextChange> const& changes);
 
     int version() const { return resource_->version; }
     std::vector<std::string> const& lines() const { return resource_->lines_; }
@@ -92,19 +118,32 @@ private:
         std::vector<std::string> lines_;
         EShLanguage language;
 
-        std::unique_ptr<glslang::TShader> shader;
+        std::shared_ptr<glslang::TShader> shader;
+        // text of the last successful parse, the base of the next incremental reparse
+        std::string parsed_text_;
 
-        std::map<int, std::vector<TIntermNode*>> nodes_by_line;
+        // sorted by line, then by first column
+        std::vector<NodeSpan> node_spans;
         std::vector<FunctionDefDesc> func_defs;
+        // start line and index in func_defs of the functions defined in this document, sorted by line
+        std::vector<std::pair<int, size_t>> funcs_by_line;
         std::vector<glslang::TIntermSymbol*> globals;
+        std::unordered_map<std::string, glslang::TIntermSymbol*> globals_by_name;
+        std::unordered_map<long long, glslang::TIntermSymbol*> globals_by_id;
         std::vector<glslang::TIntermSymbol*> userdef_types;
         std::map<int, std::vector<Token>> tokens_by_line;
-        std::vector<glslang::TSymbol*> builtins;
+        std::shared_ptr<const BuiltinIndex> builtins;
         std::string info_log;
         int ref = 1;
     };
 
     __Resource* resource_;
+    bool parse_source_(glslang::TShader& shader, glslang::TSymbolTable* builtin_symbol_table, std::string const& source,
+                       std::vector<std::string> const& include_dirs, bool debug_log);
+    std::shared_ptr<const BuiltinIndex> acquire_builtins_(glslang::TIntermediate const& intermediate);
+    bool reparse_function_(std::vector<std::string> const& include_dirs, std::string const& text,
+                           std::shared_mutex* lock, bool& success);
+    static void index_(__Resource& resource);
     void infer_language_();
     void tokenize_();
     void release_();
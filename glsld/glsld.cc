@@ -48,9 +48,8 @@ int read_message(std::string& body)
     return 0;
 }
 
-static void handle_message(std::string const& body)
+static void handle_message(Protocol& protocol, std::string const& body)
 {
-	static Protocol protocol;
 	// std::cerr << "start handle message: " << std::endl << body << std::endl;
 	auto json = nlohmann::json::parse(body);
 	protocol.handle(json);
@@ -58,9 +57,11 @@ static void handle_message(std::string const& body)
 
 int main(int argc, char* argv[])
 {
+    // parses and queries run on the protocol's workers; this thread only reads and dispatches
+    Protocol protocol;
     std::string body;
     while (read_message(body) == 0) {
-		handle_message(body);
+		handle_message(protocol, body);
 		body.clear();
     };
 
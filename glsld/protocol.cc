@@ -1,13 +1,20 @@
 #include "protocol.hpp"
 #include "completion.hpp"
+#include "glslang/Include/PoolAlloc.h"
 #include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <iterator>
 #include <regex>
+#include <shared_mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
+// Parses run on up to four threads. Queries get a thread of their own, so they are never queued
+// behind a parse and are answered in the order they arrived.
+Protocol::Protocol() : parsers_(std::min(4u, std::thread::hardware_concurrency())), queries_(1) {}
+
 int Protocol::handle(nlohmann::json& req)
 {
     nlohmann::json resp;
@@ -28,11 +35,13 @@ int Protocol::handle(nlohmann::json& req)
     } else if (method == "textDocument/didOpen") {
         did_open_(req);
     } else if (method == "textDocument/definition") {
-        definition_(req);
+        submit_query_(req, &Protocol::definition_);
     } else if (method == "textDocument/didChange") {
         did_change_(req);
     } else if (method == "textDocument/completion") {
-        completion_(req);
+        submit_query_(req, &Protocol::completion_);
+    } else if (method == "$/cancelRequest") {
+        cancel_request_(req);
     } else if (method == "textDocument/didSave") {
         did_save_(req);
     }
@@ -62,6 +71,101 @@ void Protocol::make_response_(nlohmann::json& req, nlohmann::json* result)
     send_to_client_(body);
 }
 
+void Protocol::make_error_response_(nlohmann::json& req, ErrorCode code, std::string const& message)
+{
+    nlohmann::json body = {
+        {"jsonrpc", "2.0"},
+        {"id", req["id"]},
+        {"error", {{"code", int(code)}, {"message", message}}},
+    };
+
+    send_to_client_(body);
+}
+
+void Protocol::submit_query_(nlohmann::json& req, void (Protocol::*handler)(nlohmann::json&))
+{
+    std::string id = req["id"].dump();
+    {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        pending_requests_.insert(id);
+    }
+
+    queries_.submit([this, req, handler, id]() mutable {
+        bool cancelled;
+        {
+            std::lock_guard<std::mutex> guard(tasks_mutex_);
+            cancelled = cancelled_requests_.erase(id) > 0;
+        }
+
+        if (cancelled) {
+            make_error_response_(req, ErrorCode::RequestCancelled, "request cancelled");
+        } else {
+            // queries tokenize with the thread's default pool; give back what they allocated
+            auto& pool = glslang::GetThreadPoolAllocator();
+            pool.push();
+            {
+                std::shared_lock<std::shared_mutex> guard(workspace_.mutex());
+                (this->*handler)(req);
+            }
+            pool.pop();
+        }
+
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        pending_requests_.erase(id);
+        cancelled_requests_.erase(id);
+    });
+}
+
+void Protocol::cancel_request_(nlohmann::json& req)
+{
+    // a request already running is answered normally
+    std::string id = req["params"]["id"].dump();
+    std::lock_guard<std::mutex> guard(tasks_mutex_);
+    if (pending_requests_.count(id) > 0) {
+        cancelled_requests_.insert(id);
+    }
+}
+
+void Protocol::schedule_parse_(std::string const& uri)
+{
+    {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        if (parse_running_.count(uri) > 0) {
+            parse_dirty_.insert(uri);
+            return;
+        }
+        // a queued parse reads the text when it starts, so it covers this change too
+        if (!parse_queued_.insert(uri).second)
+            return;
+    }
+
+    parsers_.submit([this, uri] { parse_(uri); });
+}
+
+void Protocol::parse_(std::string const& uri)
+{
+    {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        parse_queued_.erase(uri);
+        parse_running_.insert(uri);
+    }
+
+    auto [ret, info_log] = workspace_.parse_doc(uri);
+    if (ret)
+        publish_clear_diagnostics(uri);
+    else
+        publish_diagnostics(info_log);
+
+    bool dirty;
+    {
+        std::lock_guard<std::mutex> guard(tasks_mutex_);
+        parse_running_.erase(uri);
+        dirty = parse_dirty_.erase(uri) > 0;
+    }
+    if (dirty)
+        schedule_parse_(uri);
+}
+
 void Protocol::initialize_(nlohmann::json& req)
 {
     auto result = nlohmann::json::parse(R"(
@@ -69,7 +173,7 @@ void Protocol::initialize_(nlohmann::json& req)
 		"capabilities": {
 			"textDocumentSync": {
 				"openClose": true,
-				"change": 1,
+				"change": 2,
 				"save": true,
 				"willSave": false 
 			},
@@ -135,28 +239,18 @@ void Protocol::did_open_(nlohmann::json& req)
     std::string uri = textDoc["uri"];
     int version = textDoc["version"];
     std::string source = textDoc["text"];
-    Doc doc(uri, version, source);
-    if (!doc.parse({workspace_.get_root()})) {
-        publish_diagnostics(doc.info_log());
-    } else {
-        publish_clear_diagnostics(uri);
+    {
+        std::unique_lock<std::shared_mutex> guard(workspace_.mutex());
+        workspace_.open_doc(uri, version, source);
     }
-    workspace_.add_doc(std::move(doc));
+    schedule_parse_(uri);
 }
 
 void Protocol::did_save_(nlohmann::json& req)
 {
     auto& params = req["params"];
     std::string uri = params["textDocument"]["uri"];
-    int version = params["textDocument"]["version"];
-
-    auto [ret, doc] = workspace_.save_doc(uri, version);
-    if (doc) {
-        if (ret)
-            publish_clear_diagnostics(uri);
-        else
-            publish_diagnostics(doc->info_log());
-    }
+    schedule_parse_(uri);
 }
 
 void Protocol::completion_(nlohmann::json& req)
@@ -265,8 +359,26 @@ void Protocol::did_change_(nlohmann::json& req)
     auto& textDoc = params["textDocument"];
     std::string uri = textDoc["uri"];
     int version = textDoc["version"];
-    std::string source = params["contentChanges"][0]["text"];
-    workspace_.update_doc(uri, version, source);
+
+    std::vector<Doc::TextChange> changes;
+    for (auto& content_change : params["contentChanges"]) {
+        Doc::TextChange change = {.full = true};
+        change.text = content_change["text"];
+        if (content_change.contains("range")) {
+            auto& range = content_change["range"];
+            change.full = false;
+            change.start_line = range["start"]["line"];
+            change.start_character = range["start"]["character"];
+            change.end_line = range["end"]["line"];
+            change.end_character = range["end"]["character"];
+        }
+        changes.emplace_back(std::move(change));
+    }
+    {
+        std::unique_lock<std::shared_mutex> guard(workspace_.mutex());
+        workspace_.update_doc(uri, version, changes);
+    }
+    schedule_parse_(uri);
 }
 
 void Protocol::publish_(std::string const& method, nlohmann::json* params)
@@ -332,6 +444,7 @@ void Protocol::send_to_client_(nlohmann::json& content)
     header.append("Content-Type: application/vscode-jsonrpc;charset=utf-8\r\n");
     header.append("\r\n");
     header.append(body_str);
+    std::lock_guard<std::mutex> guard(output_mutex_);
     std::cerr << "resp to client: \n" << header << std::endl;
     std::cout << header;
     std::flush(std::cout);
@@ -1,7 +1,11 @@
 #ifndef __GLSLD_PROTOCOL_HPP__
 #define __GLSLD_PROTOCOL_HPP__
 #include "nlohmann/json.hpp"
+#include "worker_pool.hpp"
 #include "workspace.hpp"
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 
 class Protocol {
@@ -129,12 +133,28 @@ class Protocol {
     Workspace workspace_;
     bool init_ = false;
 
+    std::mutex output_mutex_;
+    // parses are coalesced per uri: at most one runs, and changes made while it runs cause one more
+    std::mutex tasks_mutex_;
+    std::set<std::string> parse_queued_, parse_running_, parse_dirty_;
+    // ids, as dumped json, of requests not answered yet and of those the client cancelled
+    std::set<std::string> pending_requests_, cancelled_requests_;
+
+    // declared last so the queued tasks run before the state above goes away
+    WorkerPool parsers_;
+    WorkerPool queries_;
+
     void make_response_(nlohmann::json& req, nlohmann::json* result);
+    void make_error_response_(nlohmann::json& req, ErrorCode code, std::string const& message);
     void initialize_(nlohmann::json& body);
     void did_open_(nlohmann::json& req);
     void definition_(nlohmann::json& req);
     void did_change_(nlohmann::json& req);
     void did_save_(nlohmann::json& req);
+    void cancel_request_(nlohmann::json& req);
+    void submit_query_(nlohmann::json& req, void (Protocol::*handler)(nlohmann::json&));
+    void schedule_parse_(std::string const& uri);
+    void parse_(std::string const& uri);
     void completion_(nlohmann::json& req);
     nlohmann::json complete_variable_(std::string const& uri, std::string const& input);
     nlohmann::json complete_field_(std::string const& uri, std::string const& input);
@@ -145,6 +165,7 @@ class Protocol {
     void publish_clear_diagnostics(const std::string& uri);
 
 public:
+    Protocol();
     int handle(nlohmann::json& req);
 };
 #endif
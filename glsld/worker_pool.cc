@@ -0,0 +1,47 @@
+#include "worker_pool.hpp"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned threads)
+{
+    threads = std::max(1u, threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        threads_.emplace_back(&WorkerPool::run_, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        tasks_.emplace_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+void WorkerPool::run_()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(mutex_);
+            ready_.wait(guard, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef __GLSLD_WORKER_POOL_HPP__
+#define __GLSLD_WORKER_POOL_HPP__
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs submitted tasks in order of submission on a fixed set of threads.
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads);
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    // runs the tasks still queued, then joins the threads
+    ~WorkerPool();
+
+    void submit(std::function<void()> task);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+
+    void run_();
+};
+#endif
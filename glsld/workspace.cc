@@ -17,18 +17,42 @@ void Workspace::update_doc(std::string const& uri, const int version, std::strin
     }
 }
 
-std::tuple<bool, Doc*> Workspace::save_doc(std::string const& uri, const int version)
+void Workspace::update_doc(std::string const& uri, const int version, std::vector<Doc::TextChange> const& changes)
 {
     if (docs_.count(uri) > 0) {
+        docs_[uri].update(version, changes);
+    } else {
+        Doc doc(uri, version - 1, "");
+        doc.update(version, changes);
+        add_doc(std::move(doc));
+    }
+}
+
+void Workspace::open_doc(std::string const& uri, const int version, std::string const& text)
+{
+    if (docs_.count(uri) > 0) {
+        // a parse of the document may be in flight, keep its resource
         auto& doc = docs_[uri];
-        if (doc.version() == version) {
-            bool ret = doc.parse({get_root()});
-            return std::make_tuple(ret, &doc);
-        }
-        return std::make_tuple(true, &doc);
+        doc.set_version(version);
+        doc.set_text(text);
+    } else {
+        add_doc(Doc(uri, version, text));
+    }
+}
+
+std::tuple<bool, std::string> Workspace::parse_doc(std::string const& uri)
+{
+    Doc* doc;
+    {
+        std::shared_lock<std::shared_mutex> guard(mutex_);
+        doc = get_doc(uri);
+        if (!doc)
+            return std::make_tuple(true, std::string());
     }
 
-    return std::make_tuple(true, nullptr);
+    bool ret = doc->parse({get_root()}, &mutex_);
+    std::shared_lock<std::shared_mutex> guard(mutex_);
+    return std::make_tuple(ret, std::string(ret ? "" : doc->info_log()));
 }
 
 void Workspace::add_doc(Doc&& doc) { docs_[doc.uri()] = std::move(doc); }
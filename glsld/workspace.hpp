@@ -2,10 +2,17 @@
 #define __GLSLD_WORKSPACE_HPP__
 #include "doc.hpp"
 #include <map>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
 #include <vector>
+
+// Documents are read under mutex() held shared and changed under it held exclusively;
+// parse_doc takes it itself.
 class Workspace {
     std::string root_;
     std::map<std::string, Doc> docs_;
+    std::shared_mutex mutex_;
 
 public:
     Workspace();
@@ -15,8 +22,11 @@ public:
     Workspace& operator=(Workspace&&) = delete;
 
     void update_doc(std::string const& uri, const int version, std::string const& text);
+    void update_doc(std::string const& uri, const int version, std::vector<Doc::TextChange> const& changes);
     void add_doc(Doc&& doc);
-    std::tuple<bool, Doc*> save_doc(std::string const& uri, const int version);
+    void open_doc(std::string const& uri, const int version, std::string const& text);
+    std::tuple<bool, std::string> parse_doc(std::string const& uri);
+    std::shared_mutex& mutex() { return mutex_; }
     Doc* get_doc(std::string const& uri);
     std::string const& get_root() const;
     void set_root(std::string const& root);
@@ -0,0 +1,231 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "glslang/Include/PoolAlloc.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+const char* const Source =
+    "#version 450\n"
+    "layout(local_size_x = 8) in;\n"
+    "struct S { vec4 a; float b[3]; };\n"
+    "layout(std430, binding = 0) buffer Data { S s[]; } data;\n"
+    "vec4 f(S s) { return s.a * s.b[1]; }\n"
+    "void main() { data.s[gl_LocalInvocationID.x].a = f(data.s[0]); }\n";
+
+const EShMessages Messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+
+bool parse(glslang::TShader& shader)
+{
+    shader.setStrings(&Source, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    return shader.parse(GetDefaultResources(), 100, false, Messages);
+}
+
+std::vector<unsigned int> generate(glslang::TProgram& program)
+{
+    std::vector<unsigned int> spirv;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangCompute), spirv);
+    return spirv;
+}
+
+std::vector<unsigned int> compile(glslang::TCompileArena& arena)
+{
+    glslang::TShader shader(EShLangCompute, arena);
+    EXPECT_TRUE(parse(shader)) << shader.getInfoLog();
+    glslang::TProgram program(arena);
+    program.addShader(&shader);
+    EXPECT_TRUE(program.link(Messages)) << program.getInfoLog();
+    return generate(program);
+}
+
+TEST(CompileArena, EntryPointsRestoreTheThreadPool)
+{
+    glslang::TPoolAllocator pool;
+    glslang::TPoolAllocatorScope poolScope(pool);
+
+    glslang::TShader shader(EShLangCompute);
+    ASSERT_TRUE(parse(shader)) << shader.getInfoLog();
+    EXPECT_EQ(&pool, &glslang::GetThreadPoolAllocator());
+
+    glslang::TProgram program;
+    program.addShader(&shader);
+    ASSERT_TRUE(program.link(Messages)) << program.getInfoLog();
+    EXPECT_EQ(&pool, &glslang::GetThreadPoolAllocator());
+    ASSERT_TRUE(program.buildReflection());
+    EXPECT_EQ(&pool, &glslang::GetThreadPoolAllocator());
+
+    EXPECT_EQ(0u, pool.getBytesReserved());
+}
+
+TEST(CompileArena, CompileMovesBetweenThreads)
+{
+    glslang::TCompileArena reference;
+    const std::vector<unsigned int> expected = compile(reference);
+    ASSERT_FALSE(expected.empty());
+
+    glslang::TCompileArena arena;
+    glslang::TShader shader(EShLangCompute, arena);
+    glslang::TProgram program(arena);
+    std::vector<unsigned int> spirv;
+
+    std::thread([&] { EXPECT_TRUE(parse(shader)) << shader.getInfoLog(); }).join();
+    std::thread([&] {
+        program.addShader(&shader);
+        EXPECT_TRUE(program.link(Messages)) << program.getInfoLog();
+    }).join();
+    std::thread([&] { spirv = generate(program); }).join();
+
+    EXPECT_EQ(expected, spirv);
+}
+
+TEST(CompileArena, ResetKeepsPagesForTheNextCompile)
+{
+    glslang::TCompileArena arena;
+    const std::vector<unsigned int> first = compile(arena);
+    ASSERT_FALSE(first.empty());
+    const size_t reserved = arena.getBytesReserved();
+    EXPECT_GT(reserved, 0u);
+
+    // Single pages stay with the arena for reuse; only oversized blocks go back.
+    arena.reset();
+    EXPECT_GT(arena.getBytesReserved(), 0u);
+    EXPECT_LE(arena.getBytesReserved(), reserved);
+
+    for (int compiles = 0; compiles < 4; ++compiles) {
+        EXPECT_EQ(first, compile(arena));
+        EXPECT_EQ(reserved, arena.getBytesReserved());
+        arena.reset();
+    }
+}
+
+TEST(CompileArena, PagesGrowUpToTheCap)
+{
+    glslang::TPoolAllocator pool(4096, 16, 32768);
+    for (int i = 0; i < 2000; ++i)
+        pool.allocate(100);
+
+    glslang::TMemoryStats stats;
+    pool.getStats(stats);
+    EXPECT_EQ(2000u, stats.allocations);
+    EXPECT_EQ(200000u, stats.bytesRequested);
+    EXPECT_EQ(0u, stats.largeAllocations);
+    EXPECT_EQ(stats.bytesReserved, stats.highWaterMark);
+
+    // 4, 8, 16 and then 32 KiB pages, where fixed 4 KiB pages would take 50 or more.
+    ASSERT_GT(stats.pagesAllocated, 3u);
+    EXPECT_EQ(4096u + 8192 + 16384 + 32768 * (stats.pagesAllocated - 3), stats.bytesReserved);
+    EXPECT_GE(stats.bytesReserved, stats.bytesRequested);
+    EXPECT_LE(stats.pagesAllocated, 16u);
+}
+
+TEST(CompileArena, PoppedPagesAreReused)
+{
+    glslang::TPoolAllocator pool;
+    glslang::TMemoryStats first;
+    pool.push();
+    for (int i = 0; i < 1000; ++i)
+        pool.allocate(64);
+    pool.getStats(first);
+    EXPECT_EQ(2u, first.scopeDepth);
+    EXPECT_EQ(64000u, first.scopeBytesRequested);
+    pool.pop();
+
+    pool.push();
+    for (int i = 0; i < 1000; ++i)
+        pool.allocate(64);
+    glslang::TMemoryStats second;
+    pool.getStats(second);
+    pool.pop();
+
+    EXPECT_EQ(first.pagesAllocated, second.pagesAllocated);
+    EXPECT_EQ(first.pagesAllocated, second.pagesReused);
+    EXPECT_EQ(first.highWaterMark, second.highWaterMark);
+    EXPECT_EQ(64000u, second.scopeBytesRequested);
+}
+
+TEST(CompileArena, LargeAllocationsGetTheirOwnBlock)
+{
+    glslang::TPoolAllocator pool;
+    pool.allocate(16);
+    glslang::TMemoryStats before;
+    pool.getStats(before);
+
+    pool.push();
+    pool.allocate(16);
+    pool.allocate(1 << 20);
+    pool.allocate(16);
+    glslang::TMemoryStats stats;
+    pool.getStats(stats);
+    EXPECT_EQ(1u, stats.largeAllocations);
+    EXPECT_GE(stats.bytesReserved, before.bytesReserved + (1 << 20));
+    // The small allocation after the large one still comes from the scope's page.
+    EXPECT_EQ(before.pagesAllocated + 1, stats.pagesAllocated);
+
+    // Large blocks go back to the OS when popped.
+    pool.pop();
+    pool.getStats(stats);
+    EXPECT_LT(stats.bytesReserved, size_t(1 << 20));
+    EXPECT_GE(stats.highWaterMark, size_t(1 << 20));
+}
+
+TEST(CompileArena, ShaderReportsItsParse)
+{
+    glslang::TShader shader(EShLangCompute);
+    ASSERT_TRUE(parse(shader)) << shader.getInfoLog();
+
+    const glslang::TMemoryStats stats = shader.getMemoryStats();
+    EXPECT_GT(stats.allocations, 0u);
+    EXPECT_GT(stats.scopeBytesRequested, 0u);
+    EXPECT_LE(stats.scopeBytesRequested, stats.bytesRequested);
+    EXPECT_GE(stats.scopeDepth, 1u);
+    EXPECT_GT(stats.pagesAllocated, 0u);
+    EXPECT_GE(stats.highWaterMark, stats.bytesReserved);
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
@@ -0,0 +1,172 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/CompileCache.h"
+#include "glslang/Public/ResourceLimits.h"
+
+namespace glslangtest {
+namespace {
+
+const char* const VertexShader =
+    "layout(location = 0) in vec4 position;\n"
+    "void main() { gl_Position = SCALE * position; }\n";
+
+glslang::TCompileCacheInput MakeInput(const char* code)
+{
+    glslang::TCompileCacheInput input;
+    input.code = code;
+    input.environment.input = { glslang::EShSourceGlsl, EShLangVertex, glslang::EShClientVulkan, 100, false };
+    input.environment.client = { glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0 };
+    input.environment.target = { glslang::EShTargetSpv, glslang::EShTargetSpv_1_0, false };
+    input.resources = GetDefaultResources();
+    input.messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    return input;
+}
+
+std::string WithScale(const char* scale)
+{
+    return std::string("#version 450\n#define SCALE ") + scale + "\n" + VertexShader;
+}
+
+TEST(CompileCache, HitReturnsSameSpirv)
+{
+    glslang::TMemoryCompileCacheStore store(1 << 20);
+    glslang::TCompileCache cache(store);
+    const std::string code = WithScale("2.0");
+    const glslang::TCompileCacheInput input = MakeInput(code.c_str());
+    const glslang::SpvOptions options;
+
+    std::vector<unsigned int> first, second;
+    std::string log;
+    ASSERT_TRUE(cache.compile(input, options, first, log)) << log;
+    ASSERT_TRUE(cache.compile(input, options, second, log)) << log;
+
+    EXPECT_FALSE(first.empty());
+    EXPECT_EQ(first, second);
+    const glslang::TCompileCacheStats stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.stores);
+}
+
+TEST(CompileCache, KeyCoversPreprocessedSourceAndOptions)
+{
+    glslang::TMemoryCompileCacheStore store(1 << 20);
+    glslang::TCompileCache cache(store);
+    const std::string two = WithScale("2.0");
+    const std::string three = WithScale("3.0");
+    // Differs only in a comment, which preprocessing removes.
+    const std::string commented = two + "// scaled by two\n";
+    glslang::SpvOptions options;
+
+    std::vector<unsigned int> spirv;
+    std::string log;
+    ASSERT_TRUE(cache.compile(MakeInput(two.c_str()), options, spirv, log)) << log;
+    ASSERT_TRUE(cache.compile(MakeInput(three.c_str()), options, spirv, log)) << log;
+    ASSERT_TRUE(cache.compile(MakeInput(commented.c_str()), options, spirv, log)) << log;
+    options.generateDebugInfo = true;
+    ASSERT_TRUE(cache.compile(MakeInput(two.c_str()), options, spirv, log)) << log;
+
+    const glslang::TCompileCacheStats stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+}
+
+TEST(CompileCache, FailuresAreNotStored)
+{
+    glslang::TMemoryCompileCacheStore store(1 << 20);
+    glslang::TCompileCache cache(store);
+    const std::string code = std::string("#version 450\n") + VertexShader; // SCALE is undefined
+    const glslang::TCompileCacheInput input = MakeInput(code.c_str());
+
+    std::vector<unsigned int> spirv;
+    std::string log;
+    EXPECT_FALSE(cache.compile(input, glslang::SpvOptions(), spirv, log));
+    EXPECT_FALSE(log.empty());
+    EXPECT_FALSE(cache.compile(input, glslang::SpvOptions(), spirv, log));
+    EXPECT_EQ(0u, cache.getStats().hits);
+    EXPECT_EQ(0u, cache.getStats().stores);
+}
+
+TEST(CompileCache, MemoryStoreEvictsLeastRecentlyUsed)
+{
+    glslang::TMemoryCompileCacheStore store(3 * sizeof(unsigned int));
+    const std::vector<unsigned int> a(1, 1), b(1, 2), c(2, 3);
+    std::vector<unsigned int> found;
+
+    store.store("a", a);
+    store.store("b", b);
+    ASSERT_TRUE(store.load("a", found)); // "b" becomes the least recently used
+    store.store("c", c);
+
+    EXPECT_TRUE(store.load("a", found));
+    EXPECT_EQ(a, found);
+    EXPECT_FALSE(store.load("b", found));
+    EXPECT_TRUE(store.load("c", found));
+    EXPECT_EQ(1u, store.getEvictionCount());
+
+    store.store("too big", std::vector<unsigned int>(4, 0));
+    EXPECT_FALSE(store.load("too big", found));
+}
+
+TEST(CompileCache, DirectoryStoreIsSharedAcrossCaches)
+{
+    const std::string directory = ::testing::TempDir();
+    const std::string code = WithScale("4.0");
+    const glslang::TCompileCacheInput input = MakeInput(code.c_str());
+
+    std::vector<unsigned int> first, second;
+    std::string log;
+    {
+        glslang::TDirectoryCompileCacheStore store(directory);
+        glslang::TCompileCache cache(store);
+        ASSERT_TRUE(cache.compile(input, glslang::SpvOptions(), first, log)) << log;
+    }
+    glslang::TDirectoryCompileCacheStore store(directory);
+    glslang::TCompileCache cache(store);
+    ASSERT_TRUE(cache.compile(input, glslang::SpvOptions(), second, log)) << log;
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1u, cache.getStats().hits);
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
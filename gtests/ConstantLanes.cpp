@@ -0,0 +1,343 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <climits>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "glslang/MachineIndependent/ConstantLanes.h"
+
+namespace glslangtest {
+namespace {
+
+using glslang::TConstUnion;
+using glslang::TConstUnionArray;
+
+// Constant arrays come from the thread's pool; give each test a fresh one.
+class ConstantLanes : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        previous = &glslang::GetThreadPoolAllocator();
+        glslang::SetThreadPoolAllocator(&pool);
+    }
+    void TearDown() override { glslang::SetThreadPoolAllocator(previous); }
+
+    glslang::TPoolAllocator pool;
+    glslang::TPoolAllocator* previous = nullptr;
+};
+
+// Sizes covering a scalar, vectors, matrices, and several partial lane blocks.
+const int Sizes[] = { 1, 3, 4, 16, 63, 64, 65, 200 };
+
+TConstUnion MakeDouble(int i)
+{
+    TConstUnion c;
+    // A spread of negative and positive values, zeros, and exact halves.
+    c.setDConst(i % 7 == 0 ? 0.0 : (i % 2 ? -1.0 : 1.0) * (i * 0.5 - 3.25));
+    return c;
+}
+
+TConstUnion MakeInt(int i)
+{
+    TConstUnion c;
+    c.setIConst(i % 5 == 0 ? 0 : i % 11 == 1 ? INT_MIN : i % 3 == 0 ? -1 : (i % 2 ? -i : i) * 77777);
+    return c;
+}
+
+TConstUnion MakeUint(int i)
+{
+    TConstUnion c;
+    c.setUConst(i % 5 == 0 ? 0u : 0x9E3779B9u * static_cast<unsigned int>(i));
+    return c;
+}
+
+TConstUnion MakeInt64(int i)
+{
+    TConstUnion c;
+    c.setI64Const(i % 5 == 0 ? 0ll : i % 11 == 1 ? LLONG_MIN : i % 3 == 0 ? -1ll : (i % 2 ? -i : i) * 0x123456789ll);
+    return c;
+}
+
+TConstUnion MakeUint64(int i)
+{
+    TConstUnion c;
+    c.setU64Const(i % 5 == 0 ? 0ull : 0x9E3779B97F4A7C15ull * static_cast<unsigned long long>(i));
+    return c;
+}
+
+TConstUnionArray MakeArray(TConstUnion (*make)(int), int size, int seed)
+{
+    TConstUnionArray array(size);
+    for (int i = 0; i < size; ++i)
+        array[i] = make(i * 3 + seed);
+    return array;
+}
+
+// Component equality that treats NaNs as equal to each other.
+void ExpectSameComponents(const TConstUnionArray& expected, const TConstUnionArray& actual, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        ASSERT_EQ(expected[i].getType(), actual[i].getType()) << "component " << i;
+        if (expected[i].getType() == glslang::EbtDouble && std::isnan(expected[i].getDConst()))
+            EXPECT_TRUE(std::isnan(actual[i].getDConst())) << "component " << i;
+        else
+            EXPECT_TRUE(expected[i] == actual[i]) << "component " << i;
+    }
+}
+
+// What the scalar fold computes for a division, one component at a time.
+TConstUnion ScalarDivide(const TConstUnion& l, const TConstUnion& r)
+{
+    TConstUnion c;
+    switch (l.getType()) {
+    case glslang::EbtDouble:
+        if (r.getDConst() != 0.0)
+            c.setDConst(l.getDConst() / r.getDConst());
+        else if (l.getDConst() > 0.0)
+            c.setDConst((double)INFINITY);
+        else if (l.getDConst() < 0.0)
+            c.setDConst(-(double)INFINITY);
+        else
+            c.setDConst((double)NAN);
+        break;
+    case glslang::EbtInt:
+        if (r.getIConst() == 0)
+            c.setIConst(0x7FFFFFFF);
+        else if (r.getIConst() == -1 && l.getIConst() == INT_MIN)
+            c.setIConst(INT_MIN);
+        else
+            c.setIConst(l.getIConst() / r.getIConst());
+        break;
+    case glslang::EbtUint:
+        c.setUConst(r.getUConst() == 0u ? 0xFFFFFFFFu : l.getUConst() / r.getUConst());
+        break;
+    case glslang::EbtInt64:
+        if (r.getI64Const() == 0)
+            c.setI64Const(LLONG_MAX);
+        else if (r.getI64Const() == -1 && l.getI64Const() == LLONG_MIN)
+            c.setI64Const(LLONG_MIN);
+        else
+            c.setI64Const(l.getI64Const() / r.getI64Const());
+        break;
+    case glslang::EbtUint64:
+        c.setU64Const(r.getU64Const() == 0ull ? 0xFFFFFFFFFFFFFFFFull : l.getU64Const() / r.getU64Const());
+        break;
+    default:
+        break;
+    }
+    return c;
+}
+
+TConstUnion ScalarBinary(glslang::TOperator op, const TConstUnion& l, const TConstUnion& r)
+{
+    switch (op) {
+    case glslang::EOpAdd:             return l + r;
+    case glslang::EOpSub:             return l - r;
+    case glslang::EOpMul:             return l * r;
+    case glslang::EOpDiv:             return ScalarDivide(l, r);
+    case glslang::EOpAnd:             return l & r;
+    case glslang::EOpInclusiveOr:     return l | r;
+    case glslang::EOpExclusiveOr:     return l ^ r;
+    default:                          return TConstUnion();
+    }
+}
+
+void CheckBinary(TConstUnion (*make)(int), bool integer)
+{
+    std::vector<glslang::TOperator> ops = { glslang::EOpAdd, glslang::EOpSub, glslang::EOpMul, glslang::EOpDiv };
+    if (integer)
+        ops.insert(ops.end(), { glslang::EOpAnd, glslang::EOpInclusiveOr, glslang::EOpExclusiveOr });
+
+    for (int size : Sizes) {
+        const TConstUnionArray left = MakeArray(make, size, 1);
+        const TConstUnionArray right = MakeArray(make, size, 2);
+        for (glslang::TOperator op : ops) {
+            TConstUnionArray expected(size);
+            for (int i = 0; i < size; ++i)
+                expected[i] = ScalarBinary(op, left[i], right[i]);
+
+            TConstUnionArray actual(size);
+            ASSERT_TRUE(glslang::FoldConstantLanes(op, left, right, size, actual)) << "op " << op << " size " << size;
+            ExpectSameComponents(expected, actual, size);
+        }
+    }
+}
+
+TEST_F(ConstantLanes, BinaryDouble) { CheckBinary(MakeDouble, false); }
+TEST_F(ConstantLanes, BinaryInt) { CheckBinary(MakeInt, true); }
+TEST_F(ConstantLanes, BinaryUint) { CheckBinary(MakeUint, true); }
+TEST_F(ConstantLanes, BinaryInt64) { CheckBinary(MakeInt64, true); }
+TEST_F(ConstantLanes, BinaryUint64) { CheckBinary(MakeUint64, true); }
+
+TEST_F(ConstantLanes, BitwiseOnDoubleIsNotFolded)
+{
+    const TConstUnionArray left = MakeArray(MakeDouble, 4, 1);
+    const TConstUnionArray right = MakeArray(MakeDouble, 4, 2);
+    TConstUnionArray result(4);
+    EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpAnd, left, right, 4, result));
+}
+
+TEST_F(ConstantLanes, MixedTypesAreNotFolded)
+{
+    for (int size : Sizes) {
+        TConstUnionArray left = MakeArray(MakeInt, size, 1);
+        const TConstUnionArray right = MakeArray(MakeInt, size, 2);
+        // One odd component, in the last lane block.
+        left[size - 1] = MakeUint(size);
+        TConstUnionArray result(size);
+        EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpAdd, left, right, size, result)) << "size " << size;
+        EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpAdd, right, left, size, result)) << "size " << size;
+        if (size > 1) {
+            EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpNegative, left, size, result)) << "size " << size;
+        }
+    }
+}
+
+TEST_F(ConstantLanes, UnsupportedOperationsAreNotFolded)
+{
+    const TConstUnionArray left = MakeArray(MakeDouble, 4, 1);
+    const TConstUnionArray right = MakeArray(MakeDouble, 4, 2);
+    TConstUnionArray result(4);
+    EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpLessThan, left, right, 4, result));
+    EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpMod, left, right, 4, result));
+    EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpSign, left, 4, result));
+    EXPECT_FALSE(glslang::FoldConstantLanes(glslang::EOpAdd, left, right, 0, result));
+}
+
+// What the scalar unary fold computes for a double component.
+double ScalarUnary(glslang::TOperator op, double x)
+{
+    const double pi = 3.1415926535897932384626433832795;
+    switch (op) {
+    case glslang::EOpNegative:    return -x;
+    case glslang::EOpAbs:         return fabs(x);
+    case glslang::EOpRadians:     return x * pi / 180.0;
+    case glslang::EOpDegrees:     return x * 180.0 / pi;
+    case glslang::EOpSin:         return sin(x);
+    case glslang::EOpCos:         return cos(x);
+    case glslang::EOpTan:         return tan(x);
+    case glslang::EOpAsin:        return asin(x);
+    case glslang::EOpAcos:        return acos(x);
+    case glslang::EOpAtan:        return atan(x);
+    case glslang::EOpExp:         return exp(x);
+    case glslang::EOpLog:         return log(x);
+    case glslang::EOpExp2:        return exp2(x);
+    case glslang::EOpLog2:        return log2(x);
+    case glslang::EOpSqrt:        return sqrt(x);
+    case glslang::EOpInverseSqrt: return 1.0 / sqrt(x);
+    case glslang::EOpFloor:       return floor(x);
+    case glslang::EOpTrunc:       return x > 0 ? floor(x) : ceil(x);
+    case glslang::EOpRound:       return floor(0.5 + x);
+    case glslang::EOpRoundEven: {
+        double flr = floor(x);
+        bool even = flr / 2.0 == floor(flr / 2.0);
+        return even ? ceil(x - 0.5) : floor(x + 0.5);
+    }
+    case glslang::EOpCeil:        return ceil(x);
+    case glslang::EOpFract:       return x - floor(x);
+    default:                      return 0.0;
+    }
+}
+
+TEST_F(ConstantLanes, UnaryDouble)
+{
+    const glslang::TOperator ops[] = {
+        glslang::EOpNegative, glslang::EOpAbs, glslang::EOpRadians, glslang::EOpDegrees,
+        glslang::EOpSin, glslang::EOpCos, glslang::EOpTan, glslang::EOpAsin, glslang::EOpAcos, glslang::EOpAtan,
+        glslang::EOpExp, glslang::EOpLog, glslang::EOpExp2, glslang::EOpLog2, glslang::EOpSqrt,
+        glslang::EOpInverseSqrt, glslang::EOpFloor, glslang::EOpTrunc, glslang::EOpRound, glslang::EOpRoundEven,
+        glslang::EOpCeil, glslang::EOpFract,
+    };
+    for (int size : Sizes) {
+        const TConstUnionArray operand = MakeArray(MakeDouble, size, 1);
+        for (glslang::TOperator op : ops) {
+            TConstUnionArray expected(size);
+            for (int i = 0; i < size; ++i)
+                expected[i].setDConst(ScalarUnary(op, operand[i].getDConst()));
+
+            TConstUnionArray actual(size);
+            ASSERT_TRUE(glslang::FoldConstantLanes(op, operand, size, actual)) << "op " << op << " size " << size;
+            ExpectSameComponents(expected, actual, size);
+        }
+    }
+}
+
+TEST_F(ConstantLanes, UnaryIntegers)
+{
+    TConstUnion (*const makers[])(int) = { MakeInt, MakeUint, MakeInt64, MakeUint64 };
+    for (auto make : makers) {
+        for (int size : Sizes) {
+            const TConstUnionArray operand = MakeArray(make, size, 1);
+
+            TConstUnionArray negated(size), absolute(size), inverted(size);
+            for (int i = 0; i < size; ++i) {
+                const TConstUnion& c = operand[i];
+                switch (c.getType()) {
+                case glslang::EbtInt:
+                    negated[i].setIConst(c.getIConst() == INT_MIN ? INT_MIN : -c.getIConst());
+                    absolute[i].setIConst(abs(c.getIConst()));
+                    break;
+                case glslang::EbtUint:
+                    negated[i].setUConst(static_cast<unsigned int>(-static_cast<int>(c.getUConst())));
+                    absolute[i] = c;
+                    break;
+                case glslang::EbtInt64:
+                    negated[i].setI64Const(c.getI64Const() == LLONG_MIN ? LLONG_MIN : -c.getI64Const());
+                    absolute[i] = c;
+                    break;
+                default:
+                    negated[i].setU64Const(static_cast<unsigned long long>(-static_cast<long long>(c.getU64Const())));
+                    absolute[i] = c;
+                    break;
+                }
+                inverted[i] = ~c;
+            }
+
+            TConstUnionArray actual(size);
+            ASSERT_TRUE(glslang::FoldConstantLanes(glslang::EOpNegative, operand, size, actual));
+            ExpectSameComponents(negated, actual, size);
+            ASSERT_TRUE(glslang::FoldConstantLanes(glslang::EOpAbs, operand, size, actual));
+            ExpectSameComponents(absolute, actual, size);
+            ASSERT_TRUE(glslang::FoldConstantLanes(glslang::EOpBitwiseNot, operand, size, actual));
+            ExpectSameComponents(inverted, actual, size);
+        }
+    }
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
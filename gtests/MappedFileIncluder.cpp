@@ -0,0 +1,180 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "StandAlone/DirStackFileIncluder.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+using IncludeResult = glslang::TShader::Includer::IncludeResult;
+
+void WriteFile(const std::string& path, const std::string& contents)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr) << path;
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+}
+
+std::string Contents(const IncludeResult* result)
+{
+    return std::string(result->headerData, result->headerLength);
+}
+
+TEST(MappedFileIncluder, ReadsFile)
+{
+    const std::string path = testing::TempDir() + "mapped_reads.h";
+    WriteFile(path, "#define A 1\n");
+
+    glslang::TShader::MappedFileIncluder includer;
+    IncludeResult* result = includer.readFile(path);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->headerName, path);
+    EXPECT_EQ(Contents(result), "#define A 1\n");
+    includer.releaseInclude(result);
+
+    EXPECT_EQ(includer.readFile(testing::TempDir() + "mapped_missing.h"), nullptr);
+    EXPECT_EQ(includer.readFile(testing::TempDir()), nullptr);
+    remove(path.c_str());
+}
+
+TEST(MappedFileIncluder, ReadsEmptyFile)
+{
+    const std::string path = testing::TempDir() + "mapped_empty.h";
+    WriteFile(path, "");
+
+    glslang::TShader::MappedFileIncluder includer;
+    IncludeResult* result = includer.readFile(path);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->headerLength, 0u);
+    ASSERT_NE(result->headerData, nullptr);
+    includer.releaseInclude(result);
+    remove(path.c_str());
+}
+
+TEST(MappedFileIncluder, SharesMappingAcrossIncluders)
+{
+    const std::string path = testing::TempDir() + "mapped_shared.h";
+    WriteFile(path, "const int shared = 1;\n");
+
+    glslang::TShader::MappedFileIncluder first, second;
+    IncludeResult* a = first.readFile(path);
+    IncludeResult* b = second.readFile(path);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a->headerData, b->headerData);
+    first.releaseInclude(a);
+    second.releaseInclude(b);
+    remove(path.c_str());
+}
+
+TEST(MappedFileIncluder, RereadsChangedFile)
+{
+    const std::string path = testing::TempDir() + "mapped_changed.h";
+    WriteFile(path, "old\n");
+
+    glslang::TShader::MappedFileIncluder includer;
+    IncludeResult* before = includer.readFile(path);
+    ASSERT_NE(before, nullptr);
+
+    // Replace, rather than rewrite, the file, as editors and build tools do;
+    // the new size alone invalidates the cached mapping.
+    const std::string replacement = path + ".new";
+    WriteFile(replacement, "new contents\n");
+    ASSERT_EQ(rename(replacement.c_str(), path.c_str()), 0);
+
+    IncludeResult* after = includer.readFile(path);
+    ASSERT_NE(after, nullptr);
+    EXPECT_EQ(Contents(after), "new contents\n");
+    // The earlier result still sees what it read.
+    EXPECT_EQ(Contents(before), "old\n");
+
+    includer.releaseInclude(before);
+    includer.releaseInclude(after);
+    glslang::TShader::MappedFileIncluder::purgeCache();
+    remove(path.c_str());
+}
+
+TEST(MappedFileIncluder, ConcurrentReads)
+{
+    const std::string path = testing::TempDir() + "mapped_concurrent.h";
+    WriteFile(path, "vec4 f() { return vec4(1.0); }\n");
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&path, &failures, t]() {
+            glslang::TShader::MappedFileIncluder includer;
+            for (int i = 0; i < 1000; ++i) {
+                IncludeResult* result = includer.readFile(path);
+                if (result == nullptr || Contents(result) != "vec4 f() { return vec4(1.0); }\n")
+                    ++failures[t];
+                includer.releaseInclude(result);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (int t = 0; t < 4; ++t)
+        EXPECT_EQ(failures[t], 0) << "thread " << t;
+    remove(path.c_str());
+}
+
+TEST(MappedFileIncluder, DirStackFileIncluderSearchesThroughCache)
+{
+    const std::string path = testing::TempDir() + "mapped_local.h";
+    WriteFile(path, "#define LOCAL 1\n");
+
+    DirStackFileIncluder includer;
+    includer.pushExternalLocalDirectory(testing::TempDir());
+    IncludeResult* result = includer.includeLocal("mapped_local.h", "main.vert", 1);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(Contents(result), "#define LOCAL 1\n");
+    EXPECT_EQ(includer.getIncludedFiles().size(), 1u);
+    includer.releaseInclude(result);
+    EXPECT_EQ(includer.includeLocal("mapped_missing.h", "main.vert", 1), nullptr);
+    remove(path.c_str());
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
@@ -102,6 +102,7 @@ INSTANTIATE_TEST_SUITE_P(
             { "remap.similar_1b.everything.frag",         "main", Source::GLSL, spv::spirvbin_t::DO_EVERYTHING },
             { "remap.uniformarray.none.frag",             "main", Source::GLSL, spv::spirvbin_t::NONE },
             { "remap.uniformarray.everything.frag",       "main", Source::GLSL, spv::spirvbin_t::DO_EVERYTHING },
+            { "remap.deeptypes.everything.frag",          "main", Source::GLSL, spv::spirvbin_t::DO_EVERYTHING },
 
             // HLSL remapper tests
             { "remap.hlsl.sample.basic.strip.frag",       "main", Source::HLSL, spv::spirvbin_t::STRIP },
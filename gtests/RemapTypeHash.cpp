@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "SPIRV/SPVRemapper.h"
+#include "SPIRV/spirv.hpp11"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+void addInst(std::vector<std::uint32_t>& spirv, spv::Op op, std::initializer_list<std::uint32_t> operands)
+{
+    spirv.push_back(std::uint32_t(operands.size() + 1) << spv::WordCountShift | std::uint32_t(op));
+    spirv.insert(spirv.end(), operands);
+}
+
+// A module of just types: a vec4, then 'depth' structs that each hold two of
+// the one before.  Every struct is reachable from the last 2^depth ways.
+std::vector<std::uint32_t> makeTypeDag(std::uint32_t depth)
+{
+    std::vector<std::uint32_t> spirv = { spv::MagicNumber, 0x00010000, 0, depth + 3, 0 };
+    addInst(spirv, spv::Op::OpCapability, { std::uint32_t(spv::Capability::Shader) });
+    addInst(spirv, spv::Op::OpMemoryModel,
+            { std::uint32_t(spv::AddressingModel::Logical), std::uint32_t(spv::MemoryModel::GLSL450) });
+    addInst(spirv, spv::Op::OpTypeFloat, { 1, 32 });
+    addInst(spirv, spv::Op::OpTypeVector, { 2, 1, 4 });
+    for (std::uint32_t level = 0; level < depth; ++level)
+        addInst(spirv, spv::Op::OpTypeStruct, { 3 + level, 2 + level, 2 + level });
+    return spirv;
+}
+
+// The members of each OpTypeStruct, in order.
+std::vector<std::vector<std::uint32_t>> structs(const std::vector<std::uint32_t>& spirv)
+{
+    std::vector<std::vector<std::uint32_t>> found;
+    for (size_t word = 5; word < spirv.size(); word += spirv[word] >> spv::WordCountShift) {
+        if (spv::Op(spirv[word] & spv::OpCodeMask) == spv::Op::OpTypeStruct)
+            found.emplace_back(spirv.begin() + word + 1, spirv.begin() + word + (spirv[word] >> spv::WordCountShift));
+    }
+    return found;
+}
+
+TEST(RemapTypeHash, DeepTypeDagIsHashedOncePerType)
+{
+    // Rehashing every member at every use would take 2^64 steps here.
+    std::vector<std::uint32_t> spirv = makeTypeDag(64);
+    spv::spirvbin_t(0).remap(spirv, spv::spirvbin_t::MAP_ALL);
+
+    const auto remapped = structs(spirv);
+    ASSERT_EQ(64u, remapped.size());
+    std::set<std::uint32_t> ids;
+    for (size_t s = 0; s < remapped.size(); ++s) {
+        const std::vector<std::uint32_t>& inst = remapped[s];
+        ASSERT_EQ(3u, inst.size());
+        EXPECT_TRUE(ids.insert(inst[0]).second) << "struct " << s << " shares an id";
+        EXPECT_EQ(inst[1], inst[2]);
+        if (s > 0)
+            EXPECT_EQ(remapped[s - 1][0], inst[1]);
+    }
+}
+
+TEST(RemapTypeHash, TimeGrowsLinearlyWithDepth)
+{
+    const auto remapTime = [](std::uint32_t depth) {
+        std::vector<std::uint32_t> spirv = makeTypeDag(depth);
+        const auto start = std::chrono::steady_clock::now();
+        spv::spirvbin_t(0).remap(spirv, spv::spirvbin_t::MAP_ALL);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    // Generous bounds: doubling the depth would square the time were it exponential.
+    remapTime(256);
+    const double shallow = remapTime(1000);
+    const double deep = remapTime(4000);
+    EXPECT_LT(deep, shallow * 4 * 4 + 0.1);
+}
+
+TEST(RemapTypeHash, ForwardPointerCycle)
+{
+    const char* source =
+        "#version 450\n"
+        "#extension GL_EXT_buffer_reference : enable\n"
+        "layout(buffer_reference) buffer Node;\n"
+        "layout(buffer_reference, std430) buffer Node { Node next; vec4 value; };\n"
+        "layout(push_constant) uniform Root { Node head; } root;\n"
+        "layout(location = 0) out vec4 color;\n"
+        "void main() { color = root.head.next.next.value; }\n";
+
+    glslang::TShader shader(EShLangFragment);
+    shader.setStrings(&source, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangFragment, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, messages)) << shader.getInfoLog();
+    glslang::TProgram program;
+    program.addShader(&shader);
+    ASSERT_TRUE(program.link(messages)) << program.getInfoLog();
+
+    std::vector<std::uint32_t> spirv;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangFragment), spirv);
+    ASSERT_FALSE(spirv.empty());
+
+    // The struct refers to a pointer to itself, which used to recurse without end.
+    std::vector<std::uint32_t> first = spirv;
+    spv::spirvbin_t(0).remap(first, spv::spirvbin_t::DO_EVERYTHING);
+    std::vector<std::uint32_t> second = spirv;
+    spv::spirvbin_t(0).remap(second, spv::spirvbin_t::DO_EVERYTHING);
+    EXPECT_FALSE(first.empty());
+    EXPECT_EQ(first, second);
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
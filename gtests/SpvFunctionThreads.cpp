@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+// Builds a compute shader with enough functions to be split across several
+// shares, each with its own struct, constants and control flow.
+std::string makeManyFunctionShader(int functions)
+{
+    std::string source =
+        "#version 450\n"
+        "layout(local_size_x = 64) in;\n"
+        "layout(std430, binding = 0) buffer Data { vec4 values[]; } data;\n"
+        "shared vec4 scratch[64];\n";
+    for (int f = 0; f < functions; ++f) {
+        const std::string n = std::to_string(f);
+        source += "struct S" + n + " { vec4 a; float b[" + std::to_string(f % 3 + 1) + "]; };\n"
+                  "vec4 f" + n + "(vec4 v, uint i)\n"
+                  "{\n"
+                  "    S" + n + " s;\n"
+                  "    s.a = v * " + n + ".5;\n"
+                  "    s.b[0] = float(i + " + n + "u);\n"
+                  "    for (int k = 0; k < " + std::to_string(f % 4 + 1) + "; ++k)\n"
+                  "        s.a += scratch[(i + uint(k)) % 64u];\n"
+                  "    if (s.b[0] > " + n + ".0)\n"
+                  "        return s.a;\n"
+                  "    return s.a.wzyx;\n"
+                  "}\n";
+    }
+    source += "void main()\n"
+              "{\n"
+              "    uint i = gl_LocalInvocationID.x;\n"
+              "    scratch[i] = data.values[i];\n"
+              "    barrier();\n"
+              "    vec4 v = scratch[i];\n";
+    for (int f = 0; f < functions; ++f)
+        source += "    v = f" + std::to_string(f) + "(v, i);\n";
+    source += "    data.values[i] = v;\n"
+              "}\n";
+    return source;
+}
+
+std::vector<unsigned int> compile(const std::string& source, int functionThreads)
+{
+    const char* text = source.c_str();
+    glslang::TShader shader(EShLangCompute);
+    shader.setStrings(&text, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangCompute, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    EXPECT_TRUE(shader.parse(GetDefaultResources(), 100, false, messages)) << shader.getInfoLog();
+    glslang::TProgram program;
+    program.addShader(&shader);
+    EXPECT_TRUE(program.link(messages)) << program.getInfoLog();
+
+    std::vector<unsigned int> spirv;
+    spv::SpvBuildLogger logger;
+    glslang::SpvOptions options;
+    options.functionThreads = functionThreads;
+    glslang::GlslangToSpv(*program.getIntermediate(EShLangCompute), spirv, &logger, &options);
+    return spirv;
+}
+
+TEST(SpvFunctionThreads, ParallelModuleMatchesSerial)
+{
+    const std::string source = makeManyFunctionShader(24);
+    const std::vector<unsigned int> serial = compile(source, 0);
+    ASSERT_FALSE(serial.empty());
+
+    for (int threads : { 2, 3, 8, 64 })
+        EXPECT_EQ(serial, compile(source, threads)) << threads << " threads";
+}
+
+TEST(SpvFunctionThreads, SingleFunctionStaysSerial)
+{
+    const std::string source = makeManyFunctionShader(0);
+    EXPECT_EQ(compile(source, 0), compile(source, 4));
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest
@@ -0,0 +1,121 @@
+//
+// Copyright (C) 2026 The Khronos Group Inc.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//    Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+//    Redistributions in binary form must reproduce the above
+//    copyright notice, this list of conditions and the following
+//    disclaimer in the documentation and/or other materials provided
+//    with the distribution.
+//
+//    Neither the name of The Khronos Group Inc. nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "SPIRV/GlslangToSpv.h"
+#include "SPIRV/SpvSink.h"
+#include "glslang/Public/ResourceLimits.h"
+#include "glslang/Public/ShaderLang.h"
+
+namespace glslangtest {
+namespace {
+
+const char* const FragmentShader =
+    "#version 450\n"
+    "layout(location = 0) in vec4 color;\n"
+    "layout(location = 0) out vec4 result;\n"
+    "layout(binding = 0) uniform sampler2D tex;\n"
+    "void main() { result = color * texture(tex, color.xy); }\n";
+
+TEST(SpvSink, StreamedModuleMatchesVector)
+{
+    glslang::TShader shader(EShLangFragment);
+    shader.setStrings(&FragmentShader, 1);
+    shader.setEnvInput(glslang::EShSourceGlsl, EShLangFragment, glslang::EShClientVulkan, 100);
+    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_0);
+    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    const EShMessages messages = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+    ASSERT_TRUE(shader.parse(GetDefaultResources(), 100, false, messages)) << shader.getInfoLog();
+    glslang::TProgram program;
+    program.addShader(&shader);
+    ASSERT_TRUE(program.link(messages)) << program.getInfoLog();
+    const glslang::TIntermediate& intermediate = *program.getIntermediate(EShLangFragment);
+
+    std::vector<unsigned int> expected;
+    glslang::GlslangToSpv(intermediate, expected);
+    ASSERT_FALSE(expected.empty());
+
+    std::ostringstream stream;
+    {
+        spv::SpvBuildLogger logger;
+        spv::SpvStreamSink sink(stream);
+        glslang::GlslangToSpv(intermediate, sink, &logger);
+    }
+    const std::string bytes = stream.str();
+    ASSERT_EQ(expected.size() * sizeof(unsigned int), bytes.size());
+    EXPECT_EQ(0, memcmp(expected.data(), bytes.data(), bytes.size()));
+
+    // Tiny chunks exercise the buffering on every instruction boundary.
+    std::vector<unsigned int> chunked;
+    {
+        spv::SpvBuildLogger logger;
+        spv::SpvCallbackSink sink([&chunked](const unsigned int* words, size_t count) {
+            chunked.insert(chunked.end(), words, words + count);
+        }, 3);
+        glslang::GlslangToSpv(intermediate, sink, &logger);
+    }
+    EXPECT_EQ(expected, chunked);
+}
+
+TEST(SpvSink, CallbackSinkBatchesSmallWrites)
+{
+    std::vector<size_t> chunks;
+    std::vector<unsigned int> words;
+    {
+        spv::SpvCallbackSink sink([&](const unsigned int* w, size_t count) {
+            chunks.push_back(count);
+            words.insert(words.end(), w, w + count);
+        }, 4);
+        const unsigned int small[] = { 1, 2, 3 };
+        const unsigned int large[] = { 4, 5, 6, 7, 8, 9 };
+        sink.write(small, 3);
+        sink.write(10);
+        EXPECT_TRUE(chunks.empty());
+        sink.write(large, 6);
+        sink.write(small, 2);
+    }
+
+    EXPECT_EQ((std::vector<size_t>{ 4, 6, 2 }), chunks);
+    EXPECT_EQ((std::vector<unsigned int>{ 1, 2, 3, 10, 4, 5, 6, 7, 8, 9, 1, 2 }), words);
+}
+
+}  // anonymous namespace
+}  // namespace glslangtest